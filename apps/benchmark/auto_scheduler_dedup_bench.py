@@ -0,0 +1,89 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark state deduplication in the auto-scheduler.
+Compare the printed loop structure (State::ToStr) with the fingerprint of transform steps
+(State::Fingerprint) as the deduplication key on a sampled population.
+"""
+import argparse
+import time
+
+import tvm
+from tvm import te, auto_scheduler
+from tvm.auto_scheduler import _ffi_api
+
+
+@auto_scheduler.register_workload
+def matmul_add(N, L, M, dtype):
+    A = te.placeholder((N, L), name="A", dtype=dtype)
+    B = te.placeholder((L, M), name="B", dtype=dtype)
+    C = te.placeholder((N, M), name="C", dtype=dtype)
+    k = te.reduce_axis((0, L), name="k")
+    matmul = te.compute((N, M), lambda i, j: te.sum(A[i, k] * B[k, j], axis=k), name="matmul")
+    out = te.compute((N, M), lambda i, j: matmul[i, j] + C[i, j], name="out")
+    return [A, B, C, out]
+
+
+def reload_states(task, states):
+    """Round trip the states through measure records so that no fingerprint is cached."""
+    inputs = [auto_scheduler.MeasureInput(task, s) for s in states]
+    results = [auto_scheduler.MeasureResult([0.1], 0, "", 0.1, 0) for _ in states]
+    tmpdir = tvm.contrib.utils.tempdir()
+    log_file = tmpdir.relpath("states.json")
+    auto_scheduler.save_records(log_file, inputs, results)
+    inputs, _ = auto_scheduler.load_records(log_file)
+    return [inp.state for inp in inputs]
+
+
+def timeit(func, repeat):
+    best = float("inf")
+    for _ in range(repeat):
+        start = time.time()
+        ret = func()
+        best = min(best, time.time() - start)
+    return best, ret
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--population", type=int, default=2048)
+    parser.add_argument("--repeat", type=int, default=5)
+    args = parser.parse_args()
+
+    task = auto_scheduler.SearchTask(
+        func=matmul_add, args=(1024, 1024, 1024, "float32"), target="llvm"
+    )
+    policy = auto_scheduler.SketchPolicy(
+        task, params={"sample_init_min_population": args.population}, verbose=0
+    )
+    states = list(policy.sample_initial_population())[: args.population]
+    print("Population: %d states" % len(states))
+
+    str_time, n_str = timeit(lambda: len({str(s) for s in states}), args.repeat)
+    fp_time, n_fp = timeit(
+        lambda: len({_ffi_api.StateFingerprint(s) for s in states}), args.repeat
+    )
+    cold_states = reload_states(task, states)
+    cold_time, n_cold = timeit(
+        lambda: len({_ffi_api.StateFingerprint(s) for s in cold_states}), 1
+    )
+    print("ToStr                 : %8.2f ms, %d unique" % (str_time * 1e3, n_str))
+    print("Fingerprint (cold)    : %8.2f ms, %d unique" % (cold_time * 1e3, n_cold))
+    print("Fingerprint (cached)  : %8.2f ms, %d unique" % (fp_time * 1e3, n_fp))
+
+
+if __name__ == "__main__":
+    main()
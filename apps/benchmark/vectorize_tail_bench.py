@@ -0,0 +1,83 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark predicated tail vectorization on extents that are not a multiple of the lanes.
+Compare the scalarized guard (default) against predicated loads and stores, with and without
+partitioning the tail out of the loop.
+"""
+import argparse
+
+import numpy as np
+
+import tvm
+from tvm import te
+
+
+def bias_relu(rows, channels, lanes):
+    A = te.placeholder((rows, channels), name="A")
+    bias = te.placeholder((channels,), name="bias")
+    B = te.compute(
+        (rows, channels), lambda i, c: te.max(A[i, c] + bias[c], 0.0), name="B"
+    )
+    s = te.create_schedule(B.op)
+    _, ci = s[B].split(B.op.axis[1], factor=lanes)
+    s[B].vectorize(ci)
+    return s, [A, bias, B]
+
+
+def measure(rows, channels, lanes, target, config, number):
+    s, args = bias_relu(rows, channels, lanes)
+    with tvm.transform.PassContext(config=config):
+        func = tvm.build(s, args, target)
+    dev = tvm.cpu(0)
+    nd_args = [
+        tvm.nd.array(np.random.uniform(size=[int(x) for x in t.shape]).astype(t.dtype), dev)
+        for t in args
+    ]
+    evaluator = func.time_evaluator(func.entry_name, dev, number=number, repeat=3)
+    return min(evaluator(*nd_args).results)
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--target", type=str, default="llvm -mcpu=skylake-avx512")
+    parser.add_argument("--rows", type=int, default=4096)
+    parser.add_argument("--lanes", type=int, default=16)
+    parser.add_argument("--number", type=int, default=20)
+    args = parser.parse_args()
+
+    configs = [
+        ("scalar guard", {}),
+        ("predicated", {"tir.enable_vectorize_predication": True}),
+        (
+            "partition + predicated",
+            {
+                "tir.enable_vectorize_predication": True,
+                "tir.LoopPartition": {"partition_const_loop": True},
+            },
+        ),
+    ]
+    print("%-10s" % "channels" + "".join("%24s" % name for name, _ in configs))
+    for channels in [17, 31, 63, 127, 255, 1001]:
+        costs = [
+            measure(args.rows, channels, args.lanes, args.target, config, args.number)
+            for _, config in configs
+        ]
+        print("%-10d" % channels + "".join("%21.3f us" % (c * 1e6) for c in costs))
+
+
+if __name__ == "__main__":
+    main()
@@ -283,6 +283,23 @@ Array<IterSumExpr> DetectIterMap(const Array<PrimExpr>& indices, const Map<Var,
                                  const PrimExpr& predicate, bool require_bijective,
                                  arith::Analyzer* analyzer);
 
+/*!
+ * \brief Simplify the indices using the iter map detection.
+ *
+ * The indices are rewritten into the canonical form of the detected affine iter map,
+ * e.g. `floordiv(i * 4 + j, 4)` is simplified to `i` given j in [0, 4).
+ * The indices are returned untouched if no affine iter map can be detected.
+ *
+ * \param indices The indices to be simplified.
+ * \param input_iters Map from variable to iterator's range.
+ * \param input_pred The predicate constraints on the input iterators
+ * \param require_bijective A boolean flag that indicates whether the mapping should be bijective.
+ *
+ * \return The simplified indices.
+ */
+Array<PrimExpr> IterMapSimplify(const Array<PrimExpr>& indices, const Map<Var, Range>& input_iters,
+                                const PrimExpr& input_pred, bool require_bijective);
+
 /*!
  * \brief Apply the inverse of the affine transformation to the outputs.
  *
@@ -334,6 +351,13 @@ Array<Array<IterMark>> SubspaceDivide(const Array<PrimExpr>& bindings,
                                       const Array<Var>& sub_iters, const PrimExpr& predicate,
                                       bool require_bijective, arith::Analyzer* analyzer);
 
+/*!
+ * \brief Given an IterMapExpr, transform it to normal PrimExpr.
+ * \param expr The input IterMapExpr.
+ * \return The corresponding normal PrimExpr.
+ */
+PrimExpr NormalizeIterMapToExpr(const IterMapExpr& expr);
+
 }  // namespace arith
 }  // namespace tvm
 #endif  // TVM_ARITH_ITER_AFFINE_MAP_H_
@@ -30,6 +30,7 @@
 #include <tvm/node/node.h>
 #include <tvm/runtime/packed_func.h>
 
+#include <random>
 #include <vector>
 
 namespace tvm {
@@ -118,6 +119,132 @@ class RandomModel : public CostModel {
   using ContainerType = RandomModelNode;
 };
 
+/*!
+ * \brief A gradient boosted decision tree model that is trained and evaluated entirely in C++.
+ * Like the python XGBModel, it predicts the score of a state as the sum of the predictions
+ * of its BufferStore statements and is trained with the same pack-sum square error objective.
+ * Training builds histogram-based regression trees level by level and both training and
+ * prediction are parallelized with support::parallel_for.
+ */
+class GBDTModelNode : public CostModelNode {
+ public:
+  /*! \brief A node of a regression tree. Leaf nodes have feature == -1. */
+  struct TreeNode {
+    /*! \brief The index of the feature this node splits on */
+    int feature;
+    /*! \brief Rows whose feature value is less than the threshold go to the left child */
+    float threshold;
+    /*! \brief The index of the left child */
+    int left;
+    /*! \brief The index of the right child */
+    int right;
+    /*! \brief The output value of a leaf node */
+    float value;
+  };
+
+  /*! \brief The maximum depth of a tree */
+  int max_depth;
+  /*! \brief The learning rate */
+  double eta;
+  /*! \brief The L2 regularization on leaf values */
+  double reg_lambda;
+  /*! \brief The minimum gain required to make a split */
+  double gamma;
+  /*! \brief The minimum sum of hessian required in a child */
+  double min_child_weight;
+  /*! \brief The maximum number of boosting rounds */
+  int num_rounds;
+  /*! \brief Stop training if the training loss does not improve for this many rounds */
+  int early_stopping_rounds;
+  /*! \brief The maximum number of histogram bins per feature, at most 256 */
+  int max_bins;
+  /*! \brief Predict random scores until this many measured samples have been seen */
+  int num_warmup_sample;
+  /*! \brief The maximum number of buffers used in feature extraction */
+  int max_n_bufs;
+  /*! \brief The seed of the random number generator used in warmup */
+  int seed;
+
+  void Update(const Array<MeasureInput>& inputs, const Array<MeasureResult>& results) final;
+
+  void Predict(const SearchTask& task, const Array<State>& states,
+               std::vector<float>* scores) final;
+
+  void PredictStages(const SearchTask& task, const Array<State>& states,
+                     std::vector<float>* state_scores,
+                     std::vector<std::vector<float>>* stage_scores) final;
+
+  static constexpr const char* _type_key = "auto_scheduler.GBDTModel";
+  TVM_DECLARE_FINAL_OBJECT_INFO(GBDTModelNode, CostModelNode);
+
+ private:
+  /*!
+   * \brief Train all trees from scratch.
+   * \param values The row major feature matrix with one row per BufferStore
+   * \param row_to_sample The index of the sample each row belongs to
+   * \param labels The normalized throughputs of all samples
+   */
+  void Train(const std::vector<float>& values, const std::vector<int>& row_to_sample,
+             const std::vector<float>& labels);
+  /*!
+   * \brief Predict the score of every store of one state.
+   * \param feature The per-store features of the state
+   * \param store_scores The predicted scores, empty if the state is invalid
+   */
+  void PredictStores(const std::vector<float>& feature, std::vector<float>* store_scores) const;
+  /*!
+   * \brief Extract features of states and predict their scores in one batch.
+   * \param task The search task of states
+   * \param states The input states
+   * \param scores The predicted scores for all states
+   * \param store_scores The predicted scores for all stores in all states
+   */
+  void PredictAllStores(const SearchTask& task, const Array<State>& states,
+                        std::vector<float>* scores, std::vector<std::vector<float>>* store_scores);
+
+  /*! \brief All measure inputs seen so far */
+  Array<MeasureInput> inputs_;
+  /*! \brief All measure results seen so far */
+  Array<MeasureResult> results_;
+  /*! \brief The cached features of all measured samples */
+  std::vector<std::vector<float>> features_;
+  /*! \brief The number of features per store, 0 if unknown */
+  int n_features_{0};
+  /*! \brief The trained trees */
+  std::vector<std::vector<TreeNode>> trees_;
+  /*! \brief The random number generator used in warmup */
+  std::mt19937 rand_gen_;
+
+  friend class GBDTModel;
+};
+
+/*!
+ * \brief Managed reference to GBDTModelNode.
+ * \sa GBDTModelNode
+ */
+class GBDTModel : public CostModel {
+ public:
+  /*!
+   * \brief The constructor.
+   * \param max_depth The maximum depth of a tree
+   * \param eta The learning rate
+   * \param reg_lambda The L2 regularization on leaf values
+   * \param gamma The minimum gain required to make a split
+   * \param min_child_weight The minimum sum of hessian required in a child
+   * \param num_rounds The maximum number of boosting rounds
+   * \param early_stopping_rounds Stop if the training loss does not improve for this many rounds
+   * \param max_bins The maximum number of histogram bins per feature
+   * \param num_warmup_sample Predict random scores until this many samples have been seen
+   * \param max_n_bufs The maximum number of buffers used in feature extraction
+   * \param seed The random seed
+   */
+  GBDTModel(int max_depth, double eta, double reg_lambda, double gamma, double min_child_weight,
+            int num_rounds, int early_stopping_rounds, int max_bins, int num_warmup_sample,
+            int max_n_bufs, int seed);
+
+  TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(GBDTModel, CostModel, GBDTModelNode);
+};
+
 /*! \brief A wrapper for cost model defined by python code
  *  This class will call functions defined in the python */
 class PythonBasedModelNode : public CostModelNode {
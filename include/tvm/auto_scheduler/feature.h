@@ -33,6 +33,7 @@
 
 #include <tvm/auto_scheduler/compute_dag.h>
 #include <tvm/auto_scheduler/measure.h>
+#include <tvm/runtime/ndarray.h>
 
 #include <string>
 #include <vector>
@@ -83,6 +84,26 @@ void GetPerStoreFeaturesFromStates(const Array<State>& states, const std::vector
                                    int skip_first_n_feature_extraction, int max_n_bufs,
                                    std::vector<std::vector<float> >* features);
 
+/*!
+ * \brief Get per-store features from states of the same task, written directly into a
+ * caller-provided columnar buffer instead of one vector per state.
+ * \param states The input states
+ * \param task The search task of the input states
+ * \param skip_first_n_feature_extraction Skip feature extraction for the first n states
+ * \param max_n_bufs The maximum number of extracted buffers for one statement
+ * \param features The output float32 CPU NDArray of shape [n_states, max_n_stores, vec_len].
+ * Row (i, j) holds the feature vector of the j-th BufferStoreNode statement of state i.
+ * Unused rows are filled with zeros.
+ * \param mask The output float32 CPU NDArray of shape [n_states, max_n_stores].
+ * An element is 1 if the corresponding row of features is valid and 0 otherwise.
+ * \return The largest number of BufferStoreNode statements found in one state. If it is larger
+ * than max_n_stores, the extra statements were dropped and the caller should retry with a larger
+ * buffer.
+ */
+int GetPerStoreFeaturesFromStatesColumnar(const Array<State>& states, const SearchTask& task,
+                                          int skip_first_n_feature_extraction, int max_n_bufs,
+                                          runtime::NDArray features, runtime::NDArray mask);
+
 /*!
  * \brief Get per-store features from a log file
  * \param filename The name of log file
@@ -254,6 +254,12 @@ class StateNode : public Object {
    * tile sizes of the state is filled. Only concrete state can be apply to TVM schedule.
    */
   bool concrete;
+  /*!
+   * \brief Cache used by State::Fingerprint. Entry i holds the i-th transform step and the hash
+   * of the first i + 1 steps, so the fingerprint only hashes steps appended or replaced since
+   * the last call. Holding the steps keeps their addresses from being reused.
+   */
+  mutable std::vector<std::pair<Step, uint64_t>> step_hash_cache;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     v->Visit("stages", &stages);
@@ -285,6 +291,16 @@ class State : public ObjectRef {
    */
   String ToStr(bool delete_trivial_loop = true) const;
 
+  /*!
+   * \brief Get a structural fingerprint of the transform steps of this state.
+   * Unlike ToStr, it does not print the loop structure and only hashes the steps that changed
+   * since the last call, which makes it cheap to use for deduplication in the search.
+   * \return The 64-bit fingerprint.
+   * \note The state must be concrete. This function updates a cache in the state and is not
+   * thread-safe for states shared between threads.
+   */
+  uint64_t Fingerprint() const;
+
   /********** Step APIs working on a single stage **********/
   /*!
    * \brief The schedule primitive corresponding to `te::Stage::bind`.
@@ -449,6 +465,32 @@ class State : public ObjectRef {
   TVM_DEFINE_OBJECT_REF_COW_METHOD(StateNode);
 };
 
+/*!
+ * \brief A set of states, deduplicated by their transform steps.
+ * States are bucketed by State::Fingerprint. Two states in the same bucket are only considered
+ * equal if their transform steps are the same, so a fingerprint collision never drops a state.
+ */
+class StateSet {
+ public:
+  /*! \brief Whether a state with the same transform steps is in the set. */
+  bool Contains(const State& state) const;
+  /*!
+   * \brief Insert a state.
+   * \return False if a state with the same transform steps is already in the set.
+   */
+  bool Insert(const State& state);
+  /*! \brief Remove the state with the same transform steps, if any. */
+  void Erase(const State& state);
+  /*! \brief The number of states in the set. */
+  size_t size() const { return size_; }
+
+ private:
+  /*! \brief The states of each fingerprint. */
+  std::unordered_map<uint64_t, std::vector<State>> buckets_;
+  /*! \brief The number of states in all buckets. */
+  size_t size_{0};
+};
+
 }  // namespace auto_scheduler
 }  // namespace tvm
 
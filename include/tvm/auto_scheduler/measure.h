@@ -41,6 +41,8 @@
 #include <tvm/auto_scheduler/loop_state.h>
 #include <tvm/auto_scheduler/search_task.h>
 
+#include <functional>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -171,6 +173,11 @@ class MeasureResultNode : public Object {
   double all_cost;
   /*! \brief The time stamps of this measurement. */
   double timestamp;
+  /*!
+   * \brief The half width of the 95% confidence interval of the mean cost.
+   * 0 if the runner does not estimate it. This is not saved in the record log.
+   */
+  double confidence_interval = 0.0;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     v->Visit("costs", &costs);
@@ -178,6 +185,7 @@ class MeasureResultNode : public Object {
     v->Visit("error_msg", &error_msg);
     v->Visit("all_cost", &all_cost);
     v->Visit("timestamp", &timestamp);
+    v->Visit("confidence_interval", &confidence_interval);
   }
 
   /*! \brief Do shallow copy. */
@@ -200,9 +208,10 @@ class MeasureResult : public ObjectRef {
    * \param error_msg The error message if there is any error.
    * \param all_cost The time cost of build and run.
    * \param timestamp The time stamps of this measurement.
+   * \param confidence_interval The half width of the 95% confidence interval of the mean cost.
    */
   MeasureResult(Array<PrimExpr> costs, int error_no, String error_msg, double all_cost,
-                double timestamp);
+                double timestamp, double confidence_interval = 0.0);
 
   TVM_DEFINE_OBJECT_REF_METHODS(MeasureResult, ObjectRef, MeasureResultNode);
 };
@@ -280,6 +289,18 @@ class ProgramBuilderNode : public Object {
    */
   virtual Array<BuildResult> Build(const Array<MeasureInput>& inputs, int verbose) = 0;
 
+  /*!
+   * \brief Start building programs without waiting for the results.
+   * The builds may proceed in the background until the returned function is called.
+   * \param inputs An Array of MeasureInput.
+   * \param verbose Verbosity level. 0 for silent, 1 to output information during program
+   * building.
+   * \return A function that waits for the builds and returns the results.
+   * \note The default implementation builds synchronously.
+   */
+  virtual TypedPackedFunc<Array<BuildResult>()> BuildAsync(const Array<MeasureInput>& inputs,
+                                                           int verbose);
+
   static constexpr const char* _type_key = "auto_scheduler.ProgramBuilder";
   TVM_DECLARE_BASE_OBJECT_INFO(ProgramBuilderNode, Object);
 };
@@ -340,8 +361,15 @@ class LocalBuilderNode : public ProgramBuilderNode {
  public:
   /*! \brief Build function. */
   String build_func;
+  /*!
+   * \brief Whether to build in a pool of worker processes that persists across batches,
+   * instead of starting a new process for every build.
+   */
+  bool persistent_workers = false;
 
   Array<BuildResult> Build(const Array<MeasureInput>& inputs, int verbose) final;
+  TypedPackedFunc<Array<BuildResult>()> BuildAsync(const Array<MeasureInput>& inputs,
+                                                   int verbose) final;
 
   static constexpr const char* _type_key = "auto_scheduler.LocalBuilder";
   TVM_DECLARE_FINAL_OBJECT_INFO(LocalBuilderNode, ProgramBuilderNode);
@@ -359,8 +387,10 @@ class LocalBuilder : public ProgramBuilder {
    * This will be used in a wrapper of the multiprocessing.Process.join().
    * \param n_parallel The number of threads used to build in parallel.
    * \param build_func The name of the registered build function.
+   * \param persistent_workers Whether to build in a persistent pool of worker processes.
    */
-  LocalBuilder(int timeout, int n_parallel, const String& build_func);
+  LocalBuilder(int timeout, int n_parallel, const String& build_func,
+               bool persistent_workers = false);
 
   TVM_DEFINE_OBJECT_REF_METHODS(LocalBuilder, ProgramBuilder, LocalBuilderNode);
 };
@@ -368,11 +398,33 @@ class LocalBuilder : public ProgramBuilder {
 /*! \brief LocalRunner that uses local CPU/GPU to measure the time cost of programs */
 class LocalRunnerNode : public ProgramRunnerNode {
  public:
+  /*!
+   * \brief Whether to adapt the number of repeats to the measurement noise.
+   * A candidate stops early once it is statistically slower than the best one measured so far,
+   * and close contenders are repeated up to `max_repeat` times.
+   */
+  bool adaptive = false;
+  /*! \brief The maximum number of repeats in adaptive mode. */
+  int max_repeat = 0;
+  /*! \brief The relative confidence interval width at which adaptive measurement stops. */
+  double ci_tolerance = 0.0;
+  /*!
+   * \brief Whether to run in a worker process that persists across batches,
+   * instead of starting a new process for every run.
+   */
+  bool persistent_workers = false;
+
   Array<MeasureResult> Run(const Array<MeasureInput>& inputs,
                            const Array<BuildResult>& build_results, int verbose) final;
 
   static constexpr const char* _type_key = "auto_scheduler.LocalRunner";
   TVM_DECLARE_FINAL_OBJECT_INFO(LocalRunnerNode, ProgramRunnerNode);
+
+ private:
+  /*! \brief The best mean cost measured so far for each workload key, used in adaptive mode. */
+  std::unordered_map<std::string, double> best_costs_;
+  /*! \brief Guards best_costs_, the runner may be shared by several tuning threads. */
+  std::mutex best_costs_mutex_;
 };
 
 /*!
@@ -391,9 +443,15 @@ class LocalRunner : public ProgramRunner {
    * \param min_repeat_ms The minimum duration of one repeat in milliseconds.
    * \param cooldown_interval The cool down interval between two measurements.
    * \param enable_cpu_cache_flush Whether to flush cache on CPU between repeated measurements.
+   * \param adaptive Whether to adapt the number of repeats to the measurement noise.
+   * \param max_repeat The maximum number of repeats in adaptive mode.
+   * \param ci_tolerance The relative confidence interval width at which adaptive measurement
+   * stops.
+   * \param persistent_workers Whether to run in a persistent worker process.
    */
   LocalRunner(int timeout, int number, int repeat, int min_repeat_ms, double cooldown_interval,
-              bool enable_cpu_cache_flush);
+              bool enable_cpu_cache_flush, bool adaptive = false, int max_repeat = 0,
+              double ci_tolerance = 0.0, bool persistent_workers = false);
 
   TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(LocalRunner, ProgramRunner, LocalRunnerNode);
 };
@@ -472,6 +530,14 @@ class ProgramMeasurerNode : public Object {
   ProgramBuilder builder;
   /*! \brief The ProgramRunner to measure each program. */
   ProgramRunner runner;
+  /*!
+   * \brief Whether to overlap building with running. In pipelined mode, the next batch is
+   * built in the background while the current batch is run. Only one batch is run at a time.
+   * \note This is meant for runners that measure on another machine, such as RPCRunner. With
+   * LocalRunner the builds compete with the measured program for the same CPU and skew its
+   * timings, so a warning is logged.
+   */
+  bool pipelined;
   /*! \brief MeasureCallback to be called after each measure batch. */
   Optional<Array<MeasureCallback>> callbacks;
   /*! \brief Verbosity level. 0 for silent, 1 to output information during program measuring. */
@@ -502,6 +568,20 @@ class ProgramMeasurerNode : public Object {
   void SilentMeasure(const SearchTask& task, const Array<MeasureInput>& inputs,
                      Array<MeasureResult>* results);
 
+  /*!
+   * \brief Build and run programs in a pipeline.
+   * The build of the next batch is started with BuildAsync before the current batch is run,
+   * and everything is driven from the calling thread, so the builder and the runner (which may
+   * be implemented in Python) are never called concurrently from other threads.
+   * \param inputs The MeasureInputs.
+   * \param batch_size Number of programs in one build batch.
+   * \param on_batch Callback invoked for every measured batch, in the order of the inputs.
+   */
+  void PipelinedMeasure(
+      const Array<MeasureInput>& inputs, int batch_size,
+      const std::function<void(const Array<MeasureInput>&, const Array<MeasureResult>&)>&
+          on_batch);
+
   /*! \brief The default max continuous error setting. */
   static const int DEFAULT_MAX_CONTINUOUS_ERROR = 150;
 
@@ -524,10 +604,11 @@ class ProgramMeasurer : public ObjectRef {
    * measuring.
    * \param max_continuous_error The number of allowed maximum continuous error before
    * forcely stopping the tuning.
+   * \param pipelined Whether to overlap building with running.
    */
   ProgramMeasurer(ProgramBuilder builder, ProgramRunner runner,
                   Optional<Array<MeasureCallback>> callbacks, int verbose,
-                  int max_continuous_error = -1);
+                  int max_continuous_error = -1, bool pipelined = false);
 
   TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(ProgramMeasurer, ObjectRef, ProgramMeasurerNode);
 };
@@ -19,7 +19,8 @@
 
 /*!
  * \file tvm/auto_scheduler/measure_record.h
- * \brief Json serialization format for dumping and loading measurement records.
+ * \brief Json serialization format and binary record store for dumping and loading
+ *  measurement records.
  */
 
 #ifndef TVM_AUTO_SCHEDULER_MEASURE_RECORD_H_
@@ -29,6 +30,7 @@
 
 #include <fstream>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 namespace tvm {
@@ -64,6 +66,162 @@ class RecordToFile : public MeasureCallback {
   TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(RecordToFile, MeasureCallback, RecordToFileNode);
 };
 
+/*!
+ * \brief An append-only binary store of measure records, indexed by workload key and target.
+ *
+ * Each record is a small binary header (workload key, target, mean cost and error number)
+ * followed by the json encoding of the record used by the text logs. The index maps every
+ * (workload key, target) pair to the offset of its best record, so best-record queries only
+ * decode the records they return. The index is saved to "<filename>.idx" and, when a store is
+ * opened, only the records appended after the index was written are scanned.
+ *
+ * Several tuners may append to the same store. Opening and appending hold an exclusive lock
+ * on the store file, and every append first picks up the records written by the others. On
+ * Windows the file is not locked and a store must only be appended to by one writer at a time.
+ */
+class RecordStoreNode : public Object {
+ public:
+  /*! \brief The name of the store file. */
+  String filename;
+
+  void VisitAttrs(tvm::AttrVisitor* v) { v->Visit("filename", &filename); }
+
+  /*!
+   * \brief Append measure records to the store and update the index.
+   * \param inputs The MeasureInputs to be written.
+   * \param results The MeasureResults to be written.
+   */
+  void Append(const Array<MeasureInput>& inputs, const Array<MeasureResult>& results);
+
+  /*!
+   * \brief Read the best valid record of a workload on a target.
+   * \param workload_key The workload key.
+   * \param target The string form of the target.
+   * \param inp A pointer to a MeasureInputNode, this is used as output.
+   * \param res A pointer to a MeasureResultNode, this is used as output.
+   * \return Whether a valid record is found.
+   */
+  bool ReadBest(const std::string& workload_key, const std::string& target, MeasureInputNode* inp,
+                MeasureResultNode* res);
+
+  /*!
+   * \brief Read the best valid record of every (workload key, target) pair in the store.
+   * \return The MeasureInputs and MeasureResults of the best records.
+   */
+  std::pair<Array<MeasureInput>, Array<MeasureResult>> ReadBestRecords();
+
+  /*!
+   * \brief Read the next record in the store. Records are read in the order of appending.
+   * \param inp A pointer to a MeasureInputNode, this is used as output.
+   * \param res A pointer to a MeasureResultNode, this is used as output.
+   * \return Whether the read is successful.
+   */
+  bool ReadNext(MeasureInputNode* inp, MeasureResultNode* res);
+
+  /*! \brief Restart reading from the first record. */
+  void Reset();
+
+  /*! \return The number of records in the store. */
+  int64_t NumRecords() const { return num_records_; }
+
+  /*!
+   * \brief Check whether a file is a binary record store.
+   * \param filename The name of the file.
+   * \return Whether the file starts with the header of a record store.
+   */
+  static bool IsRecordStore(const std::string& filename);
+
+  static constexpr const char* _type_key = "auto_scheduler.RecordStore";
+  TVM_DECLARE_FINAL_OBJECT_INFO(RecordStoreNode, Object);
+
+ private:
+  /*! \brief The best record of one (workload key, target) pair. */
+  struct IndexEntry {
+    /*! \brief The offset of the best valid record, -1 if there is none. */
+    int64_t best_offset{-1};
+    /*! \brief The mean cost of the best valid record. */
+    double best_cost{0};
+    /*! \brief The number of records, including invalid ones. */
+    int64_t count{0};
+  };
+
+  /*! \brief Load the saved index and scan the records appended after it. */
+  void Open();
+  /*! \brief Scan records from end_offset_ and add them to the index. */
+  void ScanTail();
+  /*! \brief Save the index to "<filename>.idx". */
+  void SaveIndex() const;
+  /*! \brief Add one record to the index. */
+  void AddToIndex(const std::string& workload_key, const std::string& target, double cost,
+                  int error_no, int64_t offset);
+  /*! \brief Decode the record at the given offset. */
+  void ReadRecordAt(int64_t offset, MeasureInputNode* inp, MeasureResultNode* res) const;
+
+  /*! \brief The index from workload key and then target to the best record. */
+  std::unordered_map<std::string, std::unordered_map<std::string, IndexEntry>> index_;
+  /*! \brief The offset right after the last complete record. */
+  int64_t end_offset_{0};
+  /*! \brief The number of records in the store. */
+  int64_t num_records_{0};
+  /*! \brief The offset of the next record returned by ReadNext. */
+  int64_t read_offset_{0};
+  /*! \brief The stream used by ReadNext. */
+  std::ifstream read_stream_;
+
+  friend class RecordStore;
+};
+
+/*!
+ * \brief Managed reference to RecordStoreNode.
+ * \sa RecordStoreNode
+ */
+class RecordStore : public ObjectRef {
+ public:
+  /*!
+   * \brief The constructor. Create the file if it does not exist.
+   * \param filename The name of the store file
+   */
+  explicit RecordStore(String filename);
+
+  TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(RecordStore, ObjectRef, RecordStoreNode);
+};
+
+/*! \brief Callback for appending the input and results of measurements to a record store */
+class RecordToStoreNode : public MeasureCallbackNode {
+ public:
+  /*! \brief The record store to append to. */
+  RecordStore store;
+
+  void Callback(const SearchPolicy& policy, const Array<MeasureInput>& inputs,
+                const Array<MeasureResult>& results) final;
+
+  static constexpr const char* _type_key = "auto_scheduler.RecordToStore";
+  TVM_DECLARE_FINAL_OBJECT_INFO(RecordToStoreNode, MeasureCallbackNode);
+};
+
+/*!
+ * \brief Managed reference to RecordToStoreNode.
+ * \sa RecordToStoreNode
+ */
+class RecordToStore : public MeasureCallback {
+ public:
+  /*!
+   * \brief The constructor.
+   * \param filename The name of the store file
+   */
+  explicit RecordToStore(String filename);
+
+  TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(RecordToStore, MeasureCallback, RecordToStoreNode);
+};
+
+/*!
+ * \brief Convert a json log file to a binary record store.
+ * \param log_filename The name of the json log file.
+ * \param store_filename The name of the record store. Records are appended if it exists.
+ * \return The number of converted records.
+ */
+int64_t ConvertRecordsToStore(const std::string& log_filename, const std::string& store_filename);
+
 /*! \brief Log reader to load step logs from a file.*/
 class RecordReaderNode : public Object {
  public:
@@ -71,6 +229,8 @@ class RecordReaderNode : public Object {
   String filename;
   /*! \brief The reading file stream. */
   std::ifstream infile;
+  /*! \brief The record store to read from if the file is a binary record store. */
+  Optional<RecordStore> store;
 
   ~RecordReaderNode();
 
@@ -112,6 +112,42 @@ class PreloadMeasuredStates : public SearchCallback {
                                         PreloadMeasuredStatesNode);
 };
 
+/*!
+ * \brief Preload the best states of structurally similar tasks from a log file.
+ * Only the records of workloads with the same compute function or DAG hash in their workload
+ * key are considered. The states are replayed on the current task with split factors adapted to the new
+ * axis extents, and are used to warm start the search.
+ */
+class PreloadTransferStatesNode : public SearchCallbackNode {
+ public:
+  /*! \brief The name of the record log file. */
+  String filename;
+  /*! \brief The maximum number of states to transfer. */
+  int max_states;
+
+  void Callback(SearchPolicyNode* policy) final;
+
+  static constexpr const char* _type_key = "auto_scheduler.PreloadTransferStates";
+  TVM_DECLARE_FINAL_OBJECT_INFO(PreloadTransferStatesNode, SearchCallbackNode);
+};
+
+/*!
+ * \brief Managed reference to PreloadTransferStatesNode.
+ * \sa PreloadTransferStatesNode
+ */
+class PreloadTransferStates : public SearchCallback {
+ public:
+  /*!
+   * \brief The constructor.
+   * \param filename The name of the record log file.
+   * \param max_states The maximum number of states to transfer.
+   */
+  PreloadTransferStates(String filename, int max_states);
+
+  TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(PreloadTransferStates, SearchCallback,
+                                        PreloadTransferStatesNode);
+};
+
 /*! \brief Attribute keys of ops used for SearchPolicy. */
 struct SearchPolicyKey {
   /*! \brief Always apply unroll to the inner most iterator of the specificed iterators. */
@@ -168,6 +204,15 @@ class SearchPolicyNode : public Object {
    */
   void PreloadMeasuredStates(const String& log_file);
 
+  /*!
+   * \brief Preload the best states of other tasks from a log file as warm start candidates.
+   * Records of other workloads whose steps can be replayed on the current task are kept, with
+   * their split factors adapted to the extents of the current task.
+   * \param log_file The name of the record log file.
+   * \param max_states The maximum number of states to keep.
+   */
+  void PreloadTransferStates(const String& log_file, int max_states);
+
   /*!
    * \brief Call SearchCallback with the current SearchPolicyNode
    * \param callbacks SearchCallback to be called.
@@ -180,15 +225,20 @@ class SearchPolicyNode : public Object {
  protected:
   /*!
    * \brief The set of already measured states.
-   * We store the string format of a state for redundancy check. This is used to make sure a
-   * measured state will never be measured again.
+   * States are deduplicated by their transform steps (see StateSet). This is used to make sure
+   * a measured state will never be measured again.
    */
-  std::unordered_set<std::string> measured_states_set_;
+  StateSet measured_states_set_;
   /*! \brief The array of already measured states.
    *  The good states can be used as the initial population in evolutionary search. */
   std::vector<State> measured_states_vector_;
   /*! \brief The throughputs of already measured states */
   std::vector<float> measured_states_throughputs_;
+  /*!
+   * \brief States transferred from similar tasks that have not been proposed for measurement.
+   * They are sorted by decreasing similarity to the current task.
+   */
+  std::vector<State> transfer_states_;
 };
 
 /*!
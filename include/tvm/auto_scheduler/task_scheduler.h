@@ -0,0 +1,233 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file auto_scheduler/task_scheduler.h
+ * \brief The task scheduler that allocates the time resources when tuning multiple tasks together.
+ *
+ * The scheduler tunes all tasks round by round. In every round it picks one task, lets its
+ * search policy measure one batch of programs with the shared ProgramMeasurer, and updates the
+ * latency history of that task. With the "gradient" strategy the task is picked by estimating
+ * how much one more round of it would reduce the weighted end-to-end latency:
+ * the weight of the task times a mix of the recent improvement of the task (backward gradient)
+ * and an optimistic guess of its next improvement (forward gradient), which also considers the
+ * best speed reached by similar tasks.
+ *
+ * Every decision is recorded as a TaskSchedulerDecision, so users can inspect why the trials
+ * went where they did.
+ */
+
+#ifndef TVM_AUTO_SCHEDULER_TASK_SCHEDULER_H_
+#define TVM_AUTO_SCHEDULER_TASK_SCHEDULER_H_
+
+#include <tvm/auto_scheduler/measure.h>
+#include <tvm/auto_scheduler/search_policy.h>
+#include <tvm/auto_scheduler/search_task.h>
+
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tvm {
+namespace auto_scheduler {
+
+/*! \brief The record of one decision of the TaskScheduler. */
+class TaskSchedulerDecisionNode : public Object {
+ public:
+  /*! \brief The index of the tuning round. */
+  int round;
+  /*! \brief The index of the chosen task. */
+  int task_idx;
+  /*!
+   * \brief Why the task was chosen.
+   * "warmup", "round-robin", "gradient" or "random" (all gradients were equal).
+   */
+  String reason;
+  /*! \brief The gradient of every task. Empty for decisions not made by gradients. */
+  Array<FloatImm> gradients;
+  /*! \brief The weighted latency of all tasks before this round. */
+  double score;
+  /*! \brief The number of measurement trials done before this round. */
+  int num_trials;
+  /*! \brief The number of measurement trials left in the budget. */
+  int remaining_trials;
+
+  void VisitAttrs(tvm::AttrVisitor* v) {
+    v->Visit("round", &round);
+    v->Visit("task_idx", &task_idx);
+    v->Visit("reason", &reason);
+    v->Visit("gradients", &gradients);
+    v->Visit("score", &score);
+    v->Visit("num_trials", &num_trials);
+    v->Visit("remaining_trials", &remaining_trials);
+  }
+
+  static constexpr const char* _type_key = "auto_scheduler.TaskSchedulerDecision";
+  TVM_DECLARE_FINAL_OBJECT_INFO(TaskSchedulerDecisionNode, Object);
+};
+
+/*!
+ * \brief Managed reference to TaskSchedulerDecisionNode.
+ * \sa TaskSchedulerDecisionNode
+ */
+class TaskSchedulerDecision : public ObjectRef {
+ public:
+  TVM_DEFINE_OBJECT_REF_METHODS(TaskSchedulerDecision, ObjectRef, TaskSchedulerDecisionNode);
+};
+
+/*! \brief The task scheduler that tunes multiple tasks in one measurement stream. */
+class TaskSchedulerNode : public Object {
+ public:
+  /*! \brief The tasks to tune. */
+  Array<SearchTask> tasks;
+  /*! \brief The weight of each task in the end-to-end latency. */
+  Array<FloatImm> task_weights;
+  /*!
+   * \brief The similarity tag of each task. Tasks with the same non-empty tag are considered
+   * to be similar, and the best speed of the group bounds the forward gradient of its members.
+   */
+  Array<String> task_tags;
+  /*! \brief The scheduling strategy, "gradient" or "round-robin". */
+  String strategy;
+  /*! \brief The weight of the backward gradient against the forward gradient. */
+  double alpha;
+  /*! \brief A task is considered as dissimilar to its group if it is beta times slower. */
+  double beta;
+  /*! \brief The number of rounds used to compute the backward gradient. */
+  int backward_window_size;
+
+  /*! \brief The number of rounds each task has been tuned. */
+  std::vector<int> task_cts;
+  /*! \brief The round in which each task got its best latency. */
+  std::vector<int> task_best_cts;
+  /*! \brief The best latency of each task after each of its rounds. */
+  std::vector<std::vector<double>> task_costs_history;
+  /*! \brief The best latency of each task. */
+  std::vector<double> best_costs;
+  /*! \brief The tasks that will not be tuned any more. */
+  std::set<int> dead_tasks;
+  /*! \brief The total number of measurement trials done. */
+  int ct = 0;
+  /*! \brief The decisions made so far. */
+  Array<TaskSchedulerDecision> decisions;
+
+  void VisitAttrs(tvm::AttrVisitor* v) {
+    v->Visit("tasks", &tasks);
+    v->Visit("task_weights", &task_weights);
+    v->Visit("task_tags", &task_tags);
+    v->Visit("strategy", &strategy);
+    v->Visit("alpha", &alpha);
+    v->Visit("beta", &beta);
+    v->Visit("backward_window_size", &backward_window_size);
+    v->Visit("ct", &ct);
+    v->Visit("decisions", &decisions);
+  }
+
+  /*!
+   * \brief Compute the weighted end-to-end latency.
+   * \param costs The latency of each task.
+   * \return The weighted sum of the latencies.
+   */
+  double ComputeScore(const std::vector<double>& costs) const;
+
+  /*!
+   * \brief Choose the task to tune in the next round and record the decision.
+   * \param remaining_trials The number of measurement trials left in the budget.
+   * \return The index of the chosen task.
+   */
+  int NextTask(int remaining_trials);
+
+  /*!
+   * \brief Update the status after a round of a task.
+   * \param task_idx The index of the tuned task.
+   * \param inputs The programs measured in this round.
+   * \param results The measurement results of this round.
+   * \param num_measures_per_round The number of programs measured per round.
+   * \param per_task_early_stopping Stop tuning a task if it has no improvement after this many
+   * measurements. -1 to disable.
+   */
+  void Update(int task_idx, const Array<MeasureInput>& inputs, const Array<MeasureResult>& results,
+              int num_measures_per_round, int per_task_early_stopping);
+
+  /*!
+   * \brief Tune all tasks.
+   * \param search_policies The search policy of each task.
+   * \param measurer The measurer shared by all tasks. A pipelined measurer overlaps building and
+   * running within each round.
+   * \param num_measure_trials The total number of measurement trials.
+   * \param num_measures_per_round The number of programs measured per round.
+   * \param early_stopping Stop tuning if the score has no improvement after this many
+   * measurements. -1 to disable.
+   * \param per_task_early_stopping Stop tuning a task if it has no improvement after this many
+   * measurements. -1 to disable.
+   * \param round_callback If defined, called with (task_idx, is_post_tune) before and after
+   * every round.
+   */
+  void Tune(const Array<SearchPolicy>& search_policies, ProgramMeasurer measurer,
+            int num_measure_trials, int num_measures_per_round, int early_stopping,
+            int per_task_early_stopping, Optional<runtime::PackedFunc> round_callback);
+
+  static constexpr const char* _type_key = "auto_scheduler.TaskScheduler";
+  TVM_DECLARE_FINAL_OBJECT_INFO(TaskSchedulerNode, Object);
+
+ private:
+  /*! \brief Remove a task from its similarity group if it is much slower than the group. */
+  void AdjustSimilarityGroup(int task_idx);
+
+  /*! \brief The current similarity tag of each task. Empty if the task has no group. */
+  std::vector<std::string> cur_tags_;
+  /*! \brief The tasks in each similarity group. */
+  std::unordered_map<std::string, std::vector<int>> group_task_ids_;
+  /*! \brief The random generator used to break ties. */
+  std::mt19937 rand_gen_{0};
+  /*! \brief The round-robin cursor. */
+  int rr_cursor_ = -1;
+
+  friend class TaskScheduler;
+};
+
+/*!
+ * \brief Managed reference to TaskSchedulerNode.
+ * \sa TaskSchedulerNode
+ */
+class TaskScheduler : public ObjectRef {
+ public:
+  /*!
+   * \brief The constructor.
+   * \param tasks The tasks to tune.
+   * \param task_weights The weight of each task in the end-to-end latency.
+   * Empty means all weights are 1.
+   * \param task_tags The similarity tag of each task. Empty means no tasks are similar.
+   * \param strategy The scheduling strategy, "gradient" or "round-robin".
+   * \param alpha The weight of the backward gradient against the forward gradient.
+   * \param beta The slowdown to consider a task as dissimilar to its group.
+   * \param backward_window_size The number of rounds used to compute the backward gradient.
+   */
+  TaskScheduler(Array<SearchTask> tasks, Array<FloatImm> task_weights, Array<String> task_tags,
+                String strategy, double alpha, double beta, int backward_window_size);
+
+  TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(TaskScheduler, ObjectRef, TaskSchedulerNode);
+};
+
+}  // namespace auto_scheduler
+}  // namespace tvm
+
+#endif  // TVM_AUTO_SCHEDULER_TASK_SCHEDULER_H_
@@ -27,6 +27,7 @@
 #define TVM_IR_INSTRUMENT_H_
 
 #include <tvm/node/reflection.h>
+#include <tvm/runtime/container/array.h>
 #include <tvm/runtime/container/string.h>
 
 #include <utility>
@@ -151,6 +152,53 @@ class PassInstrument : public ObjectRef {
   TVM_DEFINE_OBJECT_REF_METHODS(PassInstrument, ObjectRef, PassInstrumentNode);
 };
 
+/*!
+ * \brief Profiling result of a single pass invocation, collected by the pass timing instrument.
+ * \sa PassProfile
+ */
+class PassProfileNode : public Object {
+ public:
+  /*! \brief The name of the pass. */
+  String name;
+  /*! \brief The wall time of the pass including its sub-passes, in microseconds. */
+  double duration_us;
+  /*! \brief The wall time spent in the pass itself excluding its sub-passes, in microseconds. */
+  double self_duration_us;
+  /*!
+   * \brief The change of the resident memory of the process during the pass, in bytes.
+   *  Zero when memory tracking is disabled or unsupported on the platform.
+   */
+  int64_t memory_delta_bytes;
+  /*! \brief The number of IR nodes in the module before the pass, -1 if not tracked. */
+  int64_t ir_size_before;
+  /*! \brief The number of IR nodes in the module after the pass, -1 if not tracked. */
+  int64_t ir_size_after;
+  /*! \brief The profiles of the sub-passes invoked during the pass, in invocation order. */
+  Array<ObjectRef> children;
+
+  void VisitAttrs(AttrVisitor* v) {
+    v->Visit("name", &name);
+    v->Visit("duration_us", &duration_us);
+    v->Visit("self_duration_us", &self_duration_us);
+    v->Visit("memory_delta_bytes", &memory_delta_bytes);
+    v->Visit("ir_size_before", &ir_size_before);
+    v->Visit("ir_size_after", &ir_size_after);
+    v->Visit("children", &children);
+  }
+
+  static constexpr const char* _type_key = "instrument.PassProfile";
+  TVM_DECLARE_FINAL_OBJECT_INFO(PassProfileNode, Object);
+};
+
+/*!
+ * \brief Managed reference class for PassProfileNode
+ * \sa PassProfileNode
+ */
+class PassProfile : public ObjectRef {
+ public:
+  TVM_DEFINE_OBJECT_REF_METHODS(PassProfile, ObjectRef, PassProfileNode);
+};
+
 }  // namespace instrument
 }  // namespace tvm
 
@@ -47,5 +47,27 @@ TVM_DLL std::string SaveJSON(const runtime::ObjectRef& node);
  */
 TVM_DLL runtime::ObjectRef LoadJSON(std::string json_str);
 
+/*!
+ * \brief save the node as well as all the node it depends on in a compact binary format.
+ *
+ *  Compared to SaveJSON, the field values are packed in visiting order without names,
+ *  and NDArrays are stored as raw, aligned payloads instead of base64 strings.
+ *
+ * \return The binary blob of the node.
+ */
+TVM_DLL std::string SaveBinary(const runtime::ObjectRef& node);
+
+/*!
+ * \brief Load tvm Node object from a blob created by SaveBinary.
+ *
+ *  The blob must have been saved by the same TVM version. Each NDArray is copied
+ *  once out of the blob, into a newly allocated CPU tensor.
+ *
+ * \param blob The binary blob to load from.
+ *
+ * \return The loaded node.
+ */
+TVM_DLL runtime::ObjectRef LoadBinary(const std::string& blob);
+
 }  // namespace tvm
 #endif  // TVM_NODE_SERIALIZATION_H_
@@ -31,7 +31,10 @@
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/vm/bytecode.h>
 
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -172,12 +175,27 @@ class Executable : public ModuleNode {
    */
   std::string GetFunctionParameterName(std::string func, uint32_t index) const;
 
+  /*!
+   * \brief Get a constant from the constant pool.
+   *
+   * Constants of a deserialized executable are not materialized by Load. Each
+   * of them is decoded from the serialized code the first time it is requested.
+   *
+   * \param index The index of the constant.
+   * \return The constant.
+   */
+  ObjectRef GetConstant(Index index) const;
+
   virtual ~Executable() {}
 
   const char* type_key() const final { return "VMExecutable"; }
 
-  /*! \brief The global constant pool. */
-  std::vector<ObjectRef> constants;
+  /*!
+   * \brief The global constant pool.
+   * \note Entries of a deserialized executable stay undefined until
+   *  they are loaded by GetConstant.
+   */
+  mutable std::vector<ObjectRef> constants;
   /*! \brief A map from globals (as strings) to their index in the function map. */
   std::unordered_map<std::string, Index> global_map;
   /*! \brief A mapping from the packed function (as string) to the index that
@@ -228,11 +246,12 @@ class Executable : public ModuleNode {
   void LoadGlobalSection(dmlc::Stream* strm);
 
   /*!
-   * \brief Load the constant pool.
+   * \brief Index the constant pool. Only the location of each constant in
+   *  `code_` is recorded, the payloads are skipped and loaded on demand.
    *
    * \param strm The input stream.
    */
-  void LoadConstantSection(dmlc::Stream* strm);
+  void LoadConstantSection(dmlc::SeekStream* strm);
 
   /*!
    * \brief Load primitive op names.
@@ -248,8 +267,25 @@ class Executable : public ModuleNode {
    */
   void LoadCodeSection(dmlc::Stream* strm);
 
+  /*!
+   * \brief Materialize all the constants that are still pending in `code_`.
+   */
+  void LoadAllConstants() const;
+
   /*! \brief The serialized bytecode. */
   std::string code_;
+  /*!
+   * \brief The byte offset in `code_` of each serialized constant.
+   *  Only written by Load, empty when the constants are not deserialized.
+   */
+  std::vector<size_t> const_offsets_;
+  /*!
+   * \brief Whether each serialized constant has been materialized in `constants`,
+   *  which lets GetConstant return a loaded constant without taking the lock.
+   */
+  mutable std::unique_ptr<std::atomic<bool>[]> const_loaded_;
+  /*! \brief Guards the lazy loading of constants. */
+  mutable std::mutex const_mutex_;
 };
 
 }  // namespace vm
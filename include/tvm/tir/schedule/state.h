@@ -128,6 +128,16 @@ class ScheduleStateNode : public Object {
    */
   TVM_DLL void Replace(const tir::StmtSRef& src_sref, const Stmt& tgt_stmt,
                        const Map<Block, Block>& block_sref_reuse);
+  /*!
+   * \brief Recalculate the `block_info` of all blocks under a scope, including the scope root.
+   * Schedule primitives that create new blocks or move blocks across loops call this method after
+   * `Replace`, so that the cached flags `affine_binding`, `region_cover` and `stage_pipeline`
+   * stay accurate.
+   * \param scope_root_realize The BlockRealize of the scope root block
+   * \note The `region_cover` flag of the scope root itself is decided by its parent scope, and is
+   * kept unchanged.
+   */
+  TVM_DLL void UpdateScopeBlockInfo(const BlockRealize& scope_root_realize);
   /*!
    * \brief Trigger the verification according to the `debug_mode` bitmask.
    * 1) If the bitmask `kVerifySRefTree` is on, verify the correctness of the sref tree.
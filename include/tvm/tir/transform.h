@@ -63,6 +63,39 @@ TVM_DLL Pass CreatePrimFuncPass(
  */
 TVM_DLL Pass InjectPrefetch();
 
+/*!
+ * \brief Insert prefetches for the strided and indirect loads of innermost loops on CPU.
+ *
+ *  The pass is configured by the "tir.AutoPrefetch" option of the PassContext
+ *  and does nothing unless it is enabled there.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass AutoPrefetch();
+
+/*!
+ * \brief Tile and interchange the perfectly nested affine loop nests on CPU
+ *  so that the data touched by a tile fits in the L1 cache.
+ *
+ *  The pass is configured by the "tir.AutoCacheTiling" option of the PassContext
+ *  and does nothing unless it is enabled there. The cache size defaults to the
+ *  "l1-cache-size" attribute of the target.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass AutoCacheTiling();
+
+/*!
+ * \brief Make specialized variants of the dynamic shape functions for their
+ *  frequent shapes, and dispatch to them at run time by the shape vars.
+ *
+ *  The pass is configured by the "tir.SpecializeShapes" option of the PassContext,
+ *  each frequent shape maps the names of the shape vars to their values.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass SpecializeShapes();
+
 // TODO(tvm-team): consolidate configs to the PassContext
 /*!
  * \brief Flatten the multi-dimensional read/write
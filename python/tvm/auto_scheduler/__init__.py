@@ -32,7 +32,7 @@ from . import workload_registry
 
 # Shortcut
 from .compute_dag import ComputeDAG, LayoutRewriteOption, get_shape_from_rewritten_layout
-from .cost_model import RandomModel, XGBModel
+from .cost_model import RandomModel, GBDTModel, XGBModel
 from .dispatcher import DispatchContext, ApplyHistoryBest, ApplyHistoryBestOrSample
 from .measure import (
     MeasureInput,
@@ -43,7 +43,16 @@ from .measure import (
     LocalRPCMeasureContext,
     register_task_input_check_func,
 )
-from .measure_record import RecordToFile, RecordReader, load_best_record, load_records, save_records
+from .measure_record import (
+    RecordToFile,
+    RecordReader,
+    RecordStore,
+    RecordToStore,
+    convert_records_to_store,
+    load_best_record,
+    load_records,
+    save_records,
+)
 from .relay_integration import (
     extract_tasks,
     remove_index_check,
@@ -55,6 +64,7 @@ from .search_policy import (
     EmptyPolicy,
     SketchPolicy,
     PreloadMeasuredStates,
+    PreloadTransferStates,
     PreloadCustomSketchRule,
 )
 from .task_scheduler import TaskScheduler
@@ -66,6 +66,98 @@ class RandomModel(CostModel):
         return [x.value for x in _ffi_api.CostModelPredict(self, search_task, states)]
 
 
+@tvm._ffi.register_object("auto_scheduler.GBDTModel")
+class GBDTModel(CostModel):
+    """A gradient boosted decision tree model that is trained and evaluated in C++.
+
+    It uses the same per-store features and pack-sum objective as :any:`XGBModel`,
+    but does not call back into python during the search.
+
+    Parameters
+    ----------
+    max_depth : int = 10
+        The maximum depth of a tree.
+    eta : float = 0.2
+        The learning rate.
+    reg_lambda : float = 1.0
+        The L2 regularization on leaf values.
+    gamma : float = 0.001
+        The minimum gain required to make a split.
+    min_child_weight : float = 0
+        The minimum sum of hessian required in a child.
+    num_rounds : int = 300
+        The maximum number of boosting rounds.
+    early_stopping_rounds : int = 50
+        Stop training if the training loss does not improve for this many rounds.
+    max_bins : int = 256
+        The maximum number of histogram bins per feature.
+    num_warmup_sample : int = 100
+        Predict random scores until this many measured samples have been seen.
+    max_n_bufs : int = 5
+        The maximum number of buffers used in feature extraction.
+    seed : int = 0
+        The random seed.
+    """
+
+    def __init__(
+        self,
+        max_depth=10,
+        eta=0.2,
+        reg_lambda=1.0,
+        gamma=0.001,
+        min_child_weight=0,
+        num_rounds=300,
+        early_stopping_rounds=50,
+        max_bins=256,
+        num_warmup_sample=100,
+        max_n_bufs=5,
+        seed=0,
+    ):
+        self.__init_handle_by_constructor__(
+            _ffi_api.GBDTModel,
+            max_depth,
+            eta,
+            reg_lambda,
+            gamma,
+            min_child_weight,
+            num_rounds,
+            early_stopping_rounds,
+            max_bins,
+            num_warmup_sample,
+            max_n_bufs,
+            seed,
+        )
+
+    def update(self, inputs, results):
+        """Update the cost model according to new measurement results (training data).
+
+        Parameters
+        ----------
+        inputs : List[auto_scheduler.measure.MeasureInput]
+            The measurement inputs
+        results : List[auto_scheduler.measure.MeasureResult]
+            The measurement results
+        """
+        _ffi_api.CostModelUpdate(self, inputs, results)
+
+    def predict(self, search_task, states):
+        """Predict the scores of states
+
+        Parameters
+        ----------
+        search_task : SearchTask
+            The search task of states
+        states : List[State]
+            The input states
+
+        Returns
+        -------
+        scores: List[float]
+            The predicted scores for all states
+        """
+        return [x.value for x in _ffi_api.CostModelPredict(self, search_task, states)]
+
+
 @tvm._ffi.register_func("auto_scheduler.cost_model.random_fill_float")
 def random_fill_float(size, return_ptr):
     """Fills a c++ float array with random numbers in [0, 1]
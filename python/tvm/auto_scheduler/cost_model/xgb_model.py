@@ -25,7 +25,11 @@ import numpy as np
 
 from tvm.autotvm.tuner.metric import max_curve
 from .cost_model import PythonBasedModel
-from ..feature import get_per_store_features_from_measure_pairs, get_per_store_features_from_states
+from ..feature import (
+    get_per_store_features_from_measure_pairs,
+    get_per_store_features_from_states,
+    get_per_store_features_from_states_columnar,
+)
 from ..measure_record import RecordReader
 
 xgb = None
@@ -229,18 +233,17 @@ class XGBModel(PythonBasedModel):
         scores: List[float]
             The predicted scores for all states
         """
-        features = get_per_store_features_from_states(states, task)
+        features, mask = get_per_store_features_from_states_columnar(states, task)
         if self.bst is not None and len(self.inputs) > self.num_warmup_sample:
-            dtest, pack_ids = feature_to_pack_sum_xgbmatrix(features)
+            dtest, pack_ids = columnar_feature_to_pack_sum_xgbmatrix(features, mask)
             raw_preds = self.bst.predict(dtest)
-            ret = predict_throughput_pack_sum(raw_preds, pack_ids)
+            ret = np.bincount(pack_ids, weights=raw_preds, minlength=len(states))
         else:
             ret = np.random.uniform(0, 1, (len(states),))
 
         # Predict -inf for invalid states that failed to be lowered.
-        for idx, feature in enumerate(features):
-            if feature.min() == feature.max() == 0:
-                ret[idx] = float("-inf")
+        invalid = ~(features.reshape((len(states), -1)) != 0).any(axis=1)
+        ret[invalid] = float("-inf")
 
         return ret
 
@@ -368,6 +371,26 @@ def feature_to_pack_sum_xgbmatrix(xs):
     return xgb.DMatrix(np.array(x_flatten)), pack_ids
 
 
+def columnar_feature_to_pack_sum_xgbmatrix(features, mask):
+    """Convert features in the columnar layout to a xgbmatrx in pack-sum format
+    Parameters
+    ----------
+    features: np.ndarray
+        The feature vectors in shape [n_states, n_stores, vec_len]
+    mask: np.ndarray
+        The mask of valid rows in shape [n_states, n_stores]
+    Returns
+    -------
+    dmatrix: xgb.DMatrix
+        The DMatrix
+    pack_ids: np.ndarray
+        pack ids information
+    """
+    valid = mask > 0
+    pack_ids = np.nonzero(valid)[0]
+    return xgb.DMatrix(features[valid]), pack_ids
+
+
 def pack_sum_xgbmatrix(xs, ys, gids=None, weights=None):
     """Convert (feature, label) pairs into a xgb matrix with pack-sum format
     Parameters
@@ -31,6 +31,8 @@ import struct
 
 import numpy as np
 
+from tvm.runtime import ndarray
+
 from .loop_state import State, StateObject
 from .measure import MeasureInput, MeasureResult
 from . import _ffi_api
@@ -41,6 +43,9 @@ DEFAULT_MAX_N_BUFS = 5
 # The length of the feature vector
 DEFAULT_FEATURE_VEC_LEN = 164
 
+# The initial number of BufferStoreNode statements reserved per state in the columnar layout
+DEFAULT_MAX_N_STORES = 32
+
 # The size of int and float in bytes
 SIZE_OF_INT32 = 4
 SIZE_OF_FLOAT32 = 4
@@ -238,6 +243,73 @@ def get_per_store_features_from_states(
     return unpack_feature(byte_arr)[0]
 
 
+def _as_writable_ndarray(np_arr: np.ndarray):
+    """Wrap a numpy array as a tvm NDArray without copy if numpy supports DLPack."""
+    if hasattr(np_arr, "__dlpack__"):
+        return ndarray.from_dlpack(np_arr), False
+    return ndarray.empty(np_arr.shape, str(np_arr.dtype)), True
+
+
+def get_per_store_features_from_states_columnar(
+    states: List[Union[State, StateObject]],
+    task: "SearchTask",
+    max_n_bufs: Optional[int] = None,
+    max_n_stores: Optional[int] = None,
+) -> Tuple[np.ndarray, np.ndarray]:
+    """Get per-store features from states in a dense columnar layout.
+
+    Unlike :any:`get_per_store_features_from_states`, the c++ part writes the features directly
+    into one contiguous buffer, so there is no per-state packing and unpacking.
+
+    Parameters
+    ----------
+    states: List[Union[State, StateObject]]
+        The input states
+    task: SearchTask
+        The search task of the input states
+    max_n_bufs: Optional[int]
+        The maximum number of extracted buffers for one statement
+    max_n_stores: Optional[int]
+        The number of BufferStoreNode statements reserved per state. The buffer is enlarged
+        automatically if a state has more statements.
+
+    Returns
+    -------
+    features: np.ndarray
+        Feature vectors in shape [len(states), n_stores, vec_len]. Invalid rows are zeros.
+    mask: np.ndarray
+        Float mask in shape [len(states), n_stores]. 1 marks a valid row of features.
+        A state that failed to be lowered has no valid rows.
+    """
+    if isinstance(states[0], State):
+        state_objects = [s.state_object for s in states]
+    elif isinstance(states[0], StateObject):
+        state_objects = states
+    max_n_bufs = max_n_bufs or DEFAULT_MAX_N_BUFS
+    vec_len = len(get_per_store_feature_names(max_n_bufs))
+    n_stores = max_n_stores or DEFAULT_MAX_N_STORES
+
+    while True:
+        features = np.empty((len(state_objects), n_stores, vec_len), dtype="float32")
+        mask = np.empty((len(state_objects), n_stores), dtype="float32")
+        features_nd, copy_features = _as_writable_ndarray(features)
+        mask_nd, copy_mask = _as_writable_ndarray(mask)
+        max_stores = _ffi_api.GetPerStoreFeaturesFromStatesColumnar(
+            state_objects, task, max_n_bufs, features_nd, mask_nd
+        )
+        if max_stores <= n_stores:
+            break
+        # Some states have more statements than reserved. Retry with a buffer large enough;
+        # the feature cache, if enabled, makes the second extraction cheap.
+        n_stores = max_stores
+
+    if copy_features:
+        features = features_nd.numpy()
+    if copy_mask:
+        mask = mask_nd.numpy()
+    return features, mask
+
+
 def get_per_store_feature_names(max_n_bufs: Optional[int] = None) -> List[str]:
     """Get the name of every element in the feature vector. Use this for debug and inspection.
 
@@ -252,3 +324,27 @@ def get_per_store_feature_names(max_n_bufs: Optional[int] = None) -> List[str]:
         The names of elements in the flatten feature vector
     """
     return _ffi_api.GetPerStoreFeatureNames(max_n_bufs or DEFAULT_MAX_N_BUFS)
+
+
+def set_feature_cache_capacity(capacity: int = 1024):
+    """Set the capacity of the cache shared by feature extraction workers.
+
+    The cache memoizes the features of previously seen states and the schedules of their
+    transform step prefixes, so that states sharing a prefix with a previous state only
+    apply the remaining steps. The least recently used entries are evicted first.
+
+    The cache is process-wide and keeps the compute dags and schedules of its entries alive,
+    so it is disabled by default. Enable it for the duration of a search, and disable it or
+    call :any:`clear_feature_cache` afterwards.
+
+    Parameters
+    ----------
+    capacity: int = 1024
+        The maximum number of cached features and schedules. 0 disables the cache.
+    """
+    _ffi_api.SetFeatureCacheCapacity(capacity)
+
+
+def clear_feature_cache():
+    """Drop all entries of the cache shared by feature extraction workers."""
+    _ffi_api.ClearFeatureCache()
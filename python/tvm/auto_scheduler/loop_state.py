@@ -135,6 +135,17 @@ class State:
         """
         return [stage.op for stage in self.stages]
 
+    def fingerprint(self):
+        """Get a structural fingerprint of the transform steps of this state.
+        Two states with the same transform steps have the same fingerprint.
+
+        Returns
+        -------
+        fingerprint : int
+            The 64-bit fingerprint.
+        """
+        return _ffi_api.StateFingerprint(self.state_object)
+
     def bind(self, stage, iterator, thread_name):
         """Schedule primitive corresponding to `te.Stage.bind`.
         See also the `te.Stage` for more details.
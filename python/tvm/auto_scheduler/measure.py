@@ -32,11 +32,13 @@ We implement these in python to utilize python's multiprocessing and error handl
 """
 
 import os
+import math
 import time
 import shutil
 import tempfile
 import multiprocessing
 import logging
+import threading
 
 import tvm._ffi
 from tvm.runtime import Object, module, ndarray
@@ -44,6 +46,7 @@ from tvm.driver import build_module
 from tvm.ir import transform
 from tvm.autotvm.measure.measure_methods import set_cuda_target_arch
 from tvm.contrib import tar, ndk
+from tvm.contrib.popen_pool import PopenPoolExecutor
 from tvm.target import Target
 
 
@@ -191,13 +194,22 @@ class MeasureResult(Object):
         The time cost of build and run.
     timestamp : float
         The time stamps of this measurement.
+    confidence_interval : float = 0.0
+        The half width of the 95% confidence interval of the mean cost.
+        0 if the runner does not estimate it. This is not saved in the record log.
     """
 
-    def __init__(self, costs, error_no, error_msg, all_cost, timestamp):
+    def __init__(self, costs, error_no, error_msg, all_cost, timestamp, confidence_interval=0.0):
         error_msg = error_msg if error_msg else ""
 
         self.__init_handle_by_constructor__(
-            _ffi_api.MeasureResult, costs, error_no, error_msg, all_cost, timestamp
+            _ffi_api.MeasureResult,
+            costs,
+            error_no,
+            error_msg,
+            all_cost,
+            timestamp,
+            confidence_interval,
         )
 
 
@@ -304,12 +316,30 @@ class ProgramMeasurer(Object):
         The Verbosity level: 0 for silent, 1 to output information during program
     max_continuous_error : Optional[int]
         The number of allowed maximum continuous error before stop the tuning
+    pipelined : bool = False
+        Whether to build the next batch while the current batch is being run.
+        Only one batch is run at a time. Use this with remote runners such as RPCRunner:
+        with LocalRunner, the builds run on the measured CPU and skew the measured costs.
     """
 
-    def __init__(self, builder, runner, callbacks, verbose, max_continuous_error=None):
+    def __init__(
+        self,
+        builder,
+        runner,
+        callbacks,
+        verbose,
+        max_continuous_error=None,
+        pipelined=False,
+    ):
         max_continuous_error = max_continuous_error or -1  # -1 means using the default value
         self.__init_handle_by_constructor__(
-            _ffi_api.ProgramMeasurer, builder, runner, callbacks, verbose, max_continuous_error
+            _ffi_api.ProgramMeasurer,
+            builder,
+            runner,
+            callbacks,
+            verbose,
+            max_continuous_error,
+            pipelined,
         )
 
 
@@ -328,9 +358,19 @@ class LocalBuilder(ProgramBuilder):
         If is 'default', use default build function
         If is 'ndk', use function for android ndk
         If is callable, use it as custom build function, expect lib_format field.
+    persistent_workers: bool = False
+        Whether to build in a pool of `n_parallel` worker processes that is kept alive across
+        batches, instead of starting a new process for every build.
+        A worker that times out or crashes is killed and restarted for the next build.
     """
 
-    def __init__(self, timeout=15, n_parallel=multiprocessing.cpu_count(), build_func="default"):
+    def __init__(
+        self,
+        timeout=15,
+        n_parallel=multiprocessing.cpu_count(),
+        build_func="default",
+        persistent_workers=False,
+    ):
         if build_func == "default":
             BuildFunc.name = "default"
             BuildFunc.build_func = tar.tar
@@ -344,7 +384,7 @@ class LocalBuilder(ProgramBuilder):
             raise ValueError("Invalid build_func" + build_func)
 
         self.__init_handle_by_constructor__(
-            _ffi_api.LocalBuilder, timeout, n_parallel, BuildFunc.name
+            _ffi_api.LocalBuilder, timeout, n_parallel, BuildFunc.name, persistent_workers
         )
 
 
@@ -381,6 +421,23 @@ class LocalRunner(ProgramRunner):
         its actual latency during end-to-end inference.
         To make this option effective, the argument `number` should also be set to 1.
         This is only has effect on CPU task.
+    adaptive : bool = False
+        Whether to adapt the number of repeats to the measurement noise.
+        Each candidate is measured for at least `repeat` (and at least 2) repeats. It stops early
+        once the lower bound of its 95% confidence interval is above the best mean cost measured
+        so far by this runner for the same workload. Otherwise it is repeated until the
+        confidence interval is narrower than `ci_tolerance` and does not overlap the best cost,
+        or until `max_repeat` repeats are done.
+        The half width of the confidence interval is reported in
+        `MeasureResult.confidence_interval`.
+    max_repeat : int = 10
+        The maximum number of repeats in adaptive mode.
+    ci_tolerance : float = 0.02
+        The relative half width of the confidence interval at which adaptive measurement stops.
+    persistent_workers : bool = False
+        Whether to run in a worker process that is kept alive across batches,
+        instead of starting a new process for every run.
+        The worker is killed and restarted after a timeout or a crash.
     """
 
     def __init__(
@@ -391,6 +448,10 @@ class LocalRunner(ProgramRunner):
         min_repeat_ms=100,
         cooldown_interval=0.0,
         enable_cpu_cache_flush=False,
+        adaptive=False,
+        max_repeat=10,
+        ci_tolerance=0.02,
+        persistent_workers=False,
     ):
         if enable_cpu_cache_flush:
             number = 1
@@ -404,6 +465,10 @@ class LocalRunner(ProgramRunner):
             min_repeat_ms,
             cooldown_interval,
             enable_cpu_cache_flush,
+            adaptive,
+            max(max_repeat, repeat),
+            ci_tolerance,
+            persistent_workers,
         )
 
 
@@ -599,6 +664,35 @@ class MeasureErrorNo(object):
     UNKNOWN_ERROR = 8  # Unknown error
 
 
+# The persistent worker pools of LocalBuilder and LocalRunner, keyed by their configuration
+_PERSISTENT_POOLS = {}
+_PERSISTENT_POOLS_LOCK = threading.Lock()
+
+
+def _call_func_in_persistent_pool(kind, n_workers, timeout, func, args=()):
+    """Same as `call_func_with_timeout`, but reuses a pool of persistent worker processes.
+
+    Returns the result of func, or the exception (e.g. TimeoutError) raised by it.
+    """
+    key = (kind, n_workers, timeout)
+    with _PERSISTENT_POOLS_LOCK:
+        if key not in _PERSISTENT_POOLS:
+            _PERSISTENT_POOLS[key] = PopenPoolExecutor(max_workers=n_workers, timeout=timeout)
+        pool = _PERSISTENT_POOLS[key]
+    # pylint: disable=broad-except
+    try:
+        return pool.submit(func, *args).result()
+    except Exception as exception:
+        return exception
+
+
+def shutdown_persistent_workers():
+    """Kill the worker processes started by LocalBuilder and LocalRunner
+    with `persistent_workers=True`. New workers are started on demand."""
+    with _PERSISTENT_POOLS_LOCK:
+        _PERSISTENT_POOLS.clear()
+
+
 def _timed_func(inp_serialized, build_func, verbose):
     tic = time.time()
     inp = MeasureInput.deserialize(inp_serialized)
@@ -658,13 +752,18 @@ def local_build_worker(args):
     res : BuildResult
         The build result of this Builder thread.
     """
-    inp, build_func, timeout, verbose = args
+    inp, build_func, timeout, verbose, n_parallel, persistent_workers = args
     assert build_func == BuildFunc.name, (
         "BuildFunc.name: " + BuildFunc.name + ", but args is: " + build_func
     )
     build_func = BuildFunc.build_func
 
-    res = call_func_with_timeout(timeout, _timed_func, args=(inp, build_func, verbose))
+    if persistent_workers:
+        res = _call_func_in_persistent_pool(
+            "build", n_parallel, timeout, _timed_func, args=(inp, build_func, verbose)
+        )
+    else:
+        res = call_func_with_timeout(timeout, _timed_func, args=(inp, build_func, verbose))
     if isinstance(res, TimeoutError):
         if verbose >= 1:
             print(".T", end="", flush=True)  # Build timeout
@@ -678,7 +777,9 @@ def local_build_worker(args):
 
 
 @tvm._ffi.register_func("auto_scheduler.local_builder.build")
-def local_builder_build(inputs, timeout, n_parallel, build_func="default", verbose=1):
+def local_builder_build(
+    inputs, timeout, n_parallel, build_func="default", verbose=1, persistent_workers=False
+):
     """
     Build function of LocalBuilder to build the MeasureInputs to runnable modules.
 
@@ -695,15 +796,37 @@ def local_builder_build(inputs, timeout, n_parallel, build_func="default", verbo
         The name of build function to process the built module.
     verbose: int = 1
         Verbosity level. 0 for silent, 1 to output information during program building.
+    persistent_workers: bool = False
+        Whether to build in a pool of worker processes that persists across calls.
 
     Returns
     -------
     res : List[BuildResult]
         The build results of these MeasureInputs.
     """
+    return local_builder_build_async(
+        inputs, timeout, n_parallel, build_func, verbose, persistent_workers
+    )()
+
+
+@tvm._ffi.register_func("auto_scheduler.local_builder.build_async")
+def local_builder_build_async(
+    inputs, timeout, n_parallel, build_func="default", verbose=1, persistent_workers=False
+):
+    """
+    Start building the MeasureInputs in the background, see `local_builder_build`.
+
+    The builds run in worker processes, driven by a thread pool, so they make progress
+    while the calling thread does other work, e.g. running the previous batch.
+
+    Returns
+    -------
+    wait : Callable[[], List[BuildResult]]
+        Waits for the builds and returns the build results of these MeasureInputs.
+    """
     # This pool is not doing computationally intensive work, so we can use threads
     pool = multiprocessing.pool.ThreadPool(n_parallel)
-    tuple_res = pool.map(
+    async_res = pool.map_async(
         local_build_worker,
         [
             (
@@ -711,19 +834,20 @@ def local_builder_build(inputs, timeout, n_parallel, build_func="default", verbo
                 build_func,
                 timeout,
                 verbose,
+                n_parallel,
+                persistent_workers,
             )
             for i in inputs
         ],
     )
-    pool.terminate()
-    pool.join()
-    del pool
 
-    results = []
-    for res in tuple_res:
-        results.append(BuildResult(*res))
+    def wait():
+        tuple_res = async_res.get()
+        pool.terminate()
+        pool.join()
+        return [BuildResult(*res) for res in tuple_res]
 
-    return results
+    return wait
 
 
 TASK_INPUT_CHECK_FUNC_REGISTRY = {}
@@ -817,6 +941,59 @@ def prepare_input_map(args):
     return tensor_input_map
 
 
+# Two-sided 95% quantiles of Student's t-distribution for 1 to 10 degrees of freedom
+_T_QUANTILES_95 = [12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228]
+
+
+def _confidence_interval(costs):
+    """Return the mean of costs and the half width of the 95% confidence interval of the mean."""
+    n = len(costs)
+    mean = sum(costs) / n
+    if n < 2:
+        return mean, float("inf")
+    dof = n - 1
+    var = sum((c - mean) ** 2 for c in costs) / dof
+    t = _T_QUANTILES_95[dof - 1] if dof <= len(_T_QUANTILES_95) else 1.96 + 2.4 / dof
+    return mean, t * math.sqrt(var / n)
+
+
+def _adaptive_time_eval(
+    func, dev, args, number, repeat, min_repeat_ms, f_prepare, max_repeat, ci_tolerance, best_cost
+):
+    """Measure one repeat at a time and stop as soon as the result is conclusive.
+
+    Returns the costs of all repeats and the half width of the confidence interval.
+    """
+    time_f = func.time_evaluator(
+        func.entry_name,
+        dev,
+        number=number,
+        repeat=1,
+        min_repeat_ms=min_repeat_ms,
+        f_preproc=f_prepare,
+    )
+    costs = list(time_f(*args).results)
+    if min_repeat_ms > 0:
+        # Keep the `number` found by the first repeat, so later repeats skip the calibration
+        number = max(number, int(math.ceil(min_repeat_ms / 1000.0 / max(costs[0], 1e-9))))
+        time_f = func.time_evaluator(func.entry_name, dev, number=number, f_preproc=f_prepare)
+
+    min_repeat = max(repeat, 2)
+    while True:
+        mean, half = _confidence_interval(costs)
+        if len(costs) >= max_repeat:
+            break
+        if len(costs) >= min_repeat:
+            if 0 < best_cost < mean - half:
+                # Statistically slower than the best candidate
+                break
+            close_to_best = 0 < best_cost and mean - half <= best_cost <= mean + half
+            if half <= ci_tolerance * mean and not close_to_best:
+                break
+        costs.extend(time_f(*args).results)
+    return costs, (half if math.isfinite(half) else 0.0)
+
+
 def _timed_eval_func(
     inp_serialized,
     build_res,
@@ -826,6 +1003,8 @@ def _timed_eval_func(
     cooldown_interval,
     enable_cpu_cache_flush,
     verbose,
+    adaptive=None,
+    task_input_buffers=None,
 ):
     # pylint: disable=import-outside-toplevel
     from .search_task import get_task_input_buffer  # lazily import to avoid recursive dependency
@@ -835,6 +1014,7 @@ def _timed_eval_func(
     tic = time.time()
     error_no = 0
     error_msg = None
+    confidence_interval = 0.0
     try:
         func = module.load_module(build_res.filename)
         dev = ndarray.device(str(inp.task.target), 0)
@@ -870,11 +1050,12 @@ def _timed_eval_func(
                 if arg in tensor_input_map:
                     tensor_name = tensor_input_map[arg]
                     if tensor_name in task_input_names:
-                        args.append(
-                            ndarray.array(
-                                get_task_input_buffer(inp.task.workload_key, tensor_name), dev
-                            )
-                        )
+                        if task_input_buffers is not None:
+                            # The buffers registered in the parent process are passed explicitly
+                            buffer = task_input_buffers[tensor_name]
+                        else:
+                            buffer = get_task_input_buffer(inp.task.workload_key, tensor_name)
+                        args.append(ndarray.array(buffer, dev))
                         task_inputs_count += 1
                     else:
                         raise ValueError(
@@ -890,7 +1071,22 @@ def _timed_eval_func(
                     "task_inputs not fully matched, check if there's any unexpected error"
                 )
             dev.sync()
-            costs = time_f(*args).results
+            if adaptive is not None:
+                max_repeat, ci_tolerance, best_cost = adaptive
+                costs, confidence_interval = _adaptive_time_eval(
+                    func,
+                    dev,
+                    args,
+                    number,
+                    repeat,
+                    min_repeat_ms,
+                    f_prepare,
+                    max_repeat,
+                    ci_tolerance,
+                    best_cost,
+                )
+            else:
+                costs = time_f(*args).results
         # pylint: disable=broad-except
         except Exception:
             costs = (MAX_FLOAT,)
@@ -906,7 +1102,7 @@ def _timed_eval_func(
             print("*", end="", flush=True)
         else:
             print("*E", end="", flush=True)  # Run error
-    return costs, error_no, error_msg, toc - tic + build_res.time_cost, toc
+    return costs, error_no, error_msg, toc - tic + build_res.time_cost, toc, confidence_interval
 
 
 @tvm._ffi.register_func("auto_scheduler.local_runner.run")
@@ -920,6 +1116,11 @@ def local_run(
     cooldown_interval=0,
     enable_cpu_cache_flush=False,
     verbose=1,
+    adaptive=False,
+    max_repeat=10,
+    ci_tolerance=0.02,
+    best_costs=None,
+    persistent_workers=False,
 ):
     """
     Run function of LocalRunner to test the performance of the input BuildResults.
@@ -959,6 +1160,17 @@ def local_run(
         This is only has effect on CPU task.
     verbose: int = 1
         Verbosity level. 0 for silent, 1 to output information during program measuring.
+    adaptive: bool = False
+        Whether to adapt the number of repeats to the measurement noise. See `LocalRunner`.
+    max_repeat: int = 10
+        The maximum number of repeats in adaptive mode.
+    ci_tolerance: float = 0.02
+        The relative half width of the confidence interval at which adaptive measurement stops.
+    best_costs: Optional[List[float]]
+        The best known mean cost of the workload of each input, or a non-positive value
+        if unknown. Only used in adaptive mode.
+    persistent_workers: bool = False
+        Whether to run in a worker process that persists across calls.
 
     Returns
     -------
@@ -966,9 +1178,21 @@ def local_run(
         The measure results of these MeasureInputs.
     """
 
+    # pylint: disable=import-outside-toplevel
+    from .search_task import get_task_input_buffer  # lazily import to avoid recursive dependency
+
     measure_results = []
     assert len(inputs) == len(build_results), "Measure input size should be equal to build results"
-    for inp, build_res in zip(inputs, build_results):
+    # The best cost found in this batch also counts, per workload
+    batch_best = {}
+    for idx, (inp, build_res) in enumerate(zip(inputs, build_results)):
+        adaptive_args = None
+        if adaptive:
+            key = inp.task.workload_key
+            best_cost = best_costs[idx].value if best_costs else -1.0
+            if key in batch_best and (best_cost <= 0 or batch_best[key] < best_cost):
+                best_cost = batch_best[key]
+            adaptive_args = (max_repeat, ci_tolerance, best_cost)
         if build_res.error_no != 0:
             res = (
                 (MAX_FLOAT,),
@@ -978,21 +1202,30 @@ def local_run(
                 time.time(),
             )
         else:
-            res = call_func_with_timeout(
-                timeout,
-                _timed_eval_func,
-                args=(
-                    inp.serialize(),
-                    build_res,
-                    number,
-                    repeat,
-                    min_repeat_ms,
-                    cooldown_interval,
-                    enable_cpu_cache_flush,
-                    verbose,
-                ),
-                add_thread_wrapper=True,
+            eval_args = (
+                inp.serialize(),
+                build_res,
+                number,
+                repeat,
+                min_repeat_ms,
+                cooldown_interval,
+                enable_cpu_cache_flush,
+                verbose,
+                adaptive_args,
             )
+            if persistent_workers:
+                # The worker does not share the task input buffers registered in this process
+                task_input_buffers = {
+                    name: get_task_input_buffer(inp.task.workload_key, name).numpy()
+                    for name in inp.task.task_input_names
+                }
+                res = _call_func_in_persistent_pool(
+                    "run", 1, timeout, _timed_eval_func, args=eval_args + (task_input_buffers,)
+                )
+            else:
+                res = call_func_with_timeout(
+                    timeout, _timed_eval_func, args=eval_args, add_thread_wrapper=True
+                )
             if isinstance(res, TimeoutError):
                 if verbose >= 1:
                     print("*T", end="", flush=True)  # Run timeout
@@ -1014,6 +1247,10 @@ def local_run(
                     time.time(),
                 )
 
+        if adaptive and res[1] == MeasureErrorNo.NO_ERROR:
+            mean = sum(res[0]) / len(res[0])
+            key = inp.task.workload_key
+            batch_best[key] = min(batch_best.get(key, mean), mean)
         measure_results.append(MeasureResult(*res))
 
     if verbose >= 1:
@@ -134,6 +134,132 @@ class RecordReader(Object):
             yield ret[0], ret[1]  # (input, result)
 
 
+@tvm._ffi.register_object("auto_scheduler.RecordStore")
+class RecordStore(Object):
+    """
+    An append-only binary store of measurement records, indexed by workload key and target.
+
+    The best record of a (workload key, target) pair is found through the index without
+    decoding the other records. :any:`RecordReader`, :any:`load_records` and
+    :any:`load_best_record` accept record stores as well as json log files.
+
+    Parameters
+    ----------
+    filename : str
+        File name of the store. It is created if it does not exist.
+    """
+
+    def __init__(self, filename):
+        dirname = os.path.dirname(os.path.abspath(filename))
+        if not os.path.exists(dirname):
+            os.makedirs(dirname)
+        self.__init_handle_by_constructor__(_ffi_api.RecordStore, filename)
+
+    def append(self, inputs, results):
+        """Append measurement records to the store.
+
+        Parameters
+        ----------
+        inputs: List[MeasureInputs]
+            The MeasureInputs to be written.
+        results: List[MeasureResults]
+            The MeasureResults to be written.
+        """
+        _ffi_api.RecordStoreAppend(self, inputs, results)
+
+    def best(self, workload_key, target):
+        """Return the best valid record of a workload on a target.
+
+        Parameters
+        ----------
+        workload_key : str
+            The workload key of the compute declaration.
+        target : Union[str, tvm.target.Target]
+            The target device.
+
+        Returns
+        -------
+        input : Optional[auto_scheduler.measure.MeasureInput]
+            The best MeasureInput, None if there is no valid record.
+        result : Optional[auto_scheduler.measure.MeasureResult]
+            The best MeasureResult, None if there is no valid record.
+        """
+        ret = _ffi_api.RecordStoreReadBest(self, workload_key, str(target))
+        if not ret:
+            return None, None
+        return ret[0], ret[1]
+
+    def best_records(self):
+        """Return the best valid record of every (workload key, target) pair.
+
+        Returns
+        -------
+        logs : List[auto_scheduler.measure.MeasureInput, auto_scheduler.measure.MeasureResult]
+        """
+        inputs, results = _ffi_api.RecordStoreReadBestRecords(self)
+        return list(zip(inputs, results))
+
+    def __len__(self):
+        return _ffi_api.RecordStoreNumRecords(self)
+
+    def __iter__(self):
+        return iter(RecordReader(self.filename))
+
+
+@tvm._ffi.register_object("auto_scheduler.RecordToStore")
+class RecordToStore(MeasureCallback):
+    """
+    A measurement callback that appends measurement records to a binary record store.
+
+    Parameters
+    ----------
+    filename : str
+        File name of the store for this callback to write to.
+    """
+
+    def __init__(self, filename):
+        dirname = os.path.dirname(os.path.abspath(filename))
+        if not os.path.exists(dirname):
+            os.makedirs(dirname)
+        self.__init_handle_by_constructor__(_ffi_api.RecordToStore, filename)
+
+
+def is_record_store(filename):
+    """Check whether a file is a binary record store.
+
+    Parameters
+    ----------
+    filename : str
+        The name of the file.
+
+    Returns
+    -------
+    ret : bool
+    """
+    return os.path.isfile(filename) and bool(_ffi_api.IsRecordStore(filename))
+
+
+def convert_records_to_store(log_file, store_file):
+    """Convert a json log file to a binary record store.
+
+    Parameters
+    ----------
+    log_file : str
+        The name of the json log file.
+    store_file : str
+        The name of the record store. Records are appended if it already exists.
+
+    Returns
+    -------
+    count : int
+        The number of converted records.
+    """
+    dirname = os.path.dirname(os.path.abspath(store_file))
+    if not os.path.exists(dirname):
+        os.makedirs(dirname)
+    return _ffi_api.ConvertRecordsToStore(log_file, store_file)
+
+
 def load_record_from_string(record):
     """
     Load the measure record from string.
@@ -237,7 +363,13 @@ def load_best_record(filename, workload_key=None, target=None, include_compatibl
     result : auto_scheduler.measure.MeasureResult
         The best State's MeasureResult from this log fine.
     """
-    log_reader = RecordReader(filename)
+    if is_record_store(filename):
+        # The best record of the query is the best of the per-key best records. They are
+        # filtered below like the records of a log file, so the target only has to match by
+        # kind, as it does for log files.
+        log_reader = RecordStore(filename).best_records()
+    else:
+        log_reader = RecordReader(filename)
     best_cost = 1e30
     best_inp = None
     best_res = None
@@ -344,7 +476,7 @@ def distill_record_file(in_file, out_file):
 def main():
     """The main function for CLI."""
     parser = argparse.ArgumentParser()
-    parser.add_argument("--mode", choices=["distill"], default="distill")
+    parser.add_argument("--mode", choices=["distill", "convert"], default="distill")
     parser.add_argument("-i", "--input", type=str, help="input file")
     parser.add_argument("-o", "--output", type=str, default=None, help="output file")
 
@@ -355,12 +487,18 @@ def main():
     if args.mode == "distill":
         args.output = args.output or args.input + ".best.json"
         distill_record_file(args.input, args.output)
+    elif args.mode == "convert":
+        args.output = args.output or args.input + ".bin"
+        count = convert_records_to_store(args.input, args.output)
+        logger.info("Convert %d records from %s to %s", count, args.input, args.output)
 
 
 """
 Usage:
 * Distill the best entries from a large log file
 e.g. python -m tvm.auto_scheduler.measure_record --mode distill -i input.json
+* Convert a json log file to a binary record store
+e.g. python -m tvm.auto_scheduler.measure_record --mode convert -i input.json -o input.bin
 """
 if __name__ == "__main__":
     main()
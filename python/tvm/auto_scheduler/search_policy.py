@@ -61,6 +61,29 @@ class PreloadMeasuredStates(SearchCallback):
         self.__init_handle_by_constructor__(_ffi_api.PreloadMeasuredStates, filename)
 
 
+@tvm._ffi.register_object("auto_scheduler.PreloadTransferStates")
+class PreloadTransferStates(SearchCallback):
+    """A SearchCallback to warm start a search policy with the records of other tasks.
+
+    The best records of other workloads of the same compute function (or the same compute DAG
+    for tasks extracted from a network) in the log file are replayed on the current task.
+    Records whose steps do not fit the structure of the current task are dropped, and the
+    split factors of the remaining ones are adapted to the new axis extents.
+    SketchPolicy measures the transferred states in its first round and then uses them as
+    starting points of the evolutionary search.
+
+    Parameters
+    ----------
+    filename : str
+        The name of the record file.
+    max_states : int = 16
+        The maximum number of states to transfer.
+    """
+
+    def __init__(self, filename, max_states=16):
+        self.__init_handle_by_constructor__(_ffi_api.PreloadTransferStates, filename, max_states)
+
+
 @tvm._ffi.register_object("auto_scheduler.PreloadCustomSketchRule")
 class PreloadCustomSketchRule(SearchCallback):
     """
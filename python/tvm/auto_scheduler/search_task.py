@@ -167,6 +167,10 @@ class TuningOptions(Object):
         Callback functions called after each measurement.
         Candidates:
         - auto_scheduler.RecordToFile
+    pipelined_measurement: bool = False
+        Whether to overlap building the next batch of programs with running the current one.
+        Only use this with a remote runner such as RPCRunner. With LocalRunner the builds
+        compete with the measured programs for the CPU, which skews the measured costs.
     """
 
     def __init__(
@@ -178,6 +182,7 @@ class TuningOptions(Object):
         builder="local",
         runner="local",
         measure_callbacks=None,
+        pipelined_measurement=False,
     ):
         if isinstance(builder, str):
             if builder == "local":
@@ -210,6 +215,7 @@ class TuningOptions(Object):
             builder,
             runner,
             measure_callbacks,
+            pipelined_measurement,
         )
 
 
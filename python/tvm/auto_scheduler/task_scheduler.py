@@ -29,7 +29,15 @@ import logging
 
 import numpy as np
 
-from .search_policy import SearchPolicy, SketchPolicy, PreloadMeasuredStates
+import tvm._ffi
+from tvm.runtime import Object
+
+from .search_policy import (
+    SearchPolicy,
+    SketchPolicy,
+    PreloadMeasuredStates,
+    PreloadTransferStates,
+)
 from .cost_model import RandomModel, XGBModel
 from .utils import array_mean
 from .measure import ProgramMeasurer
@@ -48,6 +56,7 @@ def make_search_policies(
     load_model_file=None,
     load_log_file=None,
     adapative_training=False,
+    transfer_log_file=None,
 ):
     """Make a list of search policies for a list of search tasks.
     It creates one policy per task.
@@ -74,6 +83,9 @@ def make_search_policies(
     adapative_training: bool = False
         Option used by XGBModel to reduce the model training frequency when there're too
         many logs.
+    transfer_log_file: Optional[str]
+        Warm start each search policy with the best states of structurally similar tasks
+        found in this file. See `PreloadTransferStates`.
 
     Returns
     -------
@@ -103,11 +115,14 @@ def make_search_policies(
             raise ValueError("Invalid search policy: " + search_policy)
 
         if policy_type == "sketch":
+            init_search_callbacks = []
             if load_log_file:
                 # use the log file to restore the status of search policies.
-                init_search_callbacks = [PreloadMeasuredStates(load_log_file)]
-            else:
-                init_search_callbacks = None
+                init_search_callbacks.append(PreloadMeasuredStates(load_log_file))
+            if transfer_log_file:
+                # use the records of similar tasks to warm start the search policies.
+                init_search_callbacks.append(PreloadTransferStates(transfer_log_file))
+            init_search_callbacks = init_search_callbacks or None
             search_policies = [
                 SketchPolicy(
                     task,
@@ -191,6 +206,9 @@ class TaskScheduler:
     load_log_file: Optional[str]
         Load measurement records from this file. If it is not None, the status of the
         task scheduler, search policies and cost models will be restored according to this file.
+    transfer_log_file: Optional[str]
+        Warm start the search of each task with the best states of structurally similar tasks
+        (e.g. the same operator with different shapes) found in this file.
     verbose: int = 1
         The level of verbosity. 0 means silent.
     alpha: float = 0.2
@@ -202,6 +220,9 @@ class TaskScheduler:
     callbacks: Optional[List[TaskSchedulerCallback]]
         The task scheduler callbacks that will be called before and after tuning a task.
         If None, PrintTableInfo and LogEstimatedLatency callback will be used.
+    native: bool = False
+        Run the tuning loop in the native NativeTaskScheduler, which records every scheduling
+        decision (see `decisions`). Only the weighted-sum objective is supported.
     """
 
     def __init__(
@@ -217,8 +238,15 @@ class TaskScheduler:
         gamma: float = 0.5,
         backward_window_size: int = 3,
         callbacks=None,
+        transfer_log_file: str = None,
+        native: bool = False,
     ):
         self.tasks = tasks
+        self.task_weights = task_weights
+        self.native = native
+        self.native_scheduler = None
+        if native and objective_func:
+            raise ValueError("The native task scheduler only supports the weighted-sum objective")
         if objective_func:  # use custom objective function
             self.objective_func = objective_func
         else:  # use weighted sum
@@ -230,6 +258,7 @@ class TaskScheduler:
         self.strategy = strategy
         self.load_log_file = load_log_file
         self.load_model_file = load_model_file
+        self.transfer_log_file = transfer_log_file
         self.alpha = alpha
         self.beta = beta
         self.gamma = gamma
@@ -320,6 +349,7 @@ class TaskScheduler:
             tune_option.runner,
             tune_option.measure_callbacks,
             tune_option.verbose,
+            pipelined=tune_option.pipelined_measurement,
         )
         self.ct = self.best_ct = 0
         self.tic = time.time()
@@ -348,8 +378,13 @@ class TaskScheduler:
             self.load_model_file,
             self.load_log_file,
             adapative_training,
+            self.transfer_log_file,
         )
 
+        if self.native:
+            self._tune_native(tune_option, per_task_early_stopping)
+            return
+
         # do a round robin first to warm up
         for idx in range(len(self.tasks)):
             # skip warming up this task if it has been tuned before (restored from the log file)
@@ -442,6 +477,72 @@ class TaskScheduler:
                     )
                 break
 
+    def _tune_native(self, tune_option, per_task_early_stopping):
+        """Run the tuning loop in the native task scheduler"""
+        self.native_scheduler = NativeTaskScheduler(
+            self.tasks,
+            self.task_weights,
+            self.task_tags,
+            self.strategy,
+            self.alpha,
+            self.beta,
+            self.backward_window_size,
+        )
+        if self.load_log_file:
+            _ffi_api.TaskSchedulerSetStatus(
+                self.native_scheduler,
+                self.task_cts,
+                self.task_best_cts,
+                [float(cost) for cost in self.best_costs],
+                sorted(self.dead_tasks),
+                self.ct,
+            )
+
+        def round_callback(task_idx, is_post_tune):
+            self._sync_native_status()
+            for callback in self.callbacks:
+                if is_post_tune:
+                    callback.post_tune(self, task_idx)
+                else:
+                    callback.pre_tune(self, task_idx)
+
+        _ffi_api.TaskSchedulerTune(
+            self.native_scheduler,
+            self.search_policies,
+            self.measurer,
+            tune_option.num_measure_trials,
+            self.num_measures_per_round,
+            tune_option.early_stopping,
+            -1 if per_task_early_stopping is None else per_task_early_stopping,
+            round_callback,
+        )
+        self._sync_native_status()
+
+    def _sync_native_status(self):
+        """Copy the tuning status from the native task scheduler"""
+        task_cts, task_best_cts, best_costs, dead_tasks, ct = _ffi_api.TaskSchedulerGetStatus(
+            self.native_scheduler
+        )
+        self.task_cts = [int(x) for x in task_cts]
+        self.task_best_cts = [int(x) for x in task_best_cts]
+        self.best_costs = np.array([x.value for x in best_costs])
+        self.dead_tasks = set(int(x) for x in dead_tasks)
+        self.ct = int(ct)
+        self.cur_score = self._compute_score(self.best_costs)
+
+    @property
+    def decisions(self):
+        """The decisions made by the native task scheduler.
+
+        Returns
+        -------
+        decisions : List[TaskSchedulerDecision]
+            One decision per tuning round, with the chosen task, the reason and the gradients.
+        """
+        if self.native_scheduler is None:
+            return []
+        return list(self.native_scheduler.decisions)
+
     def _tune_task(self, task_idx):
         """Tune the select task for one round"""
 
@@ -539,6 +640,75 @@ class TaskScheduler:
         logger.info("TaskScheduler: Loaded %d measurement records from %s", total_ct + 1, log_file)
 
 
+@tvm._ffi.register_object("auto_scheduler.TaskSchedulerDecision")
+class TaskSchedulerDecision(Object):
+    """The record of one decision of the native task scheduler.
+
+    Attributes
+    ----------
+    round : int
+        The index of the tuning round.
+    task_idx : int
+        The index of the chosen task.
+    reason : str
+        "warmup", "round-robin", "gradient" or "random" (all gradients were equal).
+    gradients : List[float]
+        The gradient of every task. Empty for decisions not made by gradients.
+    score : float
+        The weighted latency of all tasks before this round.
+    num_trials : int
+        The number of measurement trials done before this round.
+    remaining_trials : int
+        The number of measurement trials left in the budget.
+    """
+
+    def __repr__(self):
+        return "TaskSchedulerDecision(round=%d, task_idx=%d, reason=%s, trials=%d/%d)" % (
+            self.round,
+            self.task_idx,
+            self.reason,
+            self.num_trials,
+            self.num_trials + self.remaining_trials,
+        )
+
+
+@tvm._ffi.register_object("auto_scheduler.TaskScheduler")
+class NativeTaskScheduler(Object):
+    """The native task scheduler. It is created by `TaskScheduler(..., native=True)`.
+
+    Parameters
+    ----------
+    tasks : List[SearchTask]
+        The tasks to tune.
+    task_weights : Optional[List[float]]
+        The weight of each task in the end-to-end latency.
+    task_tags : Optional[List[str]]
+        The similarity tag of each task, see `derive_similarity_tag`.
+    strategy : str
+        The scheduling strategy, "gradient" or "round-robin".
+    alpha : float
+        The weight of the backward gradient against the forward gradient.
+    beta : float
+        The slowdown to consider a task as dissimilar to its group.
+    backward_window_size : int
+        The number of rounds used to compute the backward gradient.
+    """
+
+    def __init__(
+        self, tasks, task_weights, task_tags, strategy, alpha, beta, backward_window_size
+    ):
+        self.__init_handle_by_constructor__(
+            _ffi_api.TaskScheduler,
+            tasks,
+            [float(w) for w in task_weights] if task_weights else [],
+            [tag or "" for tag in task_tags] if task_tags else [],
+            strategy,
+            alpha,
+            beta,
+            backward_window_size,
+        )
+
+
 class TaskSchedulerCallback:
     """The base class of task scheduler callback functions."""
 
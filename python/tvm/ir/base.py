@@ -157,6 +157,45 @@ def save_json(node):
     return tvm.runtime._ffi_node_api.SaveJSON(node)
 
 
+def load_binary(blob):
+    """Load tvm object from a blob created by :py:func:`save_binary`.
+
+    The blob must have been saved by the same TVM version, use
+    :py:func:`save_json` to move objects across versions.
+
+    Parameters
+    ----------
+    blob : bytearray
+        The binary blob.
+
+    Returns
+    -------
+    node : Object
+        The loaded tvm node.
+    """
+    return tvm.runtime._ffi_node_api.LoadBinary(blob)
+
+
+def save_binary(node):
+    """Save tvm object in the compact binary format.
+
+    Unlike :py:func:`save_json`, NDArrays embedded in the object are
+    stored as raw aligned bytes, which makes the format much faster to
+    save and load for modules with large constants.
+
+    Parameters
+    ----------
+    node : Object
+        A TVM object to be saved.
+
+    Returns
+    -------
+    blob : bytearray
+        Saved binary blob.
+    """
+    return tvm.runtime._ffi_node_api.SaveBinary(node)
+
+
 def structural_equal(lhs, rhs, map_free_vars=False):
     """Check structural equality of lhs and rhs.
 
@@ -16,7 +16,10 @@
 # under the License.
 # pylint: disable=invalid-name,unused-argument
 """Common pass instrumentation across IR variants."""
+import csv
 import inspect
+import io
+import json
 import functools
 
 import tvm._ffi
@@ -139,12 +142,59 @@ def pass_instrument(pi_cls=None):
     return create_pass_instrument
 
 
+@tvm._ffi.register_object("instrument.PassProfile")
+class PassProfile(tvm.runtime.Object):
+    """Profiling result of a single pass invocation.
+
+    Attributes
+    ----------
+    name : str
+        The name of the pass.
+    duration_us : float
+        The wall time of the pass including its sub-passes, in microseconds.
+    self_duration_us : float
+        The wall time of the pass excluding its sub-passes, in microseconds.
+    memory_delta_bytes : int
+        The change of resident memory during the pass, 0 if not tracked.
+    ir_size_before : int
+        The number of IR nodes before the pass, -1 if not tracked.
+    ir_size_after : int
+        The number of IR nodes after the pass, -1 if not tracked.
+    children : List[PassProfile]
+        The profiles of the sub-passes.
+    """
+
+    def to_dict(self):
+        """Convert the profile tree to nested python dicts."""
+        return {
+            "name": self.name,
+            "duration_us": self.duration_us,
+            "self_duration_us": self.self_duration_us,
+            "memory_delta_bytes": self.memory_delta_bytes,
+            "ir_size_before": self.ir_size_before,
+            "ir_size_after": self.ir_size_after,
+            "children": [child.to_dict() for child in self.children],
+        }
+
+
 @tvm._ffi.register_object("instrument.PassInstrument")
 class PassTimingInstrument(tvm.runtime.Object):
-    """A wrapper to create a passes time instrument that implemented in C++"""
+    """A wrapper to create a passes time instrument that implemented in C++
 
-    def __init__(self):
-        self.__init_handle_by_constructor__(_ffi_instrument_api.MakePassTimingInstrument)
+    Parameters
+    ----------
+    track_memory : bool
+        Whether to record the change of resident memory of each pass.
+
+    track_ir_size : bool
+        Whether to count the IR nodes of the module before and after each pass.
+        Counting is done outside of the timed region of the pass itself.
+    """
+
+    def __init__(self, track_memory=False, track_ir_size=False):
+        self.__init_handle_by_constructor__(
+            _ffi_instrument_api.MakePassTimingInstrument, track_memory, track_ir_size
+        )
 
     @staticmethod
     def render():
@@ -167,3 +217,96 @@ class PassTimingInstrument(tvm.runtime.Object):
                 profiles = timing_inst.render()
         """
         return _ffi_instrument_api.RenderTimePassProfiles()
+
+    @staticmethod
+    def get_profiles():
+        """Retrieve the structured profile of the top level passes run so far.
+
+        Like :py:func:`render`, it must be called before exiting the PassContext.
+
+        Returns
+        -------
+        profiles : List[PassProfile]
+            The profile trees of the top level passes, in invocation order.
+        """
+        return list(_ffi_instrument_api.GetPassProfiles())
+
+    @staticmethod
+    def aggregate():
+        """Aggregate the profiles by pass name across all nesting levels,
+        e.g. an InferType invoked by many Sequential passes is reported once.
+
+        The duration and memory delta of a pass include its children. They are
+        only summed for the invocations that are not nested under a pass of the
+        same name, so that a pass invoking itself is not counted twice.
+
+        Returns
+        -------
+        summary : Dict[str, Dict[str, float]]
+            For each pass name, the number of invocations and the summed
+            duration, self duration and memory delta.
+        """
+        summary = {}
+
+        def visit(profile, ancestors):
+            entry = summary.setdefault(
+                profile.name,
+                {"count": 0, "duration_us": 0.0, "self_duration_us": 0.0, "memory_delta_bytes": 0},
+            )
+            entry["count"] += 1
+            entry["self_duration_us"] += profile.self_duration_us
+            if profile.name not in ancestors:
+                entry["duration_us"] += profile.duration_us
+                entry["memory_delta_bytes"] += profile.memory_delta_bytes
+            ancestors = ancestors | {profile.name}
+            for child in profile.children:
+                visit(child, ancestors)
+
+        for profile in PassTimingInstrument.get_profiles():
+            visit(profile, frozenset())
+        return summary
+
+    @staticmethod
+    def to_json():
+        """Export the profile trees as a json string."""
+        return json.dumps([p.to_dict() for p in PassTimingInstrument.get_profiles()])
+
+    @staticmethod
+    def to_csv():
+        """Export the profiles as csv, one row per pass invocation.
+        The `path` column holds the names of the enclosing passes separated by '/'.
+        """
+        fields = [
+            "path",
+            "name",
+            "depth",
+            "duration_us",
+            "self_duration_us",
+            "memory_delta_bytes",
+            "ir_size_before",
+            "ir_size_after",
+        ]
+        out = io.StringIO()
+        writer = csv.writer(out)
+        writer.writerow(fields)
+
+        def visit(profile, parents):
+            path = "/".join(parents + [profile.name])
+            writer.writerow(
+                [
+                    path,
+                    profile.name,
+                    len(parents),
+                    profile.duration_us,
+                    profile.self_duration_us,
+                    profile.memory_delta_bytes,
+                    profile.ir_size_before,
+                    profile.ir_size_after,
+                ]
+            )
+            for child in profile.children:
+                visit(child, parents + [profile.name])
+
+        for profile in PassTimingInstrument.get_profiles():
+            visit(profile, [])
+        return out.getvalue()
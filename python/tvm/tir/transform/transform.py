@@ -74,6 +74,54 @@ def InjectPrefetch():
     return _ffi_api.InjectPrefetch()  # type: ignore
 
 
+def AutoPrefetch():
+    """Insert prefetches for the strided and indirect loads of innermost loops on CPU.
+
+    The pass works on flattened TIR and is configured by the "tir.AutoPrefetch" option
+    of the PassContext, e.g. ``{"tir.AutoPrefetch": {"enable": True, "distance": 8}}``.
+    It does nothing unless enabled.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.AutoPrefetch()  # type: ignore
+
+
+def AutoCacheTiling():
+    """Tile and interchange the perfectly nested affine loop nests on CPU so that
+    the data touched by a tile fits in the L1 cache.
+
+    The pass is configured by the "tir.AutoCacheTiling" option of the PassContext,
+    e.g. ``{"tir.AutoCacheTiling": {"enable": True}}``. It does nothing unless enabled.
+    The cache size defaults to the "l1-cache-size" attribute of the target.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.AutoCacheTiling()  # type: ignore
+
+
+def SpecializeShapes():
+    """Make specialized variants of the dynamic shape functions for their frequent
+    shapes, and dispatch to them at run time by comparing the shape vars.
+
+    The pass is configured by the "tir.SpecializeShapes" option of the PassContext,
+    e.g. ``{"tir.SpecializeShapes": {"shapes": [{"n": 128}, {"n": 1024, "m": 64}]}}``,
+    where each shape maps the names of the shape vars of the buffer arguments to
+    their values. It does nothing unless shapes are given.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.SpecializeShapes()  # type: ignore
+
+
 def StorageFlatten(cache_line_size, create_bound_attribute: bool = False):
     """Flatten the multi-dimensional read/write to 1D.
 
@@ -161,6 +209,13 @@ def VectorizeLoop(enable_vectorize: bool = True):
         Whether vectorization is enabled.
         Will lower to scalar loop when it is turned off.
 
+    Note
+    ----
+    By default a statement guarded by a condition that varies across the lanes is
+    scalarized. When the "tir.enable_vectorize_predication" option of the PassContext
+    is set, it is kept vectorized with its loads and stores predicated by the condition
+    instead. Only the LLVM backend supports predicated loads and stores.
+
     Returns
     -------
     fpass : tvm.transform.Pass
@@ -334,6 +389,11 @@ def LowerCustomDatatypes():
 def MakePackedAPI(num_unpacked_params: int = 0):
     """Transform the PrimFuncs in the module to a packed func API.
 
+    When the "tir.emit_trusted_entry" option of the PassContext is set, each function
+    also gets a trusted entry named with the "__trusted" suffix, which skips the
+    checks of the arguments. It is only safe to call when the caller has verified
+    the argument types, shapes and strides, e.g. the graph executor.
+
     Parameters
     ----------
     num_unpacked_params : int
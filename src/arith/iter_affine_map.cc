@@ -1081,10 +1081,32 @@ PrimExpr NormalizeIterMapToExpr(const IterMapExpr& expr) {
   return normalizer.Convert(expr);
 }
 
+Array<PrimExpr> IterMapSimplify(const Array<PrimExpr>& indices, const Map<Var, Range>& input_iters,
+                                const PrimExpr& input_pred, bool require_bijective) {
+  Analyzer analyzer;
+  Array<IterSumExpr> rewrite =
+      DetectIterMap(indices, input_iters, input_pred, require_bijective, &analyzer);
+  if (rewrite.empty()) {
+    return indices;
+  }
+  Array<PrimExpr> result;
+  result.reserve(rewrite.size());
+  for (const IterSumExpr& expr : rewrite) {
+    result.push_back(NormalizeIterMapToExpr(expr));
+  }
+  return result;
+}
+
 TVM_REGISTER_GLOBAL("arith.NormalizeIterMapToExpr").set_body_typed([](const IterMapExpr& expr) {
   return NormalizeIterMapToExpr(expr);
 });
 
+TVM_REGISTER_GLOBAL("arith.IterMapSimplify")
+    .set_body_typed([](const Array<PrimExpr>& indices, const Map<Var, Range>& input_iters,
+                       const PrimExpr& input_pred, bool require_bijective) {
+      return IterMapSimplify(indices, input_iters, input_pred, require_bijective);
+    });
+
 /*!
  * \brief Divider to divide the bindings into two sets of bindings(outer and inner)
  *   such that binding_i = Y_i * E(Xi) + Xi, where E(X) is the extent of X.
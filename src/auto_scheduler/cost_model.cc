@@ -23,6 +23,15 @@
  */
 
 #include <tvm/auto_scheduler/cost_model.h>
+#include <tvm/auto_scheduler/feature.h>
+#include <tvm/support/parallel_for.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <utility>
 
 namespace tvm {
 namespace auto_scheduler {
@@ -30,6 +39,7 @@ namespace auto_scheduler {
 TVM_REGISTER_OBJECT_TYPE(CostModelNode);
 TVM_REGISTER_OBJECT_TYPE(RandomModelNode);
 TVM_REGISTER_OBJECT_TYPE(PythonBasedModelNode);
+TVM_REGISTER_OBJECT_TYPE(GBDTModelNode);
 
 RandomModel::RandomModel() {
   ObjectPtr<RandomModelNode> node = make_object<RandomModelNode>();
@@ -145,6 +155,376 @@ void PythonBasedModelNode::PredictStages(const SearchTask& task, const Array<Sta
   }
 }
 
+GBDTModel::GBDTModel(int max_depth, double eta, double reg_lambda, double gamma,
+                     double min_child_weight, int num_rounds, int early_stopping_rounds,
+                     int max_bins, int num_warmup_sample, int max_n_bufs, int seed) {
+  ICHECK_GT(max_depth, 0);
+  ICHECK(max_bins >= 2 && max_bins <= 256) << "max_bins should be in [2, 256]";
+  auto node = make_object<GBDTModelNode>();
+  node->max_depth = max_depth;
+  node->eta = eta;
+  node->reg_lambda = reg_lambda;
+  node->gamma = gamma;
+  node->min_child_weight = min_child_weight;
+  node->num_rounds = num_rounds;
+  node->early_stopping_rounds = early_stopping_rounds;
+  node->max_bins = max_bins;
+  node->num_warmup_sample = num_warmup_sample;
+  node->max_n_bufs = max_n_bufs;
+  node->seed = seed;
+  node->rand_gen_.seed(seed);
+  data_ = std::move(node);
+}
+
+namespace {
+
+/*! \brief Whether a per-store feature vector belongs to a state that failed to be lowered. */
+inline bool IsInvalidFeature(const std::vector<float>& feature) {
+  return feature.empty() || feature[0] <= 0;
+}
+
+/*! \brief The best split of one tree node found on one feature. */
+struct SplitCandidate {
+  double gain = 0;
+  int feature = -1;
+  int bin = -1;
+};
+
+}  // namespace
+
+void GBDTModelNode::Update(const Array<MeasureInput>& inputs,
+                           const Array<MeasureResult>& results) {
+  if (inputs.empty()) {
+    return;
+  }
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    inputs_.push_back(inputs[i]);
+    results_.push_back(results[i]);
+  }
+
+  // Only extract features for new samples. The throughputs are renormalized over all samples
+  // because the best cost of a task may change.
+  std::vector<std::vector<float>> features;
+  std::vector<float> throughputs;
+  std::vector<int> task_ids;
+  int n_cached = static_cast<int>(features_.size());
+  GetPerStoreFeaturesFromMeasurePairs(inputs_, results_, n_cached, max_n_bufs, &features,
+                                      &throughputs, &task_ids);
+  for (int i = 0; i < n_cached; ++i) {
+    features[i] = std::move(features_[i]);
+  }
+  features_ = std::move(features);
+
+  // Flatten the stores of all valid samples into a row major matrix.
+  std::vector<float> values;
+  std::vector<int> row_to_sample;
+  for (size_t i = 0; i < features_.size(); ++i) {
+    const std::vector<float>& feature = features_[i];
+    if (IsInvalidFeature(feature)) {
+      continue;
+    }
+    int n_stores = static_cast<int>(feature[0]);
+    int n_features = static_cast<int>(feature.size() - 1) / n_stores;
+    ICHECK(n_features_ == 0 || n_features_ == n_features)
+        << "Inconsistent feature length " << n_features << " vs. " << n_features_;
+    n_features_ = n_features;
+    values.insert(values.end(), feature.begin() + 1, feature.end());
+    row_to_sample.insert(row_to_sample.end(), n_stores, static_cast<int>(i));
+  }
+  if (row_to_sample.empty()) {
+    return;
+  }
+  Train(values, row_to_sample, throughputs);
+}
+
+void GBDTModelNode::Train(const std::vector<float>& values, const std::vector<int>& row_to_sample,
+                          const std::vector<float>& labels) {
+  const int n_rows = static_cast<int>(row_to_sample.size());
+  const int n_cols = n_features_;
+  const size_t n_samples = labels.size();
+
+  // Quantize every feature into at most max_bins bins. Bin b holds values in
+  // [cuts[b - 1], cuts[b]), so splitting after bin b is equivalent to "value < cuts[b]".
+  std::vector<std::vector<float>> cuts(n_cols);
+  std::vector<uint8_t> bins(static_cast<size_t>(n_rows) * n_cols);
+  support::parallel_for(0, n_cols, [&](int j) {
+    std::vector<float> column(n_rows);
+    for (int r = 0; r < n_rows; ++r) {
+      column[r] = values[static_cast<size_t>(r) * n_cols + j];
+    }
+    std::sort(column.begin(), column.end());
+    column.erase(std::unique(column.begin(), column.end()), column.end());
+    std::vector<float>& cut = cuts[j];
+    if (static_cast<int>(column.size()) <= max_bins) {
+      cut.assign(column.begin() + 1, column.end());
+    } else {
+      for (int b = 1; b < max_bins; ++b) {
+        float v = column[static_cast<size_t>(b) * column.size() / max_bins];
+        if (cut.empty() || cut.back() < v) {
+          cut.push_back(v);
+        }
+      }
+    }
+    for (int r = 0; r < n_rows; ++r) {
+      float v = values[static_cast<size_t>(r) * n_cols + j];
+      bins[static_cast<size_t>(r) * n_cols + j] =
+          static_cast<uint8_t>(std::upper_bound(cut.begin(), cut.end(), v) - cut.begin());
+    }
+  });
+
+  // The pack-sum square error objective: the prediction of a sample is the sum of the
+  // predictions of its stores, and samples are weighted by their normalized throughputs
+  // so that the model focuses on good programs.
+  std::vector<double> row_preds(n_rows, 0.0);
+  std::vector<double> sample_preds(n_samples);
+  std::vector<double> grad(n_rows), hess(n_rows);
+
+  std::vector<bool> has_rows(n_samples, false);
+  size_t n_valid = 0;
+  for (int r = 0; r < n_rows; ++r) {
+    if (!has_rows[row_to_sample[r]]) {
+      has_rows[row_to_sample[r]] = true;
+      n_valid++;
+    }
+  }
+
+  std::vector<std::vector<TreeNode>> trees;
+  double best_loss = std::numeric_limits<double>::infinity();
+  size_t best_n_trees = 0;
+
+  for (int round = 0; round < num_rounds; ++round) {
+    std::fill(sample_preds.begin(), sample_preds.end(), 0.0);
+    for (int r = 0; r < n_rows; ++r) {
+      sample_preds[row_to_sample[r]] += row_preds[r];
+    }
+    for (int r = 0; r < n_rows; ++r) {
+      int s = row_to_sample[r];
+      grad[r] = (sample_preds[s] - labels[s]) * labels[s];
+      hess[r] = labels[s];
+    }
+
+    // Grow one tree level by level. All nodes in the same level are split in one
+    // parallel pass over the features.
+    std::vector<TreeNode> tree;
+    std::vector<std::vector<int>> level_rows;
+    std::vector<int> level_nodes;
+    std::vector<int> all_rows(n_rows);
+    std::iota(all_rows.begin(), all_rows.end(), 0);
+    tree.push_back(TreeNode{-1, 0.0f, -1, -1, 0.0f});
+    level_rows.push_back(std::move(all_rows));
+    level_nodes.push_back(0);
+
+    for (int depth = 0; !level_nodes.empty(); ++depth) {
+      size_t n_nodes = level_nodes.size();
+      std::vector<double> sum_grad(n_nodes, 0.0), sum_hess(n_nodes, 0.0);
+      for (size_t k = 0; k < n_nodes; ++k) {
+        for (int r : level_rows[k]) {
+          sum_grad[k] += grad[r];
+          sum_hess[k] += hess[r];
+        }
+      }
+
+      std::vector<std::vector<SplitCandidate>> candidates(n_nodes,
+                                                          std::vector<SplitCandidate>(n_cols));
+      if (depth < max_depth) {
+        support::parallel_for(0, n_cols, [&](int j) {
+          int n_bins = static_cast<int>(cuts[j].size()) + 1;
+          if (n_bins < 2) {
+            return;
+          }
+          std::vector<double> hist_grad(n_bins), hist_hess(n_bins);
+          for (size_t k = 0; k < n_nodes; ++k) {
+            std::fill(hist_grad.begin(), hist_grad.end(), 0.0);
+            std::fill(hist_hess.begin(), hist_hess.end(), 0.0);
+            for (int r : level_rows[k]) {
+              uint8_t b = bins[static_cast<size_t>(r) * n_cols + j];
+              hist_grad[b] += grad[r];
+              hist_hess[b] += hess[r];
+            }
+            double g = sum_grad[k], h = sum_hess[k];
+            double parent_score = g * g / (h + reg_lambda);
+            double left_g = 0, left_h = 0;
+            SplitCandidate& best = candidates[k][j];
+            for (int b = 0; b + 1 < n_bins; ++b) {
+              left_g += hist_grad[b];
+              left_h += hist_hess[b];
+              double right_g = g - left_g, right_h = h - left_h;
+              if (left_h < min_child_weight || right_h < min_child_weight) {
+                continue;
+              }
+              double gain = left_g * left_g / (left_h + reg_lambda) +
+                            right_g * right_g / (right_h + reg_lambda) - parent_score - gamma;
+              if (gain > best.gain) {
+                best.gain = gain;
+                best.feature = j;
+                best.bin = b;
+              }
+            }
+          }
+        });
+      }
+
+      std::vector<std::vector<int>> next_rows;
+      std::vector<int> next_nodes;
+      for (size_t k = 0; k < n_nodes; ++k) {
+        SplitCandidate best;
+        for (const SplitCandidate& cand : candidates[k]) {
+          if (cand.feature >= 0 && cand.gain > best.gain) {
+            best = cand;
+          }
+        }
+        int node_id = level_nodes[k];
+        if (best.feature < 0) {
+          float value = static_cast<float>(-sum_grad[k] / (sum_hess[k] + reg_lambda) * eta);
+          tree[node_id].value = value;
+          for (int r : level_rows[k]) {
+            row_preds[r] += value;
+          }
+          continue;
+        }
+        std::vector<int> left, right;
+        for (int r : level_rows[k]) {
+          if (bins[static_cast<size_t>(r) * n_cols + best.feature] <= best.bin) {
+            left.push_back(r);
+          } else {
+            right.push_back(r);
+          }
+        }
+        int left_id = static_cast<int>(tree.size());
+        tree[node_id].feature = best.feature;
+        tree[node_id].threshold = cuts[best.feature][best.bin];
+        tree[node_id].left = left_id;
+        tree[node_id].right = left_id + 1;
+        tree.push_back(TreeNode{-1, 0.0f, -1, -1, 0.0f});
+        tree.push_back(TreeNode{-1, 0.0f, -1, -1, 0.0f});
+        next_rows.push_back(std::move(left));
+        next_nodes.push_back(left_id);
+        next_rows.push_back(std::move(right));
+        next_nodes.push_back(left_id + 1);
+      }
+      level_rows = std::move(next_rows);
+      level_nodes = std::move(next_nodes);
+    }
+    trees.push_back(std::move(tree));
+
+    // Early stopping on the pack-sum rmse of the training set.
+    std::fill(sample_preds.begin(), sample_preds.end(), 0.0);
+    for (int r = 0; r < n_rows; ++r) {
+      sample_preds[row_to_sample[r]] += row_preds[r];
+    }
+    double loss = 0;
+    for (size_t s = 0; s < n_samples; ++s) {
+      if (has_rows[s]) {
+        double diff = sample_preds[s] - labels[s];
+        loss += diff * diff;
+      }
+    }
+    loss = std::sqrt(loss / n_valid);
+    if (loss < best_loss) {
+      best_loss = loss;
+      best_n_trees = trees.size();
+    } else if (static_cast<int>(trees.size() - best_n_trees) >= early_stopping_rounds) {
+      break;
+    }
+  }
+
+  trees.resize(best_n_trees);
+  trees_ = std::move(trees);
+}
+
+void GBDTModelNode::PredictStores(const std::vector<float>& feature,
+                                  std::vector<float>* store_scores) const {
+  store_scores->clear();
+  if (IsInvalidFeature(feature)) {
+    return;
+  }
+  int n_stores = static_cast<int>(feature[0]);
+  ICHECK_EQ(static_cast<int>(feature.size() - 1), n_stores * n_features_)
+      << "Inconsistent feature length";
+  store_scores->resize(n_stores, 0.0f);
+  for (int i = 0; i < n_stores; ++i) {
+    const float* row = feature.data() + 1 + static_cast<size_t>(i) * n_features_;
+    float score = 0;
+    for (const std::vector<TreeNode>& tree : trees_) {
+      int node = 0;
+      while (tree[node].feature >= 0) {
+        node = row[tree[node].feature] < tree[node].threshold ? tree[node].left : tree[node].right;
+      }
+      score += tree[node].value;
+    }
+    (*store_scores)[i] = score;
+  }
+}
+
+void GBDTModelNode::PredictAllStores(const SearchTask& task, const Array<State>& states,
+                                     std::vector<float>* scores,
+                                     std::vector<std::vector<float>>* store_scores) {
+  std::vector<std::vector<float>> features;
+  GetPerStoreFeaturesFromStates(states, task, 0, max_n_bufs, &features);
+
+  scores->assign(states.size(), 0.0f);
+  store_scores->assign(states.size(), std::vector<float>());
+  bool use_model = !trees_.empty() && static_cast<int>(inputs_.size()) > num_warmup_sample;
+  if (use_model) {
+    support::parallel_for(0, static_cast<int>(states.size()), [&](int i) {
+      PredictStores(features[i], &(*store_scores)[i]);
+      float sum = 0;
+      for (float x : (*store_scores)[i]) {
+        sum += x;
+      }
+      (*scores)[i] = sum;
+    });
+  } else {
+    std::uniform_real_distribution<float> dis(0.0f, 1.0f);
+    for (size_t i = 0; i < states.size(); ++i) {
+      (*scores)[i] = dis(rand_gen_);
+    }
+  }
+
+  // Predict -inf for invalid states that failed to be lowered.
+  for (size_t i = 0; i < states.size(); ++i) {
+    if (IsInvalidFeature(features[i])) {
+      (*scores)[i] = -std::numeric_limits<float>::infinity();
+    }
+  }
+}
+
+void GBDTModelNode::Predict(const SearchTask& task, const Array<State>& states,
+                            std::vector<float>* scores) {
+  std::vector<std::vector<float>> store_scores;
+  PredictAllStores(task, states, scores, &store_scores);
+}
+
+void GBDTModelNode::PredictStages(const SearchTask& task, const Array<State>& states,
+                                  std::vector<float>* state_scores,
+                                  std::vector<std::vector<float>>* stage_scores) {
+  std::vector<std::vector<float>> store_scores;
+  PredictAllStores(task, states, state_scores, &store_scores);
+
+  // Every BufferStore corresponds to a stage that is neither a placeholder nor inlined.
+  // Assign 0 to the other stages. Give up on the breakdown if the numbers do not match.
+  stage_scores->clear();
+  for (size_t i = 0; i < states.size(); ++i) {
+    std::vector<float> scores;
+    size_t offset = 0;
+    if (!store_scores[i].empty()) {
+      for (const Stage& stage : states[i]->stages) {
+        if (stage->op_type == StageKind::kPlaceholder ||
+            stage->compute_at == ComputeAtKind::kInlined) {
+          scores.push_back(0);
+          continue;
+        }
+        scores.push_back(offset < store_scores[i].size() ? store_scores[i][offset] : 0);
+        offset++;
+      }
+    }
+    if (offset != store_scores[i].size()) {
+      scores.clear();
+    }
+    stage_scores->push_back(std::move(scores));
+  }
+}
+
 TVM_REGISTER_GLOBAL("auto_scheduler.RandomModel").set_body_typed([]() { return RandomModel(); });
 
 TVM_REGISTER_GLOBAL("auto_scheduler.PythonBasedModel")
@@ -153,6 +533,14 @@ TVM_REGISTER_GLOBAL("auto_scheduler.PythonBasedModel")
       return PythonBasedModel(update_func, predict_func, predict_stage_func);
     });
 
+TVM_REGISTER_GLOBAL("auto_scheduler.GBDTModel")
+    .set_body_typed([](int max_depth, double eta, double reg_lambda, double gamma,
+                       double min_child_weight, int num_rounds, int early_stopping_rounds,
+                       int max_bins, int num_warmup_sample, int max_n_bufs, int seed) {
+      return GBDTModel(max_depth, eta, reg_lambda, gamma, min_child_weight, num_rounds,
+                       early_stopping_rounds, max_bins, num_warmup_sample, max_n_bufs, seed);
+    });
+
 TVM_REGISTER_GLOBAL("auto_scheduler.CostModelUpdate")
     .set_body_typed([](CostModel model, Array<MeasureInput> inputs, Array<MeasureResult> results) {
       model->Update(inputs, results);
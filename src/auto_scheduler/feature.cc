@@ -22,6 +22,7 @@
  * \brief Feature extraction for the cost model
  */
 
+#include <dmlc/json.h>
 #include <tvm/arith/analyzer.h>
 #include <tvm/auto_scheduler/feature.h>
 #include <tvm/auto_scheduler/measure.h>
@@ -37,10 +38,14 @@
 
 #include <algorithm>
 #include <cmath>
+#include <list>
+#include <mutex>
 #include <numeric>
+#include <sstream>
 #include <unordered_map>
 #include <vector>
 
+#include "../support/utils.h"
 #include "search_policy/utils.h"
 #include "utils.h"
 
@@ -1262,15 +1267,315 @@ void GetPerStoreFeatureName(int max_n_bufs, std::vector<std::string>* ret) {
   // section total : 3
 }
 
+/*!
+ * \brief A cache shared by all feature extraction workers.
+ * States generated by evolutionary search share long prefixes of transform steps with their
+ * parents, and many states survive several generations unchanged. The cache memoizes the
+ * features of complete step sequences, and keeps copies of the te schedule after every
+ * kSnapshotInterval steps so that a new state only applies the steps after its longest
+ * cached prefix. Entries are looked up by hash, compared by their full serialized key, and
+ * evicted in least recently used order. The entries keep their compute dags and schedules
+ * alive, so the cache is disabled until a capacity is set.
+ */
+class FeatureExtractionCache {
+ public:
+  /*! \brief Take a snapshot of the schedule after every this many steps. */
+  static constexpr int kSnapshotInterval = 4;
+
+  /*! \brief The keys of all step prefixes of a state. */
+  struct StepKeys {
+    /*! \brief The compute dag the steps are applied to. */
+    ComputeDAG dag;
+    /*! \brief The records of all steps, concatenated. */
+    std::string records;
+    /*! \brief The first i steps are records[0, ends[i]). */
+    std::vector<size_t> ends;
+    /*! \brief The hash of the first i steps applied to dag. */
+    std::vector<uint64_t> hashes;
+
+    std::string Prefix(size_t i) const { return records.substr(0, ends[i]); }
+  };
+
+  static FeatureExtractionCache* Global() {
+    static FeatureExtractionCache inst;
+    return &inst;
+  }
+
+  /*!
+   * \brief Set the maximum number of feature and schedule entries. 0 disables the cache.
+   * \param capacity The new capacity
+   */
+  void SetCapacity(int capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    ClearUnlocked();
+  }
+
+  /*! \brief Drop all cached entries. */
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ClearUnlocked();
+  }
+
+  /*! \brief Whether the cache is enabled. */
+  bool Enabled() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_ > 0;
+  }
+
+  /*!
+   * \brief Compute the keys of all step prefixes of a state.
+   * \param dag The compute dag the steps are applied to
+   * \param steps The transform steps
+   * \return The keys, the i-th prefix identifies the first i steps applied to dag
+   */
+  static StepKeys MakeStepKeys(const ComputeDAG& dag, const Array<Step>& steps) {
+    StepKeys keys;
+    keys.dag = dag;
+    keys.ends.reserve(steps.size() + 1);
+    keys.hashes.reserve(steps.size() + 1);
+    keys.ends.push_back(0);
+    keys.hashes.push_back(ObjectPtrHash()(dag));
+    std::ostringstream os;
+    for (const auto& step : steps) {
+      std::ostringstream step_os;
+      dmlc::JSONWriter writer(&step_os);
+      writer.BeginArray(false);
+      step->WriteToRecord(&writer);
+      writer.EndArray();
+      std::string record = step_os.str();
+      os << record;
+      keys.ends.push_back(keys.ends.back() + record.size());
+      keys.hashes.push_back(
+          support::HashCombine(keys.hashes.back(), std::hash<std::string>()(record)));
+    }
+    keys.records = os.str();
+    return keys;
+  }
+
+  /*!
+   * \brief Look up the features of a complete step sequence.
+   * \param keys The keys returned by MakeStepKeys
+   * \param options The other inputs of feature extraction, such as the hardware parameters
+   * \param feature The cached features
+   * \param failed Whether the cached extraction failed
+   * \return Whether the features are cached
+   */
+  bool LookupFeature(const StepKeys& keys, const std::string& options, std::vector<float>* feature,
+                     bool* failed) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const FeatureEntry* entry =
+        features_.Find(FeatureHash(keys, options), keys.dag, keys.records + options);
+    if (entry == nullptr) {
+      return false;
+    }
+    *feature = entry->feature;
+    *failed = entry->failed;
+    return true;
+  }
+
+  void AddFeature(const StepKeys& keys, const std::string& options,
+                  const std::vector<float>& feature, bool failed) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    features_.Put(FeatureHash(keys, options), keys.dag, keys.records + options,
+                  FeatureEntry{feature, failed}, capacity_);
+  }
+
+  /*!
+   * \brief Apply steps to a compute dag, starting from the longest cached prefix.
+   * \param steps The transform steps
+   * \param keys The keys returned by MakeStepKeys
+   * \return The schedule and the tensors of the dag, same as ComputeDAG::ApplySteps
+   */
+  std::pair<te::Schedule, Array<te::Tensor>> ApplySteps(const Array<Step>& steps,
+                                                       const StepKeys& keys) {
+    const ComputeDAG& dag = keys.dag;
+    int n_steps = static_cast<int>(steps.size());
+    int start = 0;
+    te::Schedule schedule;
+    Array<te::Stage> stages;
+    StageToAxesMap stage_to_axes;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (int k = n_steps / kSnapshotInterval * kSnapshotInterval; k > 0;
+           k -= kSnapshotInterval) {
+        const Snapshot* snapshot = snapshots_.Find(keys.hashes[k], dag, keys.Prefix(k));
+        if (snapshot != nullptr) {
+          // Copy under the lock, the snapshot itself is never modified.
+          CopySchedule(snapshot->schedule, snapshot->stages, snapshot->stage_to_axes, &schedule,
+                       &stages, &stage_to_axes);
+          start = k;
+          break;
+        }
+      }
+    }
+    if (start == 0) {
+      schedule = dag.ApplySteps(Array<Step>(), &stages, &stage_to_axes).first;
+    }
+
+    for (int i = start; i < n_steps; ++i) {
+      StepApplyToSchedule(steps[i], &stages, &stage_to_axes, &schedule, steps);
+      int k = i + 1;
+      if (k % kSnapshotInterval == 0 && k < n_steps) {
+        Snapshot snapshot;
+        CopySchedule(schedule, stages, stage_to_axes, &snapshot.schedule, &snapshot.stages,
+                     &snapshot.stage_to_axes);
+        std::lock_guard<std::mutex> lock(mutex_);
+        snapshots_.Put(keys.hashes[k], dag, keys.Prefix(k), std::move(snapshot), capacity_);
+      }
+    }
+    return std::make_pair(schedule, dag->tensors);
+  }
+
+ private:
+  /*! \brief The features of a step sequence. */
+  struct FeatureEntry {
+    std::vector<float> feature;
+    /*! \brief Whether the extraction failed, so that it is counted again on a hit. */
+    bool failed;
+  };
+
+  /*! \brief The te schedule and the auto_scheduler bookkeeping after a step prefix. */
+  struct Snapshot {
+    te::Schedule schedule;
+    Array<te::Stage> stages;
+    StageToAxesMap stage_to_axes;
+  };
+
+  /*!
+   * \brief A table with at most capacity entries, evicted in least recently used order.
+   * A hash collision between different keys is a miss, and the newer entry replaces the older.
+   */
+  template <typename T>
+  class LRUTable {
+   public:
+    const T* Find(uint64_t hash, const ComputeDAG& dag, const std::string& key) {
+      auto it = index_.find(hash);
+      if (it == index_.end() || !it->second->dag.same_as(dag) || it->second->key != key) {
+        return nullptr;
+      }
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return &it->second->value;
+    }
+
+    void Put(uint64_t hash, ComputeDAG dag, std::string key, T value, int capacity) {
+      auto it = index_.find(hash);
+      if (it != index_.end()) {
+        entries_.erase(it->second);
+        index_.erase(it);
+      }
+      if (capacity <= 0) {
+        return;
+      }
+      entries_.push_front(Entry{hash, std::move(dag), std::move(key), std::move(value)});
+      index_[hash] = entries_.begin();
+      while (static_cast<int>(entries_.size()) > capacity) {
+        index_.erase(entries_.back().hash);
+        entries_.pop_back();
+      }
+    }
+
+    void clear() {
+      entries_.clear();
+      index_.clear();
+    }
+
+   private:
+    struct Entry {
+      uint64_t hash;
+      /*! \brief Holding the dag also keeps its address from being reused by another dag. */
+      ComputeDAG dag;
+      std::string key;
+      T value;
+    };
+    /*! \brief The entries, most recently used first. */
+    std::list<Entry> entries_;
+    std::unordered_map<uint64_t, typename std::list<Entry>::iterator> index_;
+  };
+
+  static uint64_t FeatureHash(const StepKeys& keys, const std::string& options) {
+    return support::HashCombine(keys.hashes.back(), std::hash<std::string>()(options));
+  }
+
+  /*! \brief Deep copy a schedule and remap the stages that refer to it. */
+  static void CopySchedule(const te::Schedule& schedule, const Array<te::Stage>& stages,
+                           const StageToAxesMap& stage_to_axes, te::Schedule* new_schedule,
+                           Array<te::Stage>* new_stages, StageToAxesMap* new_stage_to_axes) {
+    *new_schedule = schedule.copy();
+    // Schedule::copy keeps the order of stages.
+    std::unordered_map<te::Stage, te::Stage, ObjectPtrHash, ObjectPtrEqual> smap;
+    for (size_t i = 0; i < schedule->stages.size(); ++i) {
+      smap[schedule->stages[i]] = (*new_schedule)->stages[i];
+    }
+    for (size_t i = 0; i < schedule->groups.size(); ++i) {
+      smap[schedule->groups[i]] = (*new_schedule)->groups[i];
+    }
+    *new_stages = Array<te::Stage>();
+    for (const auto& stage : stages) {
+      new_stages->push_back(smap.at(stage));
+    }
+    *new_stage_to_axes = StageToAxesMap();
+    for (const auto& kv : stage_to_axes) {
+      new_stage_to_axes->Set(smap.at(kv.first), kv.second);
+    }
+  }
+
+  void ClearUnlocked() {
+    features_.clear();
+    snapshots_.clear();
+  }
+
+  std::mutex mutex_;
+  int capacity_{0};
+  LRUTable<FeatureEntry> features_;
+  LRUTable<Snapshot> snapshots_;
+};
+
 void GetPerStoreFeaturesWorkerFunc(const SearchTask& task, const State& state, int max_n_bufs,
                                    std::vector<float>* feature, std::atomic<int>* error_ct) {
   te::Schedule sch;
   Array<te::Tensor> tensors;
 
-  std::tie(sch, tensors) = task->compute_dag.ApplySteps(state->transform_steps);
+  auto pass_ctx = tvm::transform::PassContext::Current();
+  bool noalias = pass_ctx->GetConfig<Bool>("tir.noalias", Bool(true)).value();
+  bool disable_vectorize = pass_ctx->GetConfig<Bool>("tir.disable_vectorize", Bool(false)).value();
+  bool instrument_bound_checkers =
+      pass_ctx->GetConfig<Bool>("tir.instrument_bound_checkers", Bool(false)).value();
+
+  FeatureExtractionCache* cache = FeatureExtractionCache::Global();
+  bool use_cache = cache->Enabled();
+  FeatureExtractionCache::StepKeys step_keys;
+  std::string options;
+  if (use_cache) {
+    step_keys = cache->MakeStepKeys(task->compute_dag, state->transform_steps);
+    // The features also depend on the hardware parameters and the lowering options.
+    std::ostringstream os;
+    os << "|" << max_n_bufs << "," << IsGPUTask(task);
+    for (int param : {task->hardware_params->cache_line_bytes,
+                      task->hardware_params->max_shared_memory_per_block,
+                      task->hardware_params->max_local_memory_per_block,
+                      task->hardware_params->max_threads_per_block,
+                      task->hardware_params->vector_unit_bytes,
+                      task->hardware_params->max_vthread_extent}) {
+      os << "," << param;
+    }
+    os << "," << noalias << "," << disable_vectorize << "," << instrument_bound_checkers;
+    options = os.str();
+    bool cached_failure = false;
+    if (cache->LookupFeature(step_keys, options, feature, &cached_failure)) {
+      if (cached_failure) {
+        (*error_ct)++;
+      }
+      return;
+    }
+    std::tie(sch, tensors) = cache->ApplySteps(state->transform_steps, step_keys);
+  } else {
+    std::tie(sch, tensors) = task->compute_dag.ApplySteps(state->transform_steps);
+  }
   sch = sch.normalize_for_feature_extraction();
   auto bounds = te::InferBound(sch);
 
+  bool failed = false;
   try {
     auto stmt = te::ScheduleOps(sch, bounds, false);
     Map<te::Tensor, te::Buffer> out_binds;
@@ -1280,18 +1585,11 @@ void GetPerStoreFeaturesWorkerFunc(const SearchTask& task, const State& state, i
     GlobalVar global_var(name);
 
     // Copied from driver_api.cc::lower
-    auto pass_ctx = tvm::transform::PassContext::Current();
     GetBinds(tensors, compact, std::unordered_map<te::Tensor, te::Buffer>(), &out_binds,
              &out_arg_list);
     tir::PrimFunc f = te::SchedulePostProcToPrimFunc(out_arg_list, std::move(stmt), out_binds);
     f = WithAttr(std::move(f), "global_symbol", runtime::String(name));
 
-    bool noalias = pass_ctx->GetConfig<Bool>("tir.noalias", Bool(true)).value();
-    bool disable_vectorize =
-        pass_ctx->GetConfig<Bool>("tir.disable_vectorize", Bool(false)).value();
-    bool instrument_bound_checkers =
-        pass_ctx->GetConfig<Bool>("tir.instrument_bound_checkers", Bool(false)).value();
-
     if (noalias) {
       f = WithAttr(std::move(f), "tir.noalias", Bool(true));
     }
@@ -1330,6 +1628,11 @@ void GetPerStoreFeaturesWorkerFunc(const SearchTask& task, const State& state, i
                        feature);
   } catch (Error& e) {
     (*error_ct)++;
+    failed = true;
+  }
+
+  if (use_cache) {
+    cache->AddFeature(step_keys, options, *feature, failed);
   }
 }
 
@@ -1363,6 +1666,58 @@ void GetPerStoreFeaturesFromStates(const Array<State>& states, const std::vector
                         });
 }
 
+int GetPerStoreFeaturesFromStatesColumnar(const Array<State>& states, const SearchTask& task,
+                                          int skip_first_n_feature_extraction, int max_n_bufs,
+                                          runtime::NDArray features, runtime::NDArray mask) {
+  std::vector<std::string> names;
+  GetPerStoreFeatureName(max_n_bufs, &names);
+  const int64_t vec_len = static_cast<int64_t>(names.size());
+  const int64_t n_states = static_cast<int64_t>(states.size());
+
+  ICHECK(features.defined() && mask.defined());
+  ICHECK_EQ(features->device.device_type, kDLCPU) << "The feature buffer must be on CPU";
+  ICHECK_EQ(mask->device.device_type, kDLCPU) << "The mask buffer must be on CPU";
+  ICHECK(features.DataType() == DataType::Float(32)) << "The feature buffer must be float32";
+  ICHECK(mask.DataType() == DataType::Float(32)) << "The mask buffer must be float32";
+  ICHECK(features.IsContiguous() && mask.IsContiguous()) << "The output buffers must be compact";
+  ICHECK_EQ(features->ndim, 3);
+  ICHECK_EQ(mask->ndim, 2);
+  ICHECK_EQ(features->shape[0], n_states);
+  ICHECK_EQ(features->shape[2], vec_len) << "The length of feature vector is wrong";
+  ICHECK_EQ(mask->shape[0], n_states);
+  ICHECK_EQ(mask->shape[1], features->shape[1]);
+  const int64_t max_n_stores = features->shape[1];
+
+  float* feature_data = reinterpret_cast<float*>(static_cast<char*>(features->data) +
+                                                 features->byte_offset);
+  float* mask_data = reinterpret_cast<float*>(static_cast<char*>(mask->data) + mask->byte_offset);
+  // The buffers may be reused across calls, so clear the rows that will not be written.
+  std::fill(feature_data, feature_data + n_states * max_n_stores * vec_len, 0.0f);
+  std::fill(mask_data, mask_data + n_states * max_n_stores, 0.0f);
+
+  std::vector<int> n_stores(states.size(), 0);
+  std::atomic<int> error_ct(0);
+
+  support::parallel_for(skip_first_n_feature_extraction, states.size(), [&](int i) {
+    // The layout of the per-state vector is {n_stmts, feature_vecs[n_stmts][vec_len]}.
+    std::vector<float> feature;
+    GetPerStoreFeaturesWorkerFunc(task, states[i], max_n_bufs, &feature, &error_ct);
+    if (feature.empty()) {
+      return;
+    }
+    int n_stmts = static_cast<int>(feature[0] + 0.5);
+    ICHECK_EQ(static_cast<int64_t>(feature.size()), 1 + n_stmts * vec_len);
+    n_stores[i] = n_stmts;
+
+    int64_t n_copy = std::min(static_cast<int64_t>(n_stmts), max_n_stores);
+    std::copy(feature.begin() + 1, feature.begin() + 1 + n_copy * vec_len,
+              feature_data + i * max_n_stores * vec_len);
+    std::fill(mask_data + i * max_n_stores, mask_data + i * max_n_stores + n_copy, 1.0f);
+  });
+
+  return n_stores.empty() ? 0 : *std::max_element(n_stores.begin(), n_stores.end());
+}
+
 void GetPerStoreFeaturesFromFile(const std::string& filename, int max_lines, int max_n_bufs,
                                  std::vector<std::vector<float>>* features,
                                  std::vector<float>* normalized_throughputs,
@@ -1640,6 +1995,20 @@ TVM_REGISTER_GLOBAL("auto_scheduler.GetPerStoreFeaturesFromStates")
                                std::move(task_ids), &byte_data);
     });
 
+TVM_REGISTER_GLOBAL("auto_scheduler.GetPerStoreFeaturesFromStatesColumnar")
+    .set_body_typed([](Array<State> states, SearchTask task, int max_n_bufs,
+                       runtime::NDArray features, runtime::NDArray mask) {
+      return GetPerStoreFeaturesFromStatesColumnar(states, task, 0, max_n_bufs, features, mask);
+    });
+
+TVM_REGISTER_GLOBAL("auto_scheduler.SetFeatureCacheCapacity").set_body_typed([](int capacity) {
+  FeatureExtractionCache::Global()->SetCapacity(capacity);
+});
+
+TVM_REGISTER_GLOBAL("auto_scheduler.ClearFeatureCache").set_body_typed([]() {
+  FeatureExtractionCache::Global()->Clear();
+});
+
 TVM_REGISTER_GLOBAL("auto_scheduler.GetPerStoreFeatureNames")
     .set_body([](TVMArgs args, TVMRetValue* ret) {
       int max_n_bufs = args[0];
@@ -29,8 +29,12 @@
 #include <tvm/runtime/registry.h>
 #include <tvm/te/operation.h>
 
+#include <sstream>
+#include <string>
 #include <utility>
+#include <vector>
 
+#include "../support/utils.h"
 #include "utils.h"
 
 namespace tvm {
@@ -445,6 +449,95 @@ String State::ToStr(bool delete_trivial_loop) const {
   return os.str();
 }
 
+/*! \brief Serialize a transform step the way it is written to a measure record. */
+static std::string SerializeStep(const Step& step) {
+  std::ostringstream os;
+  dmlc::JSONWriter writer(&os);
+  writer.BeginArray(false);
+  step->WriteToRecord(&writer);
+  writer.EndArray();
+  return os.str();
+}
+
+uint64_t State::Fingerprint() const {
+  const StateNode* node = operator->();
+  std::vector<std::pair<Step, uint64_t>>& cache = node->step_hash_cache;
+  size_t n_steps = node->transform_steps.size();
+  // Keep the longest prefix of steps that are unchanged since the last call.
+  size_t n_valid = 0;
+  while (n_valid < cache.size() && n_valid < n_steps &&
+         cache[n_valid].first.same_as(node->transform_steps[n_valid])) {
+    n_valid++;
+  }
+  cache.resize(n_valid);
+  uint64_t hash = cache.empty() ? 0 : cache.back().second;
+  for (size_t i = n_valid; i < n_steps; ++i) {
+    const Step& step = node->transform_steps[i];
+    hash = support::HashCombine(hash, std::hash<std::string>()(SerializeStep(step)));
+    cache.emplace_back(step, hash);
+  }
+  return support::HashCombine(hash, static_cast<uint64_t>(n_steps));
+}
+
+/*! \brief Whether two states have the same transform steps. */
+static bool HasSameSteps(const State& lhs, const State& rhs) {
+  const Array<Step>& lhs_steps = lhs->transform_steps;
+  const Array<Step>& rhs_steps = rhs->transform_steps;
+  if (lhs_steps.size() != rhs_steps.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs_steps.size(); ++i) {
+    if (!lhs_steps[i].same_as(rhs_steps[i]) &&
+        SerializeStep(lhs_steps[i]) != SerializeStep(rhs_steps[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool StateSet::Contains(const State& state) const {
+  auto it = buckets_.find(state.Fingerprint());
+  if (it == buckets_.end()) {
+    return false;
+  }
+  for (const State& other : it->second) {
+    if (HasSameSteps(state, other)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool StateSet::Insert(const State& state) {
+  std::vector<State>& bucket = buckets_[state.Fingerprint()];
+  for (const State& other : bucket) {
+    if (HasSameSteps(state, other)) {
+      return false;
+    }
+  }
+  bucket.push_back(state);
+  size_++;
+  return true;
+}
+
+void StateSet::Erase(const State& state) {
+  auto it = buckets_.find(state.Fingerprint());
+  if (it == buckets_.end()) {
+    return;
+  }
+  std::vector<State>& bucket = it->second;
+  for (size_t i = 0; i < bucket.size(); ++i) {
+    if (HasSameSteps(state, bucket[i])) {
+      bucket.erase(bucket.begin() + i);
+      size_--;
+      break;
+    }
+  }
+  if (bucket.empty()) {
+    buckets_.erase(it);
+  }
+}
+
 TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
     .set_dispatch<StageNode>([](const ObjectRef& ref, ReprPrinter* p) {
       const auto& stage = tvm::Downcast<Stage>(ref);
@@ -571,5 +664,9 @@ TVM_REGISTER_GLOBAL("auto_scheduler.StateEqual").set_body_typed([](State state1,
   return std::equal_to<State>()(state1, state2);
 });
 
+TVM_REGISTER_GLOBAL("auto_scheduler.StateFingerprint").set_body_typed([](State state) {
+  return static_cast<int64_t>(state.Fingerprint());
+});
+
 }  // namespace auto_scheduler
 }  // namespace tvm
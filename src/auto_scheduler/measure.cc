@@ -26,6 +26,8 @@
 #include <tvm/runtime/registry.h>
 
 #include <algorithm>
+#include <mutex>
+#include <vector>
 
 #include "search_policy/empty_policy.h"
 #include "search_policy/sketch_policy.h"
@@ -85,13 +87,14 @@ BuildResult::BuildResult(String filename, Array<te::Tensor> args, int error_no,
 }
 
 MeasureResult::MeasureResult(Array<PrimExpr> costs, int error_no, String error_msg, double all_cost,
-                             double timestamp) {
+                             double timestamp, double confidence_interval) {
   auto node = make_object<MeasureResultNode>();
   node->costs = std::move(costs);
   node->error_no = error_no;
   node->error_msg = std::move(error_msg);
   node->all_cost = all_cost;
   node->timestamp = timestamp;
+  node->confidence_interval = confidence_interval;
   data_ = std::move(node);
 }
 
@@ -102,21 +105,25 @@ MeasureResult MeasureResultNode::copy() const {
   node->error_msg = error_msg;
   node->all_cost = all_cost;
   node->timestamp = timestamp;
+  node->confidence_interval = confidence_interval;
   return MeasureResult(node);
 }
 
 /********** LocalBuilder **********/
-LocalBuilder::LocalBuilder(int timeout, int n_parallel, const String& build_func) {
+LocalBuilder::LocalBuilder(int timeout, int n_parallel, const String& build_func,
+                           bool persistent_workers) {
   auto node = make_object<LocalBuilderNode>();
   node->timeout = timeout;
   node->n_parallel = n_parallel;
   node->build_func = build_func;
+  node->persistent_workers = persistent_workers;
   data_ = std::move(node);
 }
 
 Array<BuildResult> LocalBuilderNode::Build(const Array<MeasureInput>& inputs, int verbose) {
   if (const auto* f = runtime::Registry::Get("auto_scheduler.local_builder.build")) {
-    Array<BuildResult> results = (*f)(inputs, timeout, n_parallel, build_func, verbose);
+    Array<BuildResult> results =
+        (*f)(inputs, timeout, n_parallel, build_func, verbose, persistent_workers);
     return results;
   }
   LOG(FATAL) << "auto_scheduler.local_builder.build is not registered. "
@@ -125,9 +132,27 @@ Array<BuildResult> LocalBuilderNode::Build(const Array<MeasureInput>& inputs, in
   throw;
 }
 
+TypedPackedFunc<Array<BuildResult>()> ProgramBuilderNode::BuildAsync(
+    const Array<MeasureInput>& inputs, int verbose) {
+  Array<BuildResult> results = Build(inputs, verbose);
+  return TypedPackedFunc<Array<BuildResult>()>([results]() { return results; });
+}
+
+TypedPackedFunc<Array<BuildResult>()> LocalBuilderNode::BuildAsync(
+    const Array<MeasureInput>& inputs, int verbose) {
+  if (const auto* f = runtime::Registry::Get("auto_scheduler.local_builder.build_async")) {
+    PackedFunc wait =
+        (*f)(inputs, timeout, n_parallel, build_func, verbose, persistent_workers);
+    return TypedPackedFunc<Array<BuildResult>()>(
+        [wait]() -> Array<BuildResult> { return wait(); });
+  }
+  return ProgramBuilderNode::BuildAsync(inputs, verbose);
+}
+
 /********** LocalRunner **********/
 LocalRunner::LocalRunner(int timeout, int number, int repeat, int min_repeat_ms,
-                         double cooldown_interval, bool enable_cpu_cache_flush) {
+                         double cooldown_interval, bool enable_cpu_cache_flush, bool adaptive,
+                         int max_repeat, double ci_tolerance, bool persistent_workers) {
   ObjectPtr<LocalRunnerNode> node = make_object<LocalRunnerNode>();
   node->timeout = timeout;
   node->number = number;
@@ -135,15 +160,51 @@ LocalRunner::LocalRunner(int timeout, int number, int repeat, int min_repeat_ms,
   node->min_repeat_ms = min_repeat_ms;
   node->cooldown_interval = cooldown_interval;
   node->enable_cpu_cache_flush = enable_cpu_cache_flush;
+  node->adaptive = adaptive;
+  node->max_repeat = max_repeat;
+  node->ci_tolerance = ci_tolerance;
+  node->persistent_workers = persistent_workers;
   data_ = std::move(node);
 }
 
 Array<MeasureResult> LocalRunnerNode::Run(const Array<MeasureInput>& inputs,
                                           const Array<BuildResult>& build_results, int verbose) {
   if (const auto* f = runtime::Registry::Get("auto_scheduler.local_runner.run")) {
+    if (!adaptive) {
+      Array<MeasureResult> results =
+          (*f)(inputs, build_results, timeout, number, repeat, min_repeat_ms, cooldown_interval,
+               enable_cpu_cache_flush, verbose, adaptive, max_repeat, ci_tolerance,
+               Array<FloatImm>(), persistent_workers);
+      return results;
+    }
+
+    // Pass the best known cost of each workload, so that slow candidates can stop early
+    Array<FloatImm> best_costs;
+    {
+      std::lock_guard<std::mutex> lock(best_costs_mutex_);
+      for (const auto& inp : inputs) {
+        auto it = best_costs_.find(inp->task->workload_key);
+        best_costs.push_back(
+            FloatImm(DataType::Float(64), it == best_costs_.end() ? -1.0 : it->second));
+      }
+    }
     Array<MeasureResult> results =
         (*f)(inputs, build_results, timeout, number, repeat, min_repeat_ms, cooldown_interval,
-             enable_cpu_cache_flush, verbose);
+             enable_cpu_cache_flush, verbose, adaptive, max_repeat, ci_tolerance, best_costs,
+             persistent_workers);
+    std::lock_guard<std::mutex> lock(best_costs_mutex_);
+    for (size_t i = 0; i < results.size(); ++i) {
+      if (results[i]->error_no != static_cast<int>(MeasureErrorNO::kNoError)) {
+        continue;
+      }
+      double cost = FloatArrayMean(results[i]->costs);
+      auto it = best_costs_.find(inputs[i]->task->workload_key);
+      if (it == best_costs_.end()) {
+        best_costs_[inputs[i]->task->workload_key] = cost;
+      } else if (cost < it->second) {
+        it->second = cost;
+      }
+    }
     return results;
   }
   LOG(FATAL) << "auto_scheduler.local_runner.run is not registered. "
@@ -208,10 +269,15 @@ void PythonBasedMeasureCallbackNode::Callback(const SearchPolicy& policy,
 /********** ProgramMeasurer **********/
 ProgramMeasurer::ProgramMeasurer(ProgramBuilder builder, ProgramRunner runner,
                                  Optional<Array<MeasureCallback>> callbacks, int verbose,
-                                 int max_continuous_error) {
+                                 int max_continuous_error, bool pipelined) {
   auto node = make_object<ProgramMeasurerNode>();
   node->builder = std::move(builder);
   node->runner = std::move(runner);
+  node->pipelined = pipelined;
+  if (pipelined && node->runner.as<LocalRunnerNode>()) {
+    LOG(WARNING) << "Pipelined measurement builds programs on the machine LocalRunner measures "
+                 << "them on, which skews the measured costs. Use it with an RPCRunner.";
+  }
   node->callbacks = std::move(callbacks);
   node->verbose = verbose;
   node->max_continuous_error = max_continuous_error < 0
@@ -238,22 +304,16 @@ Array<MeasureResult> ProgramMeasurerNode::Measure(const SearchTask& task,
   results.reserve(inputs.size());
 
   if (batch_size == -1) {
-    // set default batch size
-    batch_size = builder->n_parallel * 2;
+    // set default batch size. In pipelined mode, smaller batches start running earlier.
+    batch_size = pipelined ? builder->n_parallel : builder->n_parallel * 2;
   }
 
   int old_verbosity = verbose;
 
   StdCout(verbose) << "Get " << inputs.size() << " programs to measure:" << std::endl;
 
-  for (size_t i = 0; i < inputs.size(); i += batch_size) {
-    Array<MeasureInput> input_batch(inputs.begin() + i,
-                                    inputs.begin() + std::min(i + batch_size, inputs.size()));
-    Array<MeasureResult> result_batch;
-
-    // build and run
-    SilentMeasure(task, input_batch, &result_batch);
-
+  auto process_batch = [&](const Array<MeasureInput>& input_batch,
+                           const Array<MeasureResult>& result_batch) {
     // update current best state according to the new measure result
     for (size_t j = 0; j < input_batch.size(); ++j) {
       const String& workload_key = input_batch[j]->task->workload_key;
@@ -302,6 +362,20 @@ Array<MeasureResult> ProgramMeasurerNode::Measure(const SearchTask& task,
     } else {
       verbose = old_verbosity;
     }
+  };
+
+  if (pipelined) {
+    PipelinedMeasure(inputs, batch_size, process_batch);
+  } else {
+    for (size_t i = 0; i < inputs.size(); i += batch_size) {
+      Array<MeasureInput> input_batch(inputs.begin() + i,
+                                      inputs.begin() + std::min(i + batch_size, inputs.size()));
+      Array<MeasureResult> result_batch;
+
+      // build and run
+      SilentMeasure(task, input_batch, &result_batch);
+      process_batch(input_batch, result_batch);
+    }
   }
 
   PrintTimeElapsed(t_begin, "measurement", verbose);
@@ -324,6 +398,33 @@ void ProgramMeasurerNode::SilentMeasure(const SearchTask& task, const Array<Meas
   }
 }
 
+void ProgramMeasurerNode::PipelinedMeasure(
+    const Array<MeasureInput>& inputs, int batch_size,
+    const std::function<void(const Array<MeasureInput>&, const Array<MeasureResult>&)>&
+        on_batch) {
+  ICHECK_GT(batch_size, 0);
+  std::vector<Array<MeasureInput>> input_batches;
+  for (size_t i = 0; i < inputs.size(); i += batch_size) {
+    input_batches.emplace_back(inputs.begin() + i,
+                               inputs.begin() + std::min(i + batch_size, inputs.size()));
+  }
+  if (input_batches.empty()) {
+    return;
+  }
+
+  TypedPackedFunc<Array<BuildResult>()> pending_build =
+      builder->BuildAsync(input_batches[0], verbose);
+  for (size_t b = 0; b < input_batches.size(); ++b) {
+    Array<BuildResult> build_results = pending_build();
+    // Build the next batch while this one is being run.
+    if (b + 1 < input_batches.size()) {
+      pending_build = builder->BuildAsync(input_batches[b + 1], verbose);
+    }
+    Array<MeasureResult> run_results = runner->Run(input_batches[b], build_results, verbose);
+    on_batch(input_batches[b], run_results);
+  }
+}
+
 /********** Printing functions **********/
 TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
     .set_dispatch<MeasureInputNode>([](const ObjectRef& ref, ReprPrinter* p) {
@@ -378,8 +479,8 @@ TVM_REGISTER_GLOBAL("auto_scheduler.BuildResult")
 
 TVM_REGISTER_GLOBAL("auto_scheduler.MeasureResult")
     .set_body_typed([](Array<PrimExpr> costs, int error_no, String error_msg, double all_cost,
-                       double timestamp) {
-      return MeasureResult(costs, error_no, error_msg, all_cost, timestamp);
+                       double timestamp, double confidence_interval) {
+      return MeasureResult(costs, error_no, error_msg, all_cost, timestamp, confidence_interval);
     });
 
 TVM_REGISTER_GLOBAL("auto_scheduler.PythonBasedMeasureCallback")
@@ -389,8 +490,9 @@ TVM_REGISTER_GLOBAL("auto_scheduler.PythonBasedMeasureCallback")
 
 TVM_REGISTER_GLOBAL("auto_scheduler.ProgramMeasurer")
     .set_body_typed([](ProgramBuilder builder, ProgramRunner runner,
-                       Array<MeasureCallback> callbacks, int verbose, int max_continuous_error) {
-      return ProgramMeasurer(builder, runner, callbacks, verbose, max_continuous_error);
+                       Array<MeasureCallback> callbacks, int verbose, int max_continuous_error,
+                       bool pipelined) {
+      return ProgramMeasurer(builder, runner, callbacks, verbose, max_continuous_error, pipelined);
     });
 
 TVM_REGISTER_GLOBAL("auto_scheduler.ProgramBuilderBuild")
@@ -403,15 +505,18 @@ TVM_REGISTER_GLOBAL("auto_scheduler.ProgramRunnerRun")
                        int verbose) { return runner->Run(inputs, build_results, verbose); });
 
 TVM_REGISTER_GLOBAL("auto_scheduler.LocalBuilder")
-    .set_body_typed([](int timeout, int n_parallel, const String& build_func) {
-      return LocalBuilder(timeout, n_parallel, build_func);
+    .set_body_typed([](int timeout, int n_parallel, const String& build_func,
+                       bool persistent_workers) {
+      return LocalBuilder(timeout, n_parallel, build_func, persistent_workers);
     });
 
 TVM_REGISTER_GLOBAL("auto_scheduler.LocalRunner")
     .set_body_typed([](int timeout, int number, int repeat, int min_repeat_ms,
-                       double cooldown_interval, bool enable_cpu_cache_flush) {
+                       double cooldown_interval, bool enable_cpu_cache_flush, bool adaptive,
+                       int max_repeat, double ci_tolerance, bool persistent_workers) {
       return LocalRunner(timeout, number, repeat, min_repeat_ms, cooldown_interval,
-                         enable_cpu_cache_flush);
+                         enable_cpu_cache_flush, adaptive, max_repeat, ci_tolerance,
+                         persistent_workers);
     });
 
 TVM_REGISTER_GLOBAL("auto_scheduler.RPCRunner")
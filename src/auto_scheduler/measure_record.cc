@@ -28,12 +28,21 @@
 #include <tvm/auto_scheduler/transform_step.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <fstream>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
 #include "utils.h"
 
 // Json serialization handler for MeasureInput, MeasureResult
@@ -309,6 +318,8 @@ namespace auto_scheduler {
 
 TVM_REGISTER_OBJECT_TYPE(RecordToFileNode);
 TVM_REGISTER_OBJECT_TYPE(RecordReaderNode);
+TVM_REGISTER_OBJECT_TYPE(RecordStoreNode);
+TVM_REGISTER_OBJECT_TYPE(RecordToStoreNode);
 
 RecordToFile::RecordToFile(String filename) {
   auto node = make_object<RecordToFileNode>();
@@ -358,13 +369,20 @@ void RecordToFileNode::Callback(const SearchPolicy& policy, const Array<MeasureI
 RecordReader::RecordReader(String filename) {
   auto node = make_object<RecordReaderNode>();
   node->filename = filename;
-  node->infile.open(filename, std::ifstream::in);
+  if (RecordStoreNode::IsRecordStore(filename)) {
+    node->store = RecordStore(filename);
+  } else {
+    node->infile.open(filename, std::ifstream::in);
+  }
   data_ = std::move(node);
 }
 
 RecordReaderNode::~RecordReaderNode() { infile.close(); }
 
 bool RecordReaderNode::ReadNext(MeasureInputNode* inp, MeasureResultNode* res) {
+  if (store) {
+    return store.value()->ReadNext(inp, res);
+  }
   std::string log_version;
 
   while (std::getline(infile, cur_line_)) {
@@ -403,6 +421,397 @@ std::pair<Array<MeasureInput>, Array<MeasureResult>> RecordReaderNode::ReadLines
   return std::make_pair(inputs, results);
 }
 
+/********** Binary record store **********/
+namespace {
+
+/*! \brief Magic number at the beginning of a record store. */
+constexpr uint64_t kRecordStoreMagic = 0x31534452414d5654;
+/*! \brief Magic number at the beginning of a record store index. */
+constexpr uint64_t kRecordIndexMagic = 0x31584449414d5654;
+/*! \brief Magic number at the beginning of every record. */
+constexpr uint32_t kRecordMagic = 0x44524352;
+/*! \brief The size of the file header: the magic number and a reserved word. */
+constexpr int64_t kRecordStoreHeaderSize = 16;
+
+template <typename T>
+void WritePOD(std::ostream* os, const T& value) {
+  os->write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadPOD(std::istream* is, T* value) {
+  is->read(reinterpret_cast<char*>(value), sizeof(T));
+  return static_cast<size_t>(is->gcount()) == sizeof(T);
+}
+
+void WriteStr(std::ostream* os, const std::string& str) {
+  WritePOD(os, static_cast<uint32_t>(str.size()));
+  os->write(str.data(), str.size());
+}
+
+bool ReadStr(std::istream* is, std::string* str) {
+  // Keys and targets are short, a larger size means a corrupted or truncated record.
+  constexpr uint32_t kMaxStrSize = 1 << 24;
+  uint32_t size;
+  if (!ReadPOD(is, &size) || size > kMaxStrSize) {
+    return false;
+  }
+  str->resize(size);
+  is->read(&(*str)[0], size);
+  return static_cast<uint32_t>(is->gcount()) == size;
+}
+
+/*! \brief The binary header of a record. The json payload follows it. */
+struct RecordHeader {
+  std::string workload_key;
+  std::string target;
+  double cost;
+  int32_t error_no;
+  uint32_t payload_size;
+
+  bool Read(std::istream* is) {
+    uint32_t magic;
+    if (!ReadPOD(is, &magic) || magic != kRecordMagic) {
+      return false;
+    }
+    return ReadStr(is, &workload_key) && ReadStr(is, &target) && ReadPOD(is, &cost) &&
+           ReadPOD(is, &error_no) && ReadPOD(is, &payload_size);
+  }
+
+  void Write(std::ostream* os) const {
+    WritePOD(os, kRecordMagic);
+    WriteStr(os, workload_key);
+    WriteStr(os, target);
+    WritePOD(os, cost);
+    WritePOD(os, error_no);
+    WritePOD(os, payload_size);
+  }
+};
+
+/*! \brief Fill the header fields of a record from its input and result. */
+RecordHeader MakeRecordHeader(const MeasureInputNode* inp, const MeasureResultNode* res,
+                              const std::string& payload) {
+  RecordHeader header;
+  header.workload_key = inp->task->workload_key;
+  header.target = inp->task->target->str();
+  header.error_no = res->error_no;
+  header.cost = res->error_no == 0 ? FloatArrayMean(res->costs)
+                                   : std::numeric_limits<double>::infinity();
+  header.payload_size = static_cast<uint32_t>(payload.size());
+  return header;
+}
+
+/*! \brief Encode a record into the json payload, without the trailing newline. */
+std::string EncodeRecordPayload(const MeasureInput& inp, const MeasureResult& res) {
+  std::ostringstream os;
+  WriteMeasureRecords(&os, Array<MeasureInput>({inp}), Array<MeasureResult>({res}));
+  std::string payload = os.str();
+  if (!payload.empty() && payload.back() == '\n') {
+    payload.pop_back();
+  }
+  return payload;
+}
+
+int64_t FileSize(const std::string& filename) {
+  std::ifstream is(filename, std::ifstream::binary | std::ifstream::ate);
+  return is ? static_cast<int64_t>(is.tellg()) : -1;
+}
+
+/*!
+ * \brief An exclusive advisory lock on a file, held during its lifetime.
+ *  The file is created if it does not exist. It is a no-op on Windows.
+ */
+class FileLock {
+ public:
+  explicit FileLock(const std::string& filename) {
+#ifndef _WIN32
+    fd_ = open(filename.c_str(), O_RDWR | O_CREAT, 0644);
+    ICHECK_GE(fd_, 0) << "Cannot open " << filename;
+    ICHECK_EQ(flock(fd_, LOCK_EX), 0) << "Cannot lock " << filename;
+#endif
+  }
+
+  ~FileLock() {
+#ifndef _WIN32
+    // Closing the descriptor releases the lock.
+    close(fd_);
+#endif
+  }
+
+  FileLock(const FileLock&) = delete;
+  FileLock& operator=(const FileLock&) = delete;
+
+ private:
+#ifndef _WIN32
+  int fd_{-1};
+#endif
+};
+
+}  // namespace
+
+RecordStore::RecordStore(String filename) {
+  auto node = make_object<RecordStoreNode>();
+  node->filename = std::move(filename);
+  node->Open();
+  data_ = std::move(node);
+}
+
+bool RecordStoreNode::IsRecordStore(const std::string& filename) {
+  std::ifstream is(filename, std::ifstream::binary);
+  uint64_t magic;
+  return is && ReadPOD(&is, &magic) && magic == kRecordStoreMagic;
+}
+
+void RecordStoreNode::Open() {
+  // Keep other writers from appending while the store is created and its index is rebuilt.
+  FileLock lock(filename);
+  int64_t file_size = FileSize(filename);
+  if (file_size < kRecordStoreHeaderSize) {
+    ICHECK_LE(file_size, 0) << "Invalid record store " << filename;
+    std::ofstream os(filename, std::ofstream::binary | std::ofstream::trunc);
+    ICHECK(os) << "Cannot create record store " << filename;
+    WritePOD(&os, kRecordStoreMagic);
+    WritePOD(&os, static_cast<uint64_t>(0));
+    file_size = kRecordStoreHeaderSize;
+  }
+  ICHECK(IsRecordStore(filename)) << filename << " is not a record store";
+
+  index_.clear();
+  end_offset_ = kRecordStoreHeaderSize;
+  num_records_ = 0;
+
+  // Load the saved index if it does not cover more than the current file.
+  std::ifstream is(std::string(filename) + ".idx", std::ifstream::binary);
+  uint64_t magic;
+  int64_t indexed_size, num_records;
+  uint64_t num_entries;
+  if (is && ReadPOD(&is, &magic) && magic == kRecordIndexMagic && ReadPOD(&is, &indexed_size) &&
+      ReadPOD(&is, &num_records) && ReadPOD(&is, &num_entries) && indexed_size <= file_size) {
+    bool valid = true;
+    for (uint64_t i = 0; i < num_entries && valid; ++i) {
+      std::string workload_key, target;
+      IndexEntry entry;
+      valid = ReadStr(&is, &workload_key) && ReadStr(&is, &target) &&
+              ReadPOD(&is, &entry.best_offset) && ReadPOD(&is, &entry.best_cost) &&
+              ReadPOD(&is, &entry.count);
+      index_[workload_key][target] = entry;
+    }
+    if (valid) {
+      end_offset_ = indexed_size;
+      num_records_ = num_records;
+    } else {
+      index_.clear();
+    }
+  }
+
+  int64_t indexed_end = end_offset_;
+  ScanTail();
+  if (end_offset_ != indexed_end) {
+    SaveIndex();
+  }
+  Reset();
+}
+
+void RecordStoreNode::ScanTail() {
+  int64_t file_size = FileSize(filename);
+  std::ifstream is(filename, std::ifstream::binary);
+  is.seekg(end_offset_);
+  RecordHeader header;
+  while (true) {
+    int64_t offset = is.tellg();
+    if (!header.Read(&is)) {
+      break;
+    }
+    is.seekg(header.payload_size, std::ifstream::cur);
+    // Stop at a record truncated by an interrupted append. It is overwritten by the next append.
+    if (!is || is.tellg() > file_size) {
+      break;
+    }
+    AddToIndex(header.workload_key, header.target, header.cost, header.error_no, offset);
+    end_offset_ = is.tellg();
+    num_records_++;
+  }
+}
+
+void RecordStoreNode::AddToIndex(const std::string& workload_key, const std::string& target,
+                                 double cost, int error_no, int64_t offset) {
+  IndexEntry& entry = index_[workload_key][target];
+  entry.count++;
+  if (error_no == 0 && (entry.best_offset < 0 || cost < entry.best_cost)) {
+    entry.best_offset = offset;
+    entry.best_cost = cost;
+  }
+}
+
+void RecordStoreNode::SaveIndex() const {
+  std::ofstream os(std::string(filename) + ".idx", std::ofstream::binary | std::ofstream::trunc);
+  if (!os) {
+    // The store is still usable without a saved index, it is just slower to open.
+    LOG(WARNING) << "Cannot write the index of record store " << filename;
+    return;
+  }
+  WritePOD(&os, kRecordIndexMagic);
+  WritePOD(&os, end_offset_);
+  WritePOD(&os, num_records_);
+  uint64_t num_entries = 0;
+  for (const auto& kv : index_) {
+    num_entries += kv.second.size();
+  }
+  WritePOD(&os, num_entries);
+  for (const auto& kv : index_) {
+    for (const auto& target_entry : kv.second) {
+      WriteStr(&os, kv.first);
+      WriteStr(&os, target_entry.first);
+      WritePOD(&os, target_entry.second.best_offset);
+      WritePOD(&os, target_entry.second.best_cost);
+      WritePOD(&os, target_entry.second.count);
+    }
+  }
+}
+
+void RecordStoreNode::Append(const Array<MeasureInput>& inputs,
+                             const Array<MeasureResult>& results) {
+  ICHECK_EQ(inputs.size(), results.size());
+  FileLock lock(filename);
+  // Pick up records appended by other writers since the store was opened.
+  ScanTail();
+  std::fstream os(filename, std::fstream::in | std::fstream::out | std::fstream::binary);
+  ICHECK(os) << "Cannot open record store " << filename;
+  os.seekp(end_offset_);
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    std::string payload = EncodeRecordPayload(inputs[i], results[i]);
+    RecordHeader header =
+        MakeRecordHeader(inputs[i].operator->(), results[i].operator->(), payload);
+    header.Write(&os);
+    os.write(payload.data(), payload.size());
+    AddToIndex(header.workload_key, header.target, header.cost, header.error_no, end_offset_);
+    end_offset_ = os.tellp();
+    num_records_++;
+  }
+  os.close();
+  SaveIndex();
+}
+
+void RecordStoreNode::ReadRecordAt(int64_t offset, MeasureInputNode* inp,
+                                   MeasureResultNode* res) const {
+  std::ifstream is(filename, std::ifstream::binary);
+  is.seekg(offset);
+  RecordHeader header;
+  ICHECK(header.Read(&is)) << "Corrupted record at offset " << offset << " in " << filename;
+  std::string payload(header.payload_size, '\0');
+  is.read(&payload[0], header.payload_size);
+  std::string log_version;
+  ReadMeasureRecord(payload, inp, res, &log_version);
+}
+
+bool RecordStoreNode::ReadBest(const std::string& workload_key, const std::string& target,
+                               MeasureInputNode* inp, MeasureResultNode* res) {
+  auto it = index_.find(workload_key);
+  if (it == index_.end()) {
+    return false;
+  }
+  auto target_it = it->second.find(target);
+  if (target_it == it->second.end() || target_it->second.best_offset < 0) {
+    return false;
+  }
+  ReadRecordAt(target_it->second.best_offset, inp, res);
+  return true;
+}
+
+std::pair<Array<MeasureInput>, Array<MeasureResult>> RecordStoreNode::ReadBestRecords() {
+  // Return the records in the order they were appended, independent of the hash order.
+  std::vector<int64_t> offsets;
+  for (const auto& kv : index_) {
+    for (const auto& target_entry : kv.second) {
+      if (target_entry.second.best_offset >= 0) {
+        offsets.push_back(target_entry.second.best_offset);
+      }
+    }
+  }
+  std::sort(offsets.begin(), offsets.end());
+
+  Array<MeasureInput> inputs;
+  Array<MeasureResult> results;
+  for (int64_t offset : offsets) {
+    auto inp = make_object<MeasureInputNode>();
+    auto res = make_object<MeasureResultNode>();
+    ReadRecordAt(offset, inp.get(), res.get());
+    inputs.push_back(MeasureInput(inp));
+    results.push_back(MeasureResult(res));
+  }
+  return std::make_pair(inputs, results);
+}
+
+bool RecordStoreNode::ReadNext(MeasureInputNode* inp, MeasureResultNode* res) {
+  if (read_offset_ >= end_offset_) {
+    return false;
+  }
+  RecordHeader header;
+  read_stream_.clear();
+  read_stream_.seekg(read_offset_);
+  ICHECK(header.Read(&read_stream_))
+      << "Corrupted record at offset " << read_offset_ << " in " << filename;
+  std::string payload(header.payload_size, '\0');
+  read_stream_.read(&payload[0], header.payload_size);
+  read_offset_ = read_stream_.tellg();
+  std::string log_version;
+  ReadMeasureRecord(payload, inp, res, &log_version);
+  return true;
+}
+
+void RecordStoreNode::Reset() {
+  if (read_stream_.is_open()) {
+    read_stream_.close();
+  }
+  read_stream_.open(filename, std::ifstream::binary);
+  read_offset_ = kRecordStoreHeaderSize;
+}
+
+RecordToStore::RecordToStore(String filename) {
+  auto node = make_object<RecordToStoreNode>();
+  node->store = RecordStore(std::move(filename));
+  data_ = std::move(node);
+}
+
+void RecordToStoreNode::Callback(const SearchPolicy& policy, const Array<MeasureInput>& inputs,
+                                 const Array<MeasureResult>& results) {
+  store->Append(inputs, results);
+}
+
+int64_t ConvertRecordsToStore(const std::string& log_filename,
+                              const std::string& store_filename) {
+  std::ifstream infile(log_filename);
+  ICHECK(infile) << "Cannot open " << log_filename;
+  RecordStore store(store_filename);
+  // Convert in batches to bound the memory usage on large logs.
+  const size_t batch_size = 4096;
+  Array<MeasureInput> inputs;
+  Array<MeasureResult> results;
+  int64_t count = 0;
+  std::string line, log_version;
+  while (std::getline(infile, line)) {
+    if (line.empty() || line[0] == '#' || line[0] == ' ') {
+      continue;
+    }
+    auto inp = make_object<MeasureInputNode>();
+    auto res = make_object<MeasureResultNode>();
+    ReadMeasureRecord(line, inp.get(), res.get(), &log_version);
+    inputs.push_back(MeasureInput(inp));
+    results.push_back(MeasureResult(res));
+    if (inputs.size() >= batch_size) {
+      store->Append(inputs, results);
+      count += inputs.size();
+      inputs.clear();
+      results.clear();
+    }
+  }
+  if (!inputs.empty()) {
+    store->Append(inputs, results);
+    count += inputs.size();
+  }
+  return count;
+}
+
 TVM_REGISTER_GLOBAL("auto_scheduler.RecordToFile").set_body_typed([](const String& filename) {
   return RecordToFile(filename);
 });
@@ -450,6 +859,48 @@ TVM_REGISTER_GLOBAL("auto_scheduler.SaveRecords")
       WriteMeasureRecords(&ofs, in, res);
     });
 
+TVM_REGISTER_GLOBAL("auto_scheduler.RecordStore").set_body_typed([](const String& filename) {
+  return RecordStore(filename);
+});
+
+TVM_REGISTER_GLOBAL("auto_scheduler.RecordStoreAppend")
+    .set_body_typed([](RecordStore store, Array<MeasureInput> inputs,
+                       Array<MeasureResult> results) { store->Append(inputs, results); });
+
+TVM_REGISTER_GLOBAL("auto_scheduler.RecordStoreReadBest")
+    .set_body_typed([](RecordStore store, String workload_key, String target) {
+      auto inp = make_object<MeasureInputNode>();
+      auto res = make_object<MeasureResultNode>();
+      if (store->ReadBest(workload_key, target, inp.get(), res.get())) {
+        return Array<ObjectRef>{ObjectRef(inp), ObjectRef(res)};
+      } else {
+        return Array<ObjectRef>();
+      }
+    });
+
+TVM_REGISTER_GLOBAL("auto_scheduler.RecordStoreReadBestRecords")
+    .set_body_typed([](RecordStore store) {
+      const auto& res = store->ReadBestRecords();
+      return Array<ObjectRef>{res.first, res.second};
+    });
+
+TVM_REGISTER_GLOBAL("auto_scheduler.RecordStoreNumRecords").set_body_typed([](RecordStore store) {
+  return store->NumRecords();
+});
+
+TVM_REGISTER_GLOBAL("auto_scheduler.IsRecordStore").set_body_typed([](const String& filename) {
+  return RecordStoreNode::IsRecordStore(filename);
+});
+
+TVM_REGISTER_GLOBAL("auto_scheduler.RecordToStore").set_body_typed([](const String& filename) {
+  return RecordToStore(filename);
+});
+
+TVM_REGISTER_GLOBAL("auto_scheduler.ConvertRecordsToStore")
+    .set_body_typed([](const String& log_filename, const String& store_filename) {
+      return ConvertRecordsToStore(log_filename, store_filename);
+    });
+
 TVM_REGISTER_GLOBAL("auto_scheduler.SerializeMeasureInput")
     .set_body_typed([](const MeasureInput& input) {
       std::ostringstream os;
@@ -26,6 +26,14 @@
 #include <tvm/auto_scheduler/search_policy.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 #include "utils.h"
 
 namespace tvm {
@@ -34,6 +42,108 @@ namespace auto_scheduler {
 TVM_REGISTER_OBJECT_TYPE(SearchCallbackNode);
 TVM_REGISTER_OBJECT_TYPE(SearchPolicyNode);
 TVM_REGISTER_OBJECT_TYPE(PreloadMeasuredStatesNode);
+TVM_REGISTER_OBJECT_TYPE(PreloadTransferStatesNode);
+
+namespace {
+
+/*!
+ * \brief Return the function name (or the DAG hash) of a workload key.
+ * Workload keys that share it have the same compute structure and only differ in their
+ * arguments, see `auto_scheduler.utils.decode_workload_key`.
+ */
+std::string WorkloadKeyName(const std::string& workload_key) {
+  if (workload_key.size() > 2 && workload_key[0] == '[' && workload_key[1] == '"') {
+    size_t end = workload_key.find('"', 2);
+    if (end != std::string::npos) {
+      return workload_key.substr(2, end - 2);
+    }
+  }
+  return workload_key;
+}
+
+/*! \brief Return the divisor of `n` that is closest to `target` in log scale. */
+int64_t ClosestDivisor(int64_t n, int64_t target) {
+  int64_t best = 1;
+  double best_dist = std::abs(std::log(static_cast<double>(target)));
+  for (int64_t d = 1; d * d <= n; ++d) {
+    if (n % d != 0) {
+      continue;
+    }
+    for (int64_t cand : {d, n / d}) {
+      double dist = std::abs(std::log(static_cast<double>(cand) / target));
+      if (dist < best_dist) {
+        best = cand;
+        best_dist = dist;
+      }
+    }
+  }
+  return best;
+}
+
+/*!
+ * \brief Replay steps recorded for another task on the initial state of `dag`.
+ * The factors of split steps are adapted to the extents of the current task: each factor is
+ * replaced by the closest divisor of the remaining extent, starting from the innermost one.
+ * \param dag The compute dag of the current task.
+ * \param steps The recorded transform steps.
+ * \param distance Set to the accumulated log-distance between the recorded and the new extents.
+ * \return The replayed state, or NullOpt if the steps do not apply to this dag.
+ */
+Optional<State> ReplayTransferSteps(const ComputeDAG& dag, const Array<Step>& steps,
+                                    double* distance) {
+  State state = dag->init_state;
+  *distance = 0.0;
+  try {
+    for (const auto& step : steps) {
+      Step new_step = step;
+      if (auto ps = step.as<SplitStepNode>()) {
+        if (ps->stage_id >= static_cast<int>(state->stages.size()) ||
+            ps->iter_id >= static_cast<int>(state->stages[ps->stage_id]->iters.size())) {
+          return NullOpt;
+        }
+        Range range = state->stages[ps->stage_id]->iters[ps->iter_id]->range;
+        if (!range.defined()) {
+          // Iterators of stages moved by compute_at lose their ranges until the next InferBound
+          state = dag.InferBound(state);
+          range = state->stages[ps->stage_id]->iters[ps->iter_id]->range;
+        }
+        const IntImmNode* new_extent = range.defined() ? range->extent.as<IntImmNode>() : nullptr;
+        const IntImmNode* old_extent =
+            ps->extent.defined() ? ps->extent.value().as<IntImmNode>() : nullptr;
+        bool all_defined = true;
+        for (const auto& len : ps->lengths) {
+          all_defined &= len.defined();
+        }
+        if (new_extent != nullptr && old_extent != nullptr && all_defined &&
+            new_extent->value > 0 && old_extent->value > 0) {
+          *distance += std::abs(std::log(static_cast<double>(new_extent->value) /
+                                         static_cast<double>(old_extent->value)));
+          size_t n = ps->lengths.size();
+          std::vector<Optional<Integer>> lengths(n);
+          int64_t remain = new_extent->value;
+          for (size_t i = 0; i < n; ++i) {
+            // Visit the lengths from the innermost one to the outermost one
+            size_t idx = ps->inner_to_outer ? i : n - 1 - i;
+            int64_t factor =
+                ClosestDivisor(remain, std::max<int64_t>(ps->lengths[idx].value()->value, 1));
+            lengths[idx] = Integer(factor);
+            remain /= factor;
+          }
+          new_step = SplitStep(ps->stage_id, ps->iter_id, range->extent,
+                               Array<Optional<Integer>>(lengths), ps->inner_to_outer);
+        }
+      }
+      state.CopyOnWrite()->transform_steps.push_back(new_step);
+      StepApplyToState(new_step, &state, dag);
+    }
+    state = dag.InferBound(state);
+  } catch (Error&) {
+    return NullOpt;
+  }
+  return state;
+}
+
+}  // namespace
 
 void SearchPolicyNode::PreloadMeasuredStates(const String& log_file) {
   RecordReader reader = RecordReader(log_file);
@@ -62,9 +172,7 @@ void SearchPolicyNode::PreloadMeasuredStates(const String& log_file) {
     measured_states = search_task->compute_dag.InferBound(measured_states);
     for (size_t i = 0; i < measured_states.size(); i++) {
       auto& state = measured_states[i];
-      const auto& state_str = state.ToStr();
-      if (!measured_states_set_.count(state_str)) {
-        measured_states_set_.insert(state_str);
+      if (measured_states_set_.Insert(state)) {
         if (measured_throughputs[i] != 0.0) {
           measured_states_vector_.emplace_back(std::move(state));
           measured_states_throughputs_.emplace_back(measured_throughputs[i]);
@@ -81,6 +189,76 @@ void SearchPolicyNode::PreloadMeasuredStates(const String& log_file) {
   }
 }
 
+void SearchPolicyNode::PreloadTransferStates(const String& log_file, int max_states) {
+  // Keep only the best few records of each other workload as candidates
+  const int kCandidatesPerWorkload = 3;
+
+  RecordReader reader = RecordReader(log_file);
+  const auto& res = reader->ReadLines(-1);
+  ICHECK_EQ(res.first.size(), res.second.size());
+
+  // Only workloads of the same compute function (or DAG) have the structure of this task
+  const std::string name = WorkloadKeyName(search_task->workload_key);
+
+  // workload_key -> [(throughput, record index)]
+  std::map<std::string, std::vector<std::pair<double, size_t>>> per_workload;
+  for (size_t i = 0; i < res.first.size(); i++) {
+    const auto& inp = res.first[i];
+    if (inp->task->workload_key == search_task->workload_key ||
+        WorkloadKeyName(inp->task->workload_key) != name ||
+        inp->task->target->kind->name.compare(search_task->target->kind->name) != 0 ||
+        res.second[i]->error_no != 0) {
+      continue;
+    }
+    per_workload[inp->task->workload_key].emplace_back(1.0 / FloatArrayMean(res.second[i]->costs),
+                                                      i);
+  }
+
+  // (distance, rank in its workload, state)
+  std::vector<std::tuple<double, int, State>> candidates;
+  StateSet seen;
+  for (auto& kv : per_workload) {
+    auto& records = kv.second;
+    std::sort(records.begin(), records.end(),
+              [](const std::pair<double, size_t>& a, const std::pair<double, size_t>& b) {
+                return a.first > b.first;
+              });
+    int rank = 0;
+    for (const auto& record : records) {
+      if (rank >= kCandidatesPerWorkload) {
+        break;
+      }
+      double distance;
+      Optional<State> state = ReplayTransferSteps(
+          search_task->compute_dag, res.first[record.second]->state->transform_steps, &distance);
+      if (!state) {
+        // The steps do not match the structure of this task. Skip the whole workload.
+        break;
+      }
+      if (measured_states_set_.Contains(state.value()) || !seen.Insert(state.value())) {
+        continue;
+      }
+      candidates.emplace_back(distance, rank++, state.value());
+    }
+  }
+
+  std::sort(candidates.begin(), candidates.end(),
+            [](const std::tuple<double, int, State>& a, const std::tuple<double, int, State>& b) {
+              if (std::get<1>(a) != std::get<1>(b)) {
+                return std::get<1>(a) < std::get<1>(b);
+              }
+              return std::get<0>(a) < std::get<0>(b);
+            });
+  transfer_states_.clear();
+  for (size_t i = 0; i < candidates.size() && static_cast<int>(i) < max_states; ++i) {
+    transfer_states_.push_back(std::get<2>(candidates[i]));
+  }
+
+  StdCout(verbose) << "SearchPolicy: Transferred " << transfer_states_.size() << " states from "
+                   << per_workload.size() << " other workloads in " << log_file << " to "
+                   << search_task->workload_key << std::endl;
+}
+
 void SearchPolicyNode::RunCallbacks(const Array<SearchCallback>& callbacks) {
   for (const auto& callback : callbacks) {
     callback->Callback(this);
@@ -97,6 +275,17 @@ void PreloadMeasuredStatesNode::Callback(SearchPolicyNode* policy) {
   policy->PreloadMeasuredStates(filename);
 }
 
+PreloadTransferStates::PreloadTransferStates(String filename, int max_states) {
+  auto node = make_object<PreloadTransferStatesNode>();
+  node->filename = std::move(filename);
+  node->max_states = max_states;
+  data_ = std::move(node);
+}
+
+void PreloadTransferStatesNode::Callback(SearchPolicyNode* policy) {
+  policy->PreloadTransferStates(filename, max_states);
+}
+
 TVM_REGISTER_GLOBAL("auto_scheduler.SearchPolicyRunCallbacks")
     .set_body_typed([](SearchPolicy policy, Optional<Array<SearchCallback>> callbacks) {
       if (callbacks) {
@@ -119,5 +308,10 @@ TVM_REGISTER_GLOBAL("auto_scheduler.PreloadMeasuredStates").set_body_typed([](St
   return PreloadMeasuredStates(filename);
 });
 
+TVM_REGISTER_GLOBAL("auto_scheduler.PreloadTransferStates")
+    .set_body_typed([](String filename, int max_states) {
+      return PreloadTransferStates(filename, max_states);
+    });
+
 }  // namespace auto_scheduler
 }  // namespace tvm
@@ -191,7 +191,7 @@ State SketchPolicyNode::Search(int n_trials, int early_stopping, int num_measure
       PrintTitle("Search", verbose);
       best_states = SearchOneRound(num_random * 3, &random_states);
 
-      // Infer bound. This is necessary for computing the correct ToStr() for redundancy check
+      // Infer bound. This is necessary for the measured states to carry correct loop bounds
       best_states = search_task->compute_dag.InferBound(best_states);
       random_states = search_task->compute_dag.InferBound(random_states);
 
@@ -252,7 +252,7 @@ std::pair<Array<MeasureInput>, Array<MeasureResult>> SketchPolicyNode::ContinueS
   PrintTitle("Search", verbose);
   best_states = SearchOneRound(num_random * 3, &random_states);
 
-  // Infer bound. This is necessary for computing the correct ToStr() for redundancy check
+  // Infer bound. This is necessary for the measured states to carry correct loop bounds
   best_states = search_task->compute_dag.InferBound(best_states);
   random_states = search_task->compute_dag.InferBound(random_states);
 
@@ -304,11 +304,27 @@ Array<State> SketchPolicyNode::SearchOneRound(int num_random_states, Array<State
   for (int i = 0; i < num_use_measured; i++) {
     init_population.push_back(measured_states_vector_[indices[i]]);
   }
+  // Also insert the states transferred from similar tasks
+  for (const auto& state : transfer_states_) {
+    init_population.push_back(state);
+  }
   // Sample some random states for eps-greedy
   if (num_random_states > 0 && random_states != nullptr) {
     *random_states = RandomSampleStates(init_population, &rand_gen, num_random_states);
   }
-  return EvolutionarySearch(init_population, num_measure_per_iter_ * 2);
+  Array<State> best_states = EvolutionarySearch(init_population, num_measure_per_iter_ * 2);
+
+  // The cost model knows little about a new task, so propose the transferred states for
+  // measurement directly. They join the measured states after this round.
+  if (!transfer_states_.empty()) {
+    Array<State> warm_start(transfer_states_.begin(), transfer_states_.end());
+    transfer_states_.clear();
+    for (const auto& state : best_states) {
+      warm_start.push_back(state);
+    }
+    best_states = std::move(warm_start);
+  }
+  return best_states;
 }
 
 Array<State> SketchPolicyNode::GenerateSketches() {
@@ -395,7 +411,7 @@ Array<State> SketchPolicyNode::SampleInitPopulation(const Array<State>& sketches
     rand_gens.push_back(std::mt19937(rand_gen()));
   }
 
-  std::unordered_set<std::string> explored_state_strs;
+  StateSet explored_states;
   size_t iter = 1;
   size_t unchange_cnt = 0;
   while (static_cast<int>(out_states.size()) < sample_init_min_pop_) {
@@ -441,9 +457,7 @@ Array<State> SketchPolicyNode::SampleInitPopulation(const Array<State>& sketches
       program_cost_model->Predict(search_task, cand_states, &pop_scores);
 
       for (size_t i = 0; i < cand_states.size(); i++) {
-        const auto state_str = cand_states[i].ToStr();
-        if (pop_scores[i] > -1e10 && explored_state_strs.count(state_str) == 0) {
-          explored_state_strs.insert(state_str);
+        if (pop_scores[i] > -1e10 && explored_states.Insert(cand_states[i])) {
           out_states.push_back(std::move(cand_states[i]));
           unchange_cnt = 0;  // Reset the counter once we found a valid state
         } else {
@@ -513,7 +527,7 @@ Array<State> SketchPolicyNode::EvolutionarySearch(const Array<State>& init_popul
     return left.second > right.second;
   };
   std::vector<StateHeapItem> heap;
-  std::unordered_set<std::string> in_heap(measured_states_set_);
+  StateSet in_heap(measured_states_set_);
   heap.reserve(out_size);
 
   // auxiliary global variables
@@ -543,17 +557,15 @@ Array<State> SketchPolicyNode::EvolutionarySearch(const Array<State>& init_popul
 
     for (size_t i = 0; i < pnow->size(); ++i) {
       const State& state = (*pnow)[i];
-      std::string state_str = state.ToStr();
 
-      if (in_heap.count(state_str) == 0) {
+      if (!in_heap.Contains(state)) {
         if (static_cast<int>(heap.size()) < out_size) {
           heap.emplace_back((*pnow)[i], pop_scores[i]);
           std::push_heap(heap.begin(), heap.end(), cmp);
-          in_heap.insert(state_str);
+          in_heap.Insert(state);
         } else if (pop_scores[i] > heap.front().second) {
-          std::string old_state_str = heap.front().first.ToStr();
-          in_heap.erase(old_state_str);
-          in_heap.insert(state_str);
+          in_heap.Erase(heap.front().first);
+          in_heap.Insert(state);
 
           std::pop_heap(heap.begin(), heap.end(), cmp);
           heap.back() = StateHeapItem(state, pop_scores[i]);
@@ -660,9 +672,7 @@ Array<MeasureInput> SketchPolicyNode::PickStatesWithEpsGreedy(const Array<State>
     }
 
     // Check if it has already been measured
-    std::string state_str = state.ToStr();
-    if (!measured_states_set_.count(state_str)) {
-      measured_states_set_.insert(std::move(state_str));
+    if (measured_states_set_.Insert(state)) {
       measured_states_vector_.push_back(state);
       inputs.push_back(MeasureInput(search_task, state));
     }
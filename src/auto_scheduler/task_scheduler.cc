@@ -0,0 +1,335 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file auto_scheduler/task_scheduler.cc
+ * \brief The task scheduler that allocates the time resources when tuning multiple tasks together.
+ */
+
+#include <tvm/auto_scheduler/task_scheduler.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+#include "utils.h"
+
+namespace tvm {
+namespace auto_scheduler {
+
+TVM_REGISTER_NODE_TYPE(TaskSchedulerDecisionNode);
+TVM_REGISTER_NODE_TYPE(TaskSchedulerNode);
+
+/*! \brief The latency of a task that has no valid measurement yet. */
+static constexpr double kInvalidCost = 1e10;
+
+TaskScheduler::TaskScheduler(Array<SearchTask> tasks, Array<FloatImm> task_weights,
+                             Array<String> task_tags, String strategy, double alpha, double beta,
+                             int backward_window_size) {
+  ICHECK(!tasks.empty()) << "No tasks";
+  ICHECK(task_weights.empty() || task_weights.size() == tasks.size());
+  ICHECK(task_tags.empty() || task_tags.size() == tasks.size());
+  ICHECK(strategy == "gradient" || strategy == "round-robin")
+      << "Invalid strategy: " << strategy;
+
+  auto node = make_object<TaskSchedulerNode>();
+  size_t n_tasks = tasks.size();
+  node->tasks = std::move(tasks);
+  node->task_weights = std::move(task_weights);
+  node->task_tags = std::move(task_tags);
+  node->strategy = std::move(strategy);
+  node->alpha = alpha;
+  node->beta = beta;
+  node->backward_window_size = backward_window_size;
+
+  node->task_cts.assign(n_tasks, 0);
+  node->task_best_cts.assign(n_tasks, 0);
+  node->task_costs_history.assign(n_tasks, {});
+  node->best_costs.assign(n_tasks, kInvalidCost);
+
+  // Build the similarity groups
+  node->cur_tags_.assign(n_tasks, "");
+  for (size_t i = 0; i < node->task_tags.size(); ++i) {
+    std::string tag = node->task_tags[i];
+    if (!tag.empty()) {
+      node->cur_tags_[i] = tag;
+      node->group_task_ids_[tag].push_back(i);
+    }
+  }
+  data_ = std::move(node);
+}
+
+double TaskSchedulerNode::ComputeScore(const std::vector<double>& costs) const {
+  double score = 0;
+  for (size_t i = 0; i < costs.size(); ++i) {
+    score += costs[i] * (task_weights.empty() ? 1.0 : task_weights[i]->value);
+  }
+  return score;
+}
+
+int TaskSchedulerNode::NextTask(int remaining_trials) {
+  int n_tasks = static_cast<int>(tasks.size());
+  auto node = make_object<TaskSchedulerDecisionNode>();
+  node->round = static_cast<int>(decisions.size());
+  node->score = ComputeScore(best_costs);
+  node->num_trials = ct;
+  node->remaining_trials = remaining_trials;
+
+  // Warm up: tune every task once first
+  int task_idx = -1;
+  for (int i = 0; i < n_tasks; ++i) {
+    if (task_cts[i] == 0) {
+      task_idx = i;
+      node->reason = "warmup";
+      break;
+    }
+  }
+
+  if (task_idx == -1 && strategy == "round-robin") {
+    do {
+      rr_cursor_ = (rr_cursor_ + 1) % n_tasks;
+    } while (dead_tasks.count(rr_cursor_));
+    task_idx = rr_cursor_;
+    node->reason = "round-robin";
+  } else if (task_idx == -1) {
+    std::vector<double> gradients(n_tasks, 0.0);
+    for (int i = 0; i < n_tasks; ++i) {
+      if (dead_tasks.count(i)) {
+        continue;
+      }
+
+      // The chain rule term (d score / d g_i) is the weight of the task
+      double chain_grad = task_weights.empty() ? 1.0 : task_weights[i]->value;
+
+      // (g_i(t_i) - g_i(t_i - window)) / window
+      double backward_grad = 0;
+      const auto& history = task_costs_history[i];
+      if (task_cts[i] - 1 < static_cast<int>(history.size()) &&
+          task_cts[i] - 1 - backward_window_size >= 0) {
+        backward_grad =
+            (history[task_cts[i] - 1] - history[task_cts[i] - 1 - backward_window_size]) /
+            backward_window_size;
+      }
+
+      // (g_i(t_i + 1) - g_i(t_i)) / 1, estimated optimistically
+      double g_next_1 = best_costs[i] - best_costs[i] / task_cts[i];
+      double g_next_2 = beta * 1e30;
+      auto it = cur_tags_[i].empty() ? group_task_ids_.end() : group_task_ids_.find(cur_tags_[i]);
+      if (it != group_task_ids_.end() && it->second.size() > 1) {
+        double best_flops = 0;
+        for (int j : it->second) {
+          best_flops = std::max(best_flops, tasks[j]->compute_dag->flop_ct / best_costs[j]);
+        }
+        g_next_2 = beta * tasks[i]->compute_dag->flop_ct / best_flops;
+      }
+      double forward_grad = std::min(g_next_1, g_next_2) - best_costs[i];
+
+      gradients[i] = chain_grad * (alpha * backward_grad + (1 - alpha) * forward_grad);
+    }
+
+    auto minmax = std::minmax_element(gradients.begin(), gradients.end());
+    if (*minmax.first == *minmax.second) {
+      std::vector<int> alive;
+      for (int i = 0; i < n_tasks; ++i) {
+        if (!dead_tasks.count(i)) {
+          alive.push_back(i);
+        }
+      }
+      task_idx = alive[std::uniform_int_distribution<size_t>(0, alive.size() - 1)(rand_gen_)];
+      node->reason = "random";
+    } else {
+      task_idx = static_cast<int>(minmax.first - gradients.begin());
+      node->reason = "gradient";
+    }
+    for (double grad : gradients) {
+      node->gradients.push_back(FloatImm(DataType::Float(64), grad));
+    }
+  }
+
+  node->task_idx = task_idx;
+  decisions.push_back(TaskSchedulerDecision(node));
+  return task_idx;
+}
+
+void TaskSchedulerNode::Update(int task_idx, const Array<MeasureInput>& inputs,
+                               const Array<MeasureResult>& results, int num_measures_per_round,
+                               int per_task_early_stopping) {
+  task_cts[task_idx]++;
+  for (const auto& res : results) {
+    if (res->error_no != static_cast<int>(MeasureErrorNO::kNoError)) {
+      continue;
+    }
+    double cost = FloatArrayMean(res->costs);
+    if (cost < best_costs[task_idx]) {
+      task_best_cts[task_idx] = task_cts[task_idx];
+      best_costs[task_idx] = cost;
+    }
+  }
+
+  // Stop tuning this task if its search space has been fully explored or it has no improvement
+  // for a long while.
+  int no_change_trials = (task_cts[task_idx] - task_best_cts[task_idx]) * num_measures_per_round;
+  if (inputs.empty() ||
+      (per_task_early_stopping >= 0 && no_change_trials > per_task_early_stopping)) {
+    dead_tasks.insert(task_idx);
+  }
+
+  task_costs_history[task_idx].push_back(best_costs[task_idx]);
+  ct += inputs.size();
+}
+
+void TaskSchedulerNode::AdjustSimilarityGroup(int task_idx) {
+  if (cur_tags_[task_idx].empty()) {
+    return;
+  }
+  auto& group_ids = group_task_ids_[cur_tags_[task_idx]];
+  if (group_ids.size() <= 1) {
+    return;
+  }
+
+  double best_group_flops = 0;
+  int max_other_cts = 0;
+  for (int j : group_ids) {
+    best_group_flops = std::max(best_group_flops, tasks[j]->compute_dag->flop_ct / best_costs[j]);
+    if (j != task_idx) {
+      max_other_cts = std::max(max_other_cts, task_cts[j]);
+    }
+  }
+  double cur_flops = tasks[task_idx]->compute_dag->flop_ct / best_costs[task_idx];
+
+  // If we tune a task for many times but it still cannot achieve a similar speed to the fastest
+  // one in its group, this task is actually not similar to other tasks in its group.
+  if (cur_flops < best_group_flops / beta && task_cts[task_idx] > 5 + max_other_cts) {
+    group_ids.erase(std::find(group_ids.begin(), group_ids.end(), task_idx));
+    cur_tags_[task_idx] = "";
+  }
+}
+
+void TaskSchedulerNode::Tune(const Array<SearchPolicy>& search_policies, ProgramMeasurer measurer,
+                             int num_measure_trials, int num_measures_per_round,
+                             int early_stopping, int per_task_early_stopping,
+                             Optional<runtime::PackedFunc> round_callback) {
+  ICHECK_EQ(search_policies.size(), tasks.size());
+  ICHECK_GT(num_measures_per_round, 0);
+
+  int best_ct = ct;
+  double best_score = ComputeScore(best_costs);
+  while (ct < num_measure_trials && dead_tasks.size() < tasks.size()) {
+    int task_idx = NextTask(num_measure_trials - ct);
+    bool warmup = decisions.back()->reason == "warmup";
+
+    if (round_callback) {
+      round_callback.value()(task_idx, false);
+    }
+    Array<MeasureInput> inputs;
+    Array<MeasureResult> results;
+    std::tie(inputs, results) =
+        search_policies[task_idx]->ContinueSearchOneRound(num_measures_per_round, measurer);
+    Update(task_idx, inputs, results, num_measures_per_round, per_task_early_stopping);
+    if (!warmup) {
+      AdjustSimilarityGroup(task_idx);
+    }
+    if (round_callback) {
+      round_callback.value()(task_idx, true);
+    }
+
+    double score = ComputeScore(best_costs);
+    if (warmup || score < best_score) {
+      best_score = score;
+      best_ct = ct;
+    } else if (early_stopping >= 0 && ct - best_ct >= early_stopping &&
+               std::all_of(best_costs.begin(), best_costs.end(),
+                           [](double cost) { return cost < 1e9; })) {
+      StdCout(measurer->verbose) << "Stop early since no performance improvement in the last "
+                                 << early_stopping << " measurement trials." << std::endl;
+      break;
+    }
+  }
+}
+
+TVM_REGISTER_GLOBAL("auto_scheduler.TaskScheduler")
+    .set_body_typed([](Array<SearchTask> tasks, Array<FloatImm> task_weights,
+                       Array<String> task_tags, String strategy, double alpha, double beta,
+                       int backward_window_size) {
+      return TaskScheduler(tasks, task_weights, task_tags, strategy, alpha, beta,
+                           backward_window_size);
+    });
+
+TVM_REGISTER_GLOBAL("auto_scheduler.TaskSchedulerTune")
+    .set_body_typed([](TaskScheduler scheduler, Array<SearchPolicy> search_policies,
+                       ProgramMeasurer measurer, int num_measure_trials, int num_measures_per_round,
+                       int early_stopping, int per_task_early_stopping,
+                       Optional<runtime::PackedFunc> round_callback) {
+      scheduler->Tune(search_policies, measurer, num_measure_trials, num_measures_per_round,
+                      early_stopping, per_task_early_stopping, round_callback);
+    });
+
+TVM_REGISTER_GLOBAL("auto_scheduler.TaskSchedulerNextTask")
+    .set_body_typed([](TaskScheduler scheduler, int remaining_trials) {
+      return scheduler->NextTask(remaining_trials);
+    });
+
+TVM_REGISTER_GLOBAL("auto_scheduler.TaskSchedulerUpdate")
+    .set_body_typed([](TaskScheduler scheduler, int task_idx, Array<MeasureInput> inputs,
+                       Array<MeasureResult> results, int num_measures_per_round,
+                       int per_task_early_stopping) {
+      scheduler->Update(task_idx, inputs, results, num_measures_per_round,
+                        per_task_early_stopping);
+    });
+
+TVM_REGISTER_GLOBAL("auto_scheduler.TaskSchedulerSetStatus")
+    .set_body_typed([](TaskScheduler scheduler, Array<Integer> task_cts,
+                       Array<Integer> task_best_cts, Array<FloatImm> best_costs,
+                       Array<Integer> dead_tasks, int ct) {
+      TaskSchedulerNode* node = scheduler.operator->();
+      size_t n_tasks = node->tasks.size();
+      ICHECK(task_cts.size() == n_tasks && task_best_cts.size() == n_tasks &&
+             best_costs.size() == n_tasks);
+      for (size_t i = 0; i < n_tasks; ++i) {
+        node->task_cts[i] = task_cts[i]->value;
+        node->task_best_cts[i] = task_best_cts[i]->value;
+        node->best_costs[i] = best_costs[i]->value;
+        node->task_costs_history[i] = {best_costs[i]->value};
+      }
+      node->dead_tasks.clear();
+      for (const auto& idx : dead_tasks) {
+        node->dead_tasks.insert(idx->value);
+      }
+      node->ct = ct;
+    });
+
+TVM_REGISTER_GLOBAL("auto_scheduler.TaskSchedulerGetStatus")
+    .set_body_typed([](TaskScheduler scheduler) {
+      Array<Integer> task_cts, task_best_cts, dead_tasks;
+      Array<FloatImm> best_costs;
+      for (size_t i = 0; i < scheduler->tasks.size(); ++i) {
+        task_cts.push_back(scheduler->task_cts[i]);
+        task_best_cts.push_back(scheduler->task_best_cts[i]);
+        best_costs.push_back(FloatImm(DataType::Float(64), scheduler->best_costs[i]));
+      }
+      for (int idx : scheduler->dead_tasks) {
+        dead_tasks.push_back(idx);
+      }
+      return Array<ObjectRef>{task_cts, task_best_cts, best_costs, dead_tasks,
+                              Integer(scheduler->ct)};
+    });
+
+}  // namespace auto_scheduler
+}  // namespace tvm
@@ -214,6 +214,7 @@ Array<tvm::transform::Pass> CreatePassList(bool disable_loop_partition, bool for
   Array<tvm::transform::Pass> pass_list = user_lower_phase0;
 
   // PHASE 1
+  pass_list.push_back(tir::transform::AutoCacheTiling());
   if (for_te_schedule) {
     pass_list.push_back(tir::transform::InjectPrefetch());
     pass_list.push_back(tir::transform::StorageFlatten(64, instrument_bound_checkers));
@@ -226,6 +227,7 @@ Array<tvm::transform::Pass> CreatePassList(bool disable_loop_partition, bool for
   }
   pass_list.push_back(tir::transform::BF16Legalize());
   pass_list.push_back(tir::transform::NarrowDataType(32));
+  pass_list.push_back(tir::transform::SpecializeShapes());
   pass_list.push_back(tir::transform::Simplify());
 
   // Add user-defined phase-1 passes
@@ -240,6 +242,7 @@ Array<tvm::transform::Pass> CreatePassList(bool disable_loop_partition, bool for
   pass_list.push_back(tir::transform::InjectVirtualThread());
   pass_list.push_back(tir::transform::InjectDoubleBuffer());
   pass_list.push_back(tir::transform::StorageRewrite());
+  pass_list.push_back(tir::transform::AutoPrefetch());
   pass_list.push_back(tir::transform::UnrollLoop());
 
   // Add user-defined phase-2 passes
@@ -27,7 +27,14 @@
 #include <tvm/node/repr_printer.h>
 #include <tvm/runtime/registry.h>
 
+#include <fstream>
 #include <stack>
+#include <unordered_set>
+#include <vector>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
 
 namespace tvm {
 namespace instrument {
@@ -199,9 +206,8 @@ TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
       p->stream << node->name;
     });
 
-/*! \brief PassProfile stores profiling information for a given pass and its sub-passes. */
-struct PassProfile {
-  // TODO(@altanh): expose PassProfile through TVM Object API
+/*! \brief PassProfileEntry stores profiling information for a given pass and its sub-passes. */
+struct PassProfileEntry {
   using Clock = std::chrono::steady_clock;
   using Duration = std::chrono::duration<double, std::micro>;
   using Time = std::chrono::time_point<Clock>;
@@ -214,25 +220,36 @@ struct PassProfile {
   Time end;
   /*! \brief The total duration of the pass, i.e. end - start. */
   Duration duration;
+  /*! \brief The resident memory when the pass was entered, 0 if not tracked. */
+  int64_t start_memory{0};
+  /*! \brief The resident memory when the pass completed, 0 if not tracked. */
+  int64_t end_memory{0};
+  /*! \brief The number of IR nodes before the pass, -1 if not tracked. */
+  int64_t ir_size_before{-1};
+  /*! \brief The number of IR nodes after the pass, -1 if not tracked. */
+  int64_t ir_size_after{-1};
   /*! \brief PassProfiles for all sub-passes invoked during the execution of the pass. */
-  std::vector<PassProfile> children;
+  std::vector<PassProfileEntry> children;
 
-  explicit PassProfile(String name)
+  explicit PassProfileEntry(String name)
       : name(name), start(Clock::now()), end(Clock::now()), children() {}
 
-  /*! \brief Gets the PassProfile of the currently executing pass. */
-  static PassProfile* Current();
-  /*! \brief Pushes a new PassProfile with the given pass name. */
+  /*! \brief Gets the PassProfileEntry of the currently executing pass. */
+  static PassProfileEntry* Current();
+  /*! \brief Pushes a new PassProfileEntry with the given pass name. */
   static void EnterPass(String name);
-  /*! \brief Pops the current PassProfile. */
+  /*! \brief Pops the current PassProfileEntry. */
   static void ExitPass();
+
+  /*! \brief Convert the profile tree rooted at this entry to a PassProfile object. */
+  PassProfile ToObject() const;
 };
 
 struct PassProfileThreadLocalEntry {
-  /*! \brief The placeholder top-level PassProfile. */
-  PassProfile root;
-  /*! \brief The stack of PassProfiles for nested passes currently running. */
-  std::stack<PassProfile*> profile_stack;
+  /*! \brief The placeholder top-level PassProfileEntry. */
+  PassProfileEntry root;
+  /*! \brief The stack of PassProfileEntries for nested passes currently running. */
+  std::stack<PassProfileEntry*> profile_stack;
 
   PassProfileThreadLocalEntry() : root("root") {}
 };
@@ -240,21 +257,21 @@ struct PassProfileThreadLocalEntry {
 /*! \brief Thread local store to hold the pass profiling data. */
 typedef dmlc::ThreadLocalStore<PassProfileThreadLocalEntry> PassProfileThreadLocalStore;
 
-void PassProfile::EnterPass(String name) {
-  PassProfile* cur = PassProfile::Current();
+void PassProfileEntry::EnterPass(String name) {
+  PassProfileEntry* cur = PassProfileEntry::Current();
   cur->children.emplace_back(name);
   PassProfileThreadLocalStore::Get()->profile_stack.push(&cur->children.back());
 }
 
-void PassProfile::ExitPass() {
-  PassProfile* cur = PassProfile::Current();
+void PassProfileEntry::ExitPass() {
+  PassProfileEntry* cur = PassProfileEntry::Current();
   ICHECK_NE(cur->name, "root") << "mismatched enter/exit for pass profiling";
-  cur->end = PassProfile::Clock::now();
-  cur->duration = std::chrono::duration_cast<PassProfile::Duration>(cur->end - cur->start);
+  cur->end = PassProfileEntry::Clock::now();
+  cur->duration = std::chrono::duration_cast<PassProfileEntry::Duration>(cur->end - cur->start);
   PassProfileThreadLocalStore::Get()->profile_stack.pop();
 }
 
-PassProfile* PassProfile::Current() {
+PassProfileEntry* PassProfileEntry::Current() {
   PassProfileThreadLocalEntry* entry = PassProfileThreadLocalStore::Get();
   if (!entry->profile_stack.empty()) {
     return entry->profile_stack.top();
@@ -263,6 +280,93 @@ PassProfile* PassProfile::Current() {
   }
 }
 
+PassProfile PassProfileEntry::ToObject() const {
+  auto n = make_object<PassProfileNode>();
+  n->name = name;
+  n->duration_us = duration.count();
+  Duration self_duration = duration;
+  Array<ObjectRef> children_objs;
+  for (const PassProfileEntry& child : children) {
+    self_duration -= child.duration;
+    children_objs.push_back(child.ToObject());
+  }
+  n->self_duration_us = self_duration.count();
+  n->memory_delta_bytes = end_memory - start_memory;
+  n->ir_size_before = ir_size_before;
+  n->ir_size_after = ir_size_after;
+  n->children = std::move(children_objs);
+  return PassProfile(n);
+}
+
+TVM_REGISTER_NODE_TYPE(PassProfileNode);
+
+/*!
+ * \brief Get the resident memory of the current process in bytes.
+ * \return The resident memory, or 0 when it cannot be queried on this platform.
+ */
+int64_t GetResidentMemoryBytes() {
+#ifdef __linux__
+  std::ifstream fin("/proc/self/statm");
+  int64_t total_pages, resident_pages;
+  if (fin >> total_pages >> resident_pages) {
+    return resident_pages * static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+  }
+#endif
+  return 0;
+}
+
+/*!
+ * \brief Count the number of distinct IR nodes reachable from the module.
+ * \note The traversal uses an explicit stack so that deep dataflow graphs do not overflow.
+ */
+class IRSizeCounter : public AttrVisitor {
+ public:
+  int64_t Count(const IRModule& mod) {
+    for (const auto& kv : mod->functions) {
+      Push(kv.second.get());
+    }
+    while (!stack_.empty()) {
+      const Object* node = stack_.back();
+      stack_.pop_back();
+      if (const auto* arr = node->as<ArrayNode>()) {
+        for (const ObjectRef& elem : *arr) {
+          Push(elem.get());
+        }
+      } else if (const auto* map = node->as<MapNode>()) {
+        for (const auto& kv : *map) {
+          Push(kv.first.get());
+          Push(kv.second.get());
+        }
+      } else {
+        reflection_->VisitAttrs(const_cast<Object*>(node), this);
+      }
+    }
+    return static_cast<int64_t>(visited_.size());
+  }
+
+  void Visit(const char* key, double* value) final {}
+  void Visit(const char* key, int64_t* value) final {}
+  void Visit(const char* key, uint64_t* value) final {}
+  void Visit(const char* key, int* value) final {}
+  void Visit(const char* key, bool* value) final {}
+  void Visit(const char* key, std::string* value) final {}
+  void Visit(const char* key, void** value) final {}
+  void Visit(const char* key, DataType* value) final {}
+  void Visit(const char* key, runtime::NDArray* value) final {}
+  void Visit(const char* key, ObjectRef* value) final { Push(value->get()); }
+
+ private:
+  void Push(const Object* node) {
+    if (node != nullptr && visited_.insert(node).second) {
+      stack_.push_back(node);
+    }
+  }
+
+  ReflectionVTable* reflection_ = ReflectionVTable::Global();
+  std::unordered_set<const Object*> visited_;
+  std::vector<const Object*> stack_;
+};
+
 String RenderPassProfiles() {
   PassProfileThreadLocalEntry* entry = PassProfileThreadLocalStore::Get();
   CHECK(entry->profile_stack.empty()) << "cannot print pass profile while still in a pass!";
@@ -273,10 +377,10 @@ String RenderPassProfiles() {
   }
 
   // (depth, parent_duration, pass)
-  std::stack<std::tuple<size_t, PassProfile::Duration, PassProfile*>> profiles;
+  std::stack<std::tuple<size_t, PassProfileEntry::Duration, PassProfileEntry*>> profiles;
 
   // push top level passes
-  PassProfile::Duration top_dur(0);
+  PassProfileEntry::Duration top_dur(0);
   for (auto it = entry->root.children.begin(); it != entry->root.children.end(); ++it) {
     top_dur += it->duration;
   }
@@ -289,8 +393,8 @@ String RenderPassProfiles() {
 
   while (profiles.size() > 0) {
     size_t depth;
-    PassProfile::Duration parent_duration;
-    PassProfile* profile;
+    PassProfileEntry::Duration parent_duration;
+    PassProfileEntry* profile;
     std::tie(depth, parent_duration, profile) = profiles.top();
     profiles.pop();
 
@@ -300,7 +404,7 @@ String RenderPassProfiles() {
     }
 
     // calculate time spent in pass itself (excluding sub-passes), and push children
-    PassProfile::Duration self_duration = profile->duration;
+    PassProfileEntry::Duration self_duration = profile->duration;
     for (auto it = profile->children.rbegin(); it != profile->children.rend(); ++it) {
       self_duration -= it->duration;
       profiles.push(std::make_tuple(depth + 1, profile->duration, &*it));
@@ -320,22 +424,53 @@ String RenderPassProfiles() {
 
 TVM_REGISTER_GLOBAL("instrument.RenderTimePassProfiles").set_body_typed(RenderPassProfiles);
 
-TVM_REGISTER_GLOBAL("instrument.MakePassTimingInstrument").set_body_typed([]() {
-  auto run_before_pass = [](const IRModule&, const transform::PassInfo& pass_info) {
-    PassProfile::EnterPass(pass_info->name);
-    return true;
-  };
-
-  auto run_after_pass = [](const IRModule&, const transform::PassInfo& pass_info) {
-    PassProfile::ExitPass();
-  };
-
-  auto exit_pass_ctx = []() { PassProfileThreadLocalStore::Get()->root.children.clear(); };
+Array<PassProfile> GetPassProfiles() {
+  PassProfileThreadLocalEntry* entry = PassProfileThreadLocalStore::Get();
+  CHECK(entry->profile_stack.empty()) << "cannot get pass profile while still in a pass!";
+  Array<PassProfile> profiles;
+  for (const PassProfileEntry& child : entry->root.children) {
+    profiles.push_back(child.ToObject());
+  }
+  return profiles;
+}
 
-  return BasePassInstrument("PassTimingInstrument",
-                            /* enter_pass_ctx */ nullptr, exit_pass_ctx, /* should_run */ nullptr,
-                            run_before_pass, run_after_pass);
-});
+TVM_REGISTER_GLOBAL("instrument.GetPassProfiles").set_body_typed(GetPassProfiles);
+
+TVM_REGISTER_GLOBAL("instrument.MakePassTimingInstrument")
+    .set_body_typed([](bool track_memory, bool track_ir_size) {
+      // The IR size is counted outside of the timed region of the pass,
+      // it still adds to the duration of the enclosing passes.
+      auto run_before_pass = [track_memory, track_ir_size](const IRModule& mod,
+                                                           const transform::PassInfo& pass_info) {
+        int64_t ir_size = track_ir_size ? IRSizeCounter().Count(mod) : -1;
+        PassProfileEntry::EnterPass(pass_info->name);
+        PassProfileEntry* cur = PassProfileEntry::Current();
+        cur->ir_size_before = ir_size;
+        if (track_memory) {
+          cur->start_memory = GetResidentMemoryBytes();
+          cur->start = PassProfileEntry::Clock::now();
+        }
+        return true;
+      };
+
+      auto run_after_pass = [track_memory, track_ir_size](const IRModule& mod,
+                                                          const transform::PassInfo& pass_info) {
+        PassProfileEntry* cur = PassProfileEntry::Current();
+        PassProfileEntry::ExitPass();
+        if (track_memory) {
+          cur->end_memory = GetResidentMemoryBytes();
+        }
+        if (track_ir_size) {
+          cur->ir_size_after = IRSizeCounter().Count(mod);
+        }
+      };
+
+      auto exit_pass_ctx = []() { PassProfileThreadLocalStore::Get()->root.children.clear(); };
+
+      return BasePassInstrument("PassTimingInstrument",
+                                /* enter_pass_ctx */ nullptr, exit_pass_ctx,
+                                /* should_run */ nullptr, run_before_pass, run_after_pass);
+    });
 
 }  // namespace instrument
 }  // namespace tvm
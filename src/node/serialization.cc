@@ -31,6 +31,7 @@
 #include <tvm/runtime/registry.h>
 
 #include <cctype>
+#include <cstring>
 #include <map>
 #include <string>
 
@@ -331,6 +332,88 @@ class FieldDependencyFinder : public AttrVisitor {
   }
 };
 
+// Helper function to re-create an Array or Map container
+// from the indices of its elements, shared by the json and the binary format.
+// Returns false if the type key does not refer to a container.
+template <typename TIndex>
+bool SetContainer(ObjectPtr<Object>* node, const std::string& type_key,
+                  const std::vector<TIndex>& data, const std::vector<std::string>& keys,
+                  const std::vector<ObjectPtr<Object>>& node_list) {
+  // handling Array
+  if (type_key == ArrayNode::_type_key) {
+    std::vector<ObjectRef> container;
+    for (auto index : data) {
+      container.push_back(ObjectRef(node_list.at(index)));
+    }
+    Array<ObjectRef> array(container);
+    *node = runtime::ObjectInternal::MoveObjectPtr(&array);
+    return true;
+  }
+  // handling Map
+  if (type_key == MapNode::_type_key) {
+    std::unordered_map<ObjectRef, ObjectRef, ObjectHash, ObjectEqual> container;
+    if (keys.empty()) {
+      ICHECK_EQ(data.size() % 2, 0U);
+      for (size_t i = 0; i < data.size(); i += 2) {
+        container[ObjectRef(node_list.at(data[i]))] = ObjectRef(node_list.at(data[i + 1]));
+      }
+    } else {
+      ICHECK_EQ(data.size(), keys.size());
+      for (size_t i = 0; i < data.size(); ++i) {
+        container[String(keys[i])] = ObjectRef(node_list.at(data[i]));
+      }
+    }
+    Map<ObjectRef, ObjectRef> map(container);
+    *node = runtime::ObjectInternal::MoveObjectPtr(&map);
+    return true;
+  }
+  return false;
+}
+
+/*!
+ * \brief Topologically sort the node graph so that every node comes after
+ *  the nodes it refers to through its data and fields.
+ * \param nodes The serialized nodes, each of which has `data` and `fields`.
+ * \return The visiting order.
+ */
+template <typename TNode>
+std::vector<size_t> TopoSortNodes(const std::vector<TNode>& nodes) {
+  size_t n_nodes = nodes.size();
+  std::vector<size_t> topo_order;
+  std::vector<size_t> in_degree(n_nodes, 0);
+  for (const TNode& jnode : nodes) {
+    for (size_t i : jnode.data) {
+      CHECK_LT(i, n_nodes) << "Invalid node index in serialized graph";
+      ++in_degree[i];
+    }
+    for (size_t i : jnode.fields) {
+      CHECK_LT(i, n_nodes) << "Invalid node index in serialized graph";
+      ++in_degree[i];
+    }
+  }
+  for (size_t i = 0; i < n_nodes; ++i) {
+    if (in_degree[i] == 0) {
+      topo_order.push_back(i);
+    }
+  }
+  for (size_t p = 0; p < topo_order.size(); ++p) {
+    const TNode& jnode = nodes[topo_order[p]];
+    for (size_t i : jnode.data) {
+      if (--in_degree[i] == 0) {
+        topo_order.push_back(i);
+      }
+    }
+    for (size_t i : jnode.fields) {
+      if (--in_degree[i] == 0) {
+        topo_order.push_back(i);
+      }
+    }
+  }
+  ICHECK_EQ(topo_order.size(), n_nodes) << "Cyclic reference detected in serialized graph";
+  std::reverse(std::begin(topo_order), std::end(topo_order));
+  return topo_order;
+}
+
 // Helper class to set the attributes of a node
 // from given json node.
 class JSONAttrSetter : public AttrVisitor {
@@ -406,33 +489,8 @@ class JSONAttrSetter : public AttrVisitor {
     if (jnode->repr_bytes.length() > 0 || reflection_->GetReprBytes(node->get(), nullptr)) {
       return;
     }
-    // handling Array
-    if (jnode->type_key == ArrayNode::_type_key) {
-      std::vector<ObjectRef> container;
-      for (auto index : jnode->data) {
-        container.push_back(ObjectRef(node_list_->at(index)));
-      }
-      Array<ObjectRef> array(container);
-      *node = runtime::ObjectInternal::MoveObjectPtr(&array);
-      return;
-    }
-    // handling Map
-    if (jnode->type_key == MapNode::_type_key) {
-      std::unordered_map<ObjectRef, ObjectRef, ObjectHash, ObjectEqual> container;
-      if (jnode->keys.empty()) {
-        ICHECK_EQ(jnode->data.size() % 2, 0U);
-        for (size_t i = 0; i < jnode->data.size(); i += 2) {
-          container[ObjectRef(node_list_->at(jnode->data[i]))] =
-              ObjectRef(node_list_->at(jnode->data[i + 1]));
-        }
-      } else {
-        ICHECK_EQ(jnode->data.size(), jnode->keys.size());
-        for (size_t i = 0; i < jnode->data.size(); ++i) {
-          container[String(jnode->keys[i])] = ObjectRef(node_list_->at(jnode->data[i]));
-        }
-      }
-      Map<ObjectRef, ObjectRef> map(container);
-      *node = runtime::ObjectInternal::MoveObjectPtr(&map);
+    // handling Array and Map
+    if (SetContainer(node, jnode->type_key, jnode->data, jnode->keys, *node_list_)) {
       return;
     }
     jnode_ = jnode;
@@ -499,40 +557,7 @@ struct JSONGraph {
     return g;
   }
 
-  std::vector<size_t> TopoSort() const {
-    size_t n_nodes = nodes.size();
-    std::vector<size_t> topo_order;
-    std::vector<size_t> in_degree(n_nodes, 0);
-    for (const JSONNode& jnode : nodes) {
-      for (size_t i : jnode.data) {
-        ++in_degree[i];
-      }
-      for (size_t i : jnode.fields) {
-        ++in_degree[i];
-      }
-    }
-    for (size_t i = 0; i < n_nodes; ++i) {
-      if (in_degree[i] == 0) {
-        topo_order.push_back(i);
-      }
-    }
-    for (size_t p = 0; p < topo_order.size(); ++p) {
-      const JSONNode& jnode = nodes[topo_order[p]];
-      for (size_t i : jnode.data) {
-        if (--in_degree[i] == 0) {
-          topo_order.push_back(i);
-        }
-      }
-      for (size_t i : jnode.fields) {
-        if (--in_degree[i] == 0) {
-          topo_order.push_back(i);
-        }
-      }
-    }
-    ICHECK_EQ(topo_order.size(), n_nodes) << "Cyclic reference detected in JSON file";
-    std::reverse(std::begin(topo_order), std::end(topo_order));
-    return topo_order;
-  }
+  std::vector<size_t> TopoSort() const { return TopoSortNodes(nodes); }
 };
 
 std::string SaveJSON(const ObjectRef& n) {
@@ -594,7 +619,362 @@ ObjectRef LoadJSON(std::string json_str) {
   return ObjectRef(nodes.at(jgraph.root));
 }
 
+/*! \brief Magic number of the binary node graph format. */
+constexpr uint64_t kTVMNodeBinaryMagic = 0xB7D1A9E2F05C3E41;
+/*! \brief Alignment of the raw tensor payloads in the binary format. */
+constexpr uint64_t kTVMNodeBinaryAlign = 64;
+
+/*! \brief Node structure for binary format. */
+struct BinaryNode {
+  /*! \brief The type of key of the object. */
+  std::string type_key;
+  /*! \brief The str repr representation. */
+  std::string repr_bytes;
+  /*! \brief keys of a map. */
+  std::vector<std::string> keys;
+  /*! \brief values of a map or array. */
+  std::vector<uint64_t> data;
+  /*! \brief node indices of the ObjectRef fields, in visiting order. */
+  std::vector<uint64_t> fields;
+  /*! \brief packed values of the POD fields, in visiting order. */
+  std::string pod_bytes;
+
+  void Save(dmlc::Stream* strm) const {
+    strm->Write(type_key);
+    strm->Write(repr_bytes);
+    strm->Write(keys);
+    strm->Write(data);
+    strm->Write(fields);
+    strm->Write(pod_bytes);
+  }
+
+  bool Load(dmlc::Stream* strm) {
+    return strm->Read(&type_key) && strm->Read(&repr_bytes) && strm->Read(&keys) &&
+           strm->Read(&data) && strm->Read(&fields) && strm->Read(&pod_bytes);
+  }
+};
+
+/*!
+ * \brief Helper class to populate the binary node using the existing index.
+ *
+ *  Unlike the json format, the field names are not stored: the values are
+ *  written in the order of VisitAttrs, which is also the order they are read back.
+ */
+class BinaryAttrGetter : public AttrVisitor {
+ public:
+  const std::unordered_map<Object*, size_t>* node_index_;
+  const std::unordered_map<DLTensor*, size_t>* tensor_index_;
+  BinaryNode* node_;
+  ReflectionVTable* reflection_ = ReflectionVTable::Global();
+
+  void Visit(const char* key, double* value) final { strm_->Write(*value); }
+  void Visit(const char* key, int64_t* value) final { strm_->Write(*value); }
+  void Visit(const char* key, uint64_t* value) final { strm_->Write(*value); }
+  void Visit(const char* key, int* value) final { strm_->Write(*value); }
+  void Visit(const char* key, bool* value) final { strm_->Write(static_cast<uint8_t>(*value)); }
+  void Visit(const char* key, std::string* value) final { strm_->Write(*value); }
+  void Visit(const char* key, void** value) final {
+    LOG(FATAL) << "not allowed to serialize a pointer";
+  }
+  void Visit(const char* key, DataType* value) final {
+    DLDataType dtype = *value;
+    strm_->Write(dtype);
+  }
+  void Visit(const char* key, runtime::NDArray* value) final {
+    uint64_t index = tensor_index_->at(const_cast<DLTensor*>((*value).operator->()));
+    strm_->Write(index);
+  }
+  void Visit(const char* key, ObjectRef* value) final {
+    node_->fields.push_back(node_index_->at(const_cast<Object*>(value->get())));
+  }
+
+  // Get the node
+  void Get(Object* node) {
+    if (node == nullptr) {
+      node_->type_key.clear();
+      return;
+    }
+    node_->type_key = node->GetTypeKey();
+    if (reflection_->GetReprBytes(node, &(node_->repr_bytes))) return;
+
+    if (node->IsInstance<ArrayNode>()) {
+      ArrayNode* n = static_cast<ArrayNode*>(node);
+      for (size_t i = 0; i < n->size(); ++i) {
+        node_->data.push_back(node_index_->at(const_cast<Object*>(n->at(i).get())));
+      }
+    } else if (node->IsInstance<MapNode>()) {
+      MapNode* n = static_cast<MapNode*>(node);
+      bool is_str_map = std::all_of(n->begin(), n->end(), [](const auto& v) {
+        return v.first->template IsInstance<StringObj>();
+      });
+      for (const auto& kv : *n) {
+        if (is_str_map) {
+          node_->keys.push_back(Downcast<String>(kv.first));
+        } else {
+          node_->data.push_back(node_index_->at(const_cast<Object*>(kv.first.get())));
+        }
+        node_->data.push_back(node_index_->at(const_cast<Object*>(kv.second.get())));
+      }
+    } else {
+      dmlc::MemoryStringStream mstrm(&(node_->pod_bytes));
+      strm_ = &mstrm;
+      reflection_->VisitAttrs(node, this);
+      strm_ = nullptr;
+    }
+  }
+
+ private:
+  dmlc::Stream* strm_{nullptr};
+};
+
+// Helper class to set the attributes of a node from given binary node.
+class BinaryAttrSetter : public AttrVisitor {
+ public:
+  const std::vector<ObjectPtr<Object>>* node_list_;
+  const std::vector<runtime::NDArray>* tensor_list_;
+
+  ReflectionVTable* reflection_ = ReflectionVTable::Global();
+
+  template <typename T>
+  void ReadValue(const char* key, T* value) {
+    ICHECK(strm_->Read(value)) << "BinaryReader: cannot read field " << key;
+  }
+  void Visit(const char* key, double* value) final { ReadValue(key, value); }
+  void Visit(const char* key, int64_t* value) final { ReadValue(key, value); }
+  void Visit(const char* key, uint64_t* value) final { ReadValue(key, value); }
+  void Visit(const char* key, int* value) final { ReadValue(key, value); }
+  void Visit(const char* key, bool* value) final {
+    uint8_t v;
+    ReadValue(key, &v);
+    *value = v != 0;
+  }
+  void Visit(const char* key, std::string* value) final { ReadValue(key, value); }
+  void Visit(const char* key, void** value) final {
+    LOG(FATAL) << "not allowed to deserialize a pointer";
+  }
+  void Visit(const char* key, DataType* value) final {
+    DLDataType dtype;
+    ReadValue(key, &dtype);
+    *value = DataType(dtype);
+  }
+  void Visit(const char* key, runtime::NDArray* value) final {
+    uint64_t index;
+    ReadValue(key, &index);
+    ICHECK_LT(index, tensor_list_->size());
+    *value = tensor_list_->at(index);
+  }
+  void Visit(const char* key, ObjectRef* value) final {
+    ICHECK_LT(field_ptr_, bnode_->fields.size()) << "BinaryReader: cannot find field " << key;
+    uint64_t index = bnode_->fields[field_ptr_++];
+    ICHECK_LT(index, node_list_->size());
+    *value = ObjectRef(node_list_->at(index));
+  }
+  // set node to be current BinaryNode
+  void Set(ObjectPtr<Object>* node, BinaryNode* bnode) {
+    // Skip None
+    if (node->get() == nullptr) {
+      return;
+    }
+    // Skip the objects that have their own string repr
+    if (bnode->repr_bytes.length() > 0 || reflection_->GetReprBytes(node->get(), nullptr)) {
+      return;
+    }
+    // handling Array and Map
+    if (SetContainer(node, bnode->type_key, bnode->data, bnode->keys, *node_list_)) {
+      return;
+    }
+    dmlc::MemoryFixedSizeStream mstrm(const_cast<char*>(bnode->pod_bytes.data()),
+                                      bnode->pod_bytes.size());
+    strm_ = &mstrm;
+    bnode_ = bnode;
+    field_ptr_ = 0;
+    reflection_->VisitAttrs(node->get(), this);
+    ICHECK_EQ(field_ptr_, bnode->fields.size()) << "BinaryReader: unused fields in "
+                                                << bnode->type_key;
+    strm_ = nullptr;
+  }
+
+ private:
+  dmlc::Stream* strm_{nullptr};
+  BinaryNode* bnode_{nullptr};
+  size_t field_ptr_{0};
+};
+
+/*!
+ * \brief Header of a tensor in the binary format.
+ *  The payload itself lives in the aligned payload section at the end of the blob.
+ */
+struct BinaryTensorHeader {
+  DLDataType dtype;
+  std::vector<int64_t> shape;
+  /*! \brief Offset of the payload relative to the payload section. */
+  uint64_t offset;
+  /*! \brief Number of bytes of the payload. */
+  uint64_t nbytes;
+
+  void Save(dmlc::Stream* strm) const {
+    strm->Write(dtype);
+    strm->Write(shape);
+    strm->Write(offset);
+    strm->Write(nbytes);
+  }
+
+  bool Load(dmlc::Stream* strm) {
+    return strm->Read(&dtype) && strm->Read(&shape) && strm->Read(&offset) &&
+           strm->Read(&nbytes);
+  }
+};
+
+inline uint64_t AlignBinaryOffset(uint64_t offset) {
+  return (offset + kTVMNodeBinaryAlign - 1) / kTVMNodeBinaryAlign * kTVMNodeBinaryAlign;
+}
+
+/*!
+ * Layout of the binary format:
+ *
+ *   magic, reserved, tvm_version, root, nodes, tensor headers,
+ *   padding up to kTVMNodeBinaryAlign, raw tensor payloads (each aligned).
+ *
+ * The tensor payloads are stored raw instead of base64 encoded, so loading a
+ * tensor is a single aligned copy out of the blob, without any decoding.
+ */
+std::string SaveBinary(const ObjectRef& n) {
+  NodeIndexer indexer;
+  indexer.MakeIndex(const_cast<Object*>(n.get()));
+  BinaryAttrGetter getter;
+  getter.node_index_ = &indexer.node_index_;
+  getter.tensor_index_ = &indexer.tensor_index_;
+  std::vector<BinaryNode> nodes(indexer.node_list_.size());
+  for (size_t i = 0; i < indexer.node_list_.size(); ++i) {
+    getter.node_ = &nodes[i];
+    getter.Get(indexer.node_list_[i]);
+  }
+  std::vector<BinaryTensorHeader> headers;
+  uint64_t payload_size = 0;
+  for (DLTensor* tensor : indexer.tensor_list_) {
+    BinaryTensorHeader header;
+    header.dtype = tensor->dtype;
+    header.shape.assign(tensor->shape, tensor->shape + tensor->ndim);
+    header.nbytes = runtime::GetDataSize(*tensor);
+    header.offset = AlignBinaryOffset(payload_size);
+    payload_size = header.offset + header.nbytes;
+    headers.emplace_back(std::move(header));
+  }
+
+  std::string blob;
+  dmlc::MemoryStringStream mstrm(&blob);
+  dmlc::Stream* strm = &mstrm;
+  uint64_t magic = kTVMNodeBinaryMagic, reserved = 0;
+  strm->Write(magic);
+  strm->Write(reserved);
+  strm->Write(std::string(TVM_VERSION));
+  uint64_t root = indexer.node_index_.at(const_cast<Object*>(n.get()));
+  strm->Write(root);
+  strm->Write(static_cast<uint64_t>(nodes.size()));
+  for (const BinaryNode& node : nodes) {
+    node.Save(strm);
+  }
+  strm->Write(static_cast<uint64_t>(headers.size()));
+  for (const BinaryTensorHeader& header : headers) {
+    header.Save(strm);
+  }
+  // raw payloads
+  size_t payload_begin = AlignBinaryOffset(blob.size());
+  blob.resize(payload_begin + payload_size, 0);
+  for (size_t i = 0; i < headers.size(); ++i) {
+    DLTensor* tensor = indexer.tensor_list_[i];
+    char* dst = &blob[payload_begin + headers[i].offset];
+    if (tensor->device.device_type == kDLCPU && tensor->strides == nullptr &&
+        tensor->byte_offset == 0) {
+      // quick path
+      std::memcpy(dst, tensor->data, headers[i].nbytes);
+    } else {
+      ICHECK_EQ(TVMArrayCopyToBytes(tensor, dst, headers[i].nbytes), 0) << TVMGetLastError();
+    }
+    if (!DMLC_IO_NO_ENDIAN_SWAP) {
+      int elem_bytes = (tensor->dtype.bits * tensor->dtype.lanes + 7) / 8;
+      dmlc::ByteSwap(dst, elem_bytes, headers[i].nbytes / elem_bytes);
+    }
+  }
+  return blob;
+}
+
+ObjectRef LoadBinary(const std::string& blob) {
+  ReflectionVTable* reflection = ReflectionVTable::Global();
+  dmlc::MemoryFixedSizeStream mstrm(const_cast<char*>(blob.data()), blob.size());
+  dmlc::Stream* strm = &mstrm;
+  uint64_t magic, reserved, root, n_nodes, n_tensors;
+  std::string version;
+  ICHECK(strm->Read(&magic) && magic == kTVMNodeBinaryMagic) << "Invalid node binary format";
+  ICHECK(strm->Read(&reserved)) << "Invalid node binary format";
+  ICHECK(strm->Read(&version)) << "Invalid node binary format";
+  // Unlike the json format, there is no upgrader for the binary format.
+  CHECK_EQ(version, std::string(TVM_VERSION))
+      << "The node binary was saved by TVM " << version << ", which cannot be loaded by TVM "
+      << TVM_VERSION << ". Use the json format to move objects across versions.";
+  ICHECK(strm->Read(&root)) << "Invalid node binary format";
+  ICHECK(strm->Read(&n_nodes)) << "Invalid node binary format";
+  CHECK_LT(root, n_nodes) << "Invalid node binary format: root index out of range";
+  std::vector<BinaryNode> bnodes(n_nodes);
+  for (BinaryNode& bnode : bnodes) {
+    ICHECK(bnode.Load(strm)) << "Invalid node binary format";
+  }
+  ICHECK(strm->Read(&n_tensors)) << "Invalid node binary format";
+  std::vector<BinaryTensorHeader> headers(n_tensors);
+  for (BinaryTensorHeader& header : headers) {
+    ICHECK(header.Load(strm)) << "Invalid node binary format";
+  }
+  // load in tensors, one copy from the payload section and no decoding.
+  size_t payload_begin = AlignBinaryOffset(mstrm.Tell());
+  std::vector<runtime::NDArray> tensors;
+  tensors.reserve(n_tensors);
+  for (const BinaryTensorHeader& header : headers) {
+    ICHECK_LE(payload_begin + header.offset + header.nbytes, blob.size())
+        << "Invalid node binary format: truncated tensor payload";
+    runtime::NDArray temp =
+        runtime::NDArray::Empty(runtime::ShapeTuple(header.shape), header.dtype, {kDLCPU, 0});
+    ICHECK_EQ(runtime::GetDataSize(*temp.operator->()), header.nbytes)
+        << "Invalid node binary format: tensor size mismatch";
+    std::memcpy(temp->data, blob.data() + payload_begin + header.offset, header.nbytes);
+    if (!DMLC_IO_NO_ENDIAN_SWAP) {
+      int elem_bytes = (header.dtype.bits * header.dtype.lanes + 7) / 8;
+      dmlc::ByteSwap(temp->data, elem_bytes, header.nbytes / elem_bytes);
+    }
+    tensors.emplace_back(std::move(temp));
+  }
+  // Pass 1: create all non-container objects
+  std::vector<ObjectPtr<Object>> nodes(n_nodes, nullptr);
+  for (size_t i = 0; i < n_nodes; ++i) {
+    const BinaryNode& bnode = bnodes[i];
+    if (bnode.type_key.length() != 0) {
+      nodes[i] = reflection->CreateInitObject(bnode.type_key, bnode.repr_bytes);
+    }
+  }
+  // Pass 2: topo sort, the field dependencies are stored explicitly.
+  std::vector<size_t> topo_order = TopoSortNodes(bnodes);
+  // Pass 3: set all values
+  BinaryAttrSetter setter;
+  setter.node_list_ = &nodes;
+  setter.tensor_list_ = &tensors;
+  for (size_t i : topo_order) {
+    setter.Set(&nodes[i], &bnodes[i]);
+  }
+  return ObjectRef(nodes.at(root));
+}
+
 TVM_REGISTER_GLOBAL("node.SaveJSON").set_body_typed(SaveJSON);
 
 TVM_REGISTER_GLOBAL("node.LoadJSON").set_body_typed(LoadJSON);
+
+TVM_REGISTER_GLOBAL("node.SaveBinary").set_body_typed([](const ObjectRef& n) {
+  std::string s = SaveBinary(n);
+  // copy return array so it is owned by the ret value
+  TVMRetValue rv;
+  rv = TVMByteArray{s.data(), s.size()};
+  return rv;
+});
+
+TVM_REGISTER_GLOBAL("node.LoadBinary").set_body_typed([](const std::string& blob) {
+  return LoadBinary(blob);
+});
 }  // namespace tvm
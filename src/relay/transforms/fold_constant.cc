@@ -30,6 +30,11 @@
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/object.h>
 
+#include <functional>
+#include <unordered_map>
+
+#include "../../support/arena.h"
+#include "../analysis/dependency_graph.h"
 #include "pattern_utils.h"
 
 namespace tvm {
@@ -197,7 +202,36 @@ class ConstantFolder : public MixedModeMutator {
     }
   }
 
+  /*!
+   * \brief Fold all the constant subgraphs of the expression with a single evaluation.
+   *
+   *  The maximal subgraphs whose leaves are all constants are collected first and
+   *  evaluated together as the fields of one tuple, so the module is built, compiled
+   *  and executed once instead of once per subgraph. The folded expression is then
+   *  passed through the regular folder to handle the remaining cases (shape_of,
+   *  constant conditions, let bindings).
+   */
+  Expr BatchFold(const Expr& expr);
+
  private:
+  /*! \brief Whether the call can be evaluated once its arguments are constants. */
+  bool IsFoldableCall(const CallNode* call) {
+    static auto op_stateful = Op::GetAttrMap<TOpIsStateful>("TOpIsStateful");
+    static auto fnoncomputational = Op::GetAttrMap<TNonComputational>("TNonComputational");
+    // We don't constant fold function with zero arguments, see Rewrite_.
+    if (call->args.size() == 0) return false;
+    const OpNode* op_node = call->op.as<OpNode>();
+    if (op_node == nullptr) return false;
+    Op op = GetRef<Op>(op_node);
+    if (op_stateful.get(op, false)) return false;
+    // shape_of and ndarray_size are folded from the types by the regular folder.
+    if (op == shape_of_op_ || op == vm_shape_of_op_ || op == ndarray_size_op_) return false;
+    if ((fnoncomputational.count(op) && fnoncomputational[op]) || op == device_copy_op_) {
+      return false;
+    }
+    return true;
+  }
+
   // Internal constant checker
   ConstantChecker checker_;
   // Module
@@ -369,7 +403,126 @@ class ConstantFolder : public MixedModeMutator {
   }
 };
 
+/*!
+ * \brief Find the sub-expressions whose value only depends on constants.
+ *  Primitive functions are not visited, as in ConstantFolder.
+ */
+class ConstantSubgraphCollector : public MixedModeVisitor {
+ public:
+  explicit ConstantSubgraphCollector(std::function<bool(const CallNode*)> fcall_foldable)
+      : fcall_foldable_(fcall_foldable) {}
+
+  /*! \brief The constant-valued expressions, mapped to whether they contain a call to evaluate. */
+  std::unordered_map<Expr, bool, ObjectPtrHash, ObjectPtrEqual> const_valued;
+
+  using MixedModeVisitor::VisitExpr_;
+
+  void VisitExpr_(const FunctionNode* op) final {
+    if (op->HasNonzeroAttr(attr::kPrimitive)) return;
+    MixedModeVisitor::VisitExpr_(op);
+  }
+
+  void VisitExpr_(const ConstantNode* op) final { const_valued[GetRef<Expr>(op)] = false; }
+
+  void VisitExpr_(const IfNode* op) final {
+    this->VisitExpr(op->cond);
+    // Only one branch of an If with a constant condition is kept, so nothing in the branches
+    // is evaluated ahead of time. The taken branch is folded after the If itself.
+    if (const_valued.count(op->cond)) return;
+    this->VisitExpr(op->true_branch);
+    this->VisitExpr(op->false_branch);
+  }
+
+  void VisitExpr_(const TupleNode* op) final {
+    MixedModeVisitor::VisitExpr_(op);
+    bool need_eval = false;
+    for (const Expr& field : op->fields) {
+      auto it = const_valued.find(field);
+      if (it == const_valued.end()) return;
+      need_eval |= it->second;
+    }
+    const_valued[GetRef<Expr>(op)] = need_eval;
+  }
+
+  void VisitExpr_(const TupleGetItemNode* op) final {
+    MixedModeVisitor::VisitExpr_(op);
+    auto it = const_valued.find(op->tuple);
+    if (it != const_valued.end()) {
+      const_valued[GetRef<Expr>(op)] = it->second;
+    }
+  }
+
+  void VisitExpr_(const CallNode* op) final {
+    MixedModeVisitor::VisitExpr_(op);
+    if (!fcall_foldable_(op)) return;
+    for (const Expr& arg : op->args) {
+      if (!const_valued.count(arg)) return;
+    }
+    const_valued[GetRef<Expr>(op)] = true;
+  }
+
+ private:
+  std::function<bool(const CallNode*)> fcall_foldable_;
+};
+
+/*! \brief Substitute the evaluated subgraphs with their values. */
+class ConstantSubgraphReplacer : public MixedModeMutator {
+ public:
+  explicit ConstantSubgraphReplacer(
+      const std::unordered_map<Expr, Expr, ObjectPtrHash, ObjectPtrEqual>& values) {
+    for (const auto& kv : values) {
+      memo_[kv.first] = kv.second;
+    }
+  }
+};
+
+Expr ConstantFolder::BatchFold(const Expr& expr) {
+  ConstantSubgraphCollector collector([this](const CallNode* call) { return IsFoldableCall(call); });
+  collector.VisitExpr(expr);
+
+  // A constant subgraph is evaluated at its roots: the constant-valued expressions that
+  // contain a call and are used by an expression that is not constant-valued.
+  support::Arena arena;
+  DependencyGraph graph = DependencyGraph::Create(&arena, expr);
+  std::unordered_map<DependencyGraph::Node*, Expr> node_expr;
+  for (const auto& kv : graph.expr_node) {
+    node_expr[kv.second] = kv.first;
+  }
+  Array<Expr> roots;
+  for (DependencyGraph::Node* node : graph.post_dfs_order) {
+    auto it = node_expr.find(node);
+    if (it == node_expr.end()) continue;
+    auto cit = collector.const_valued.find(it->second);
+    if (cit == collector.const_valued.end() || !cit->second) continue;
+    bool is_root = it->second.same_as(expr);
+    for (auto* link = node->parents.head; link != nullptr && !is_root; link = link->next) {
+      auto pit = node_expr.find(link->value);
+      is_root = pit == node_expr.end() || !collector.const_valued.count(pit->second);
+    }
+    if (is_root) {
+      roots.push_back(it->second);
+    }
+  }
+  if (roots.empty()) {
+    return Mutate(expr);
+  }
+
+  auto values = Downcast<Tuple>(ConstEvaluate(Tuple(roots)));
+  ICHECK_EQ(values->fields.size(), roots.size());
+  std::unordered_map<Expr, Expr, ObjectPtrHash, ObjectPtrEqual> folded;
+  for (size_t i = 0; i < roots.size(); ++i) {
+    folded[roots[i]] = values->fields[i];
+  }
+  return Mutate(ConstantSubgraphReplacer(folded).Mutate(expr));
+}
+
 Expr FoldConstant(const Expr& expr, const IRModule& mod) {
+  bool batch = transform::PassContext::Current()
+                   ->GetConfig<Bool>("relay.FoldConstant.batch", Bool(false))
+                   .value();
+  if (batch) {
+    return ConstantFolder(mod).BatchFold(expr);
+  }
   return ConstantFolder(mod).Mutate(expr);
 }
 
@@ -377,6 +530,8 @@ TVM_REGISTER_GLOBAL("relay._transform.FoldConstantExpr").set_body_typed(FoldCons
 
 namespace transform {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.FoldConstant.batch", Bool);
+
 Pass FoldConstant() {
   runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
       [=](Function f, IRModule m, PassContext pc) {
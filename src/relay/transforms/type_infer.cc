@@ -794,6 +794,92 @@ struct AllCheckTypePopulated : MixedModeVisitor {
 
 void EnsureCheckedType(const Expr& e) { AllCheckTypePopulated().VisitExpr(e); }
 
+/*!
+ * \brief Check whether a function still carries the types of a previous inference,
+ *  and collect the global functions it refers to.
+ *
+ *  Rewriting passes construct new nodes without checked types, so a function that
+ *  was modified since the last inference always has an untyped sub-expression.
+ */
+struct TypeCacheChecker : MixedModeVisitor {
+  using MixedModeVisitor::VisitExpr_;
+  /*! \brief Whether all the sub-expressions have a checked type. */
+  bool fully_typed{true};
+  /*! \brief The global vars referred to by the function. */
+  std::vector<GlobalVar> globals;
+
+  void VisitLeaf(const Expr& e) final {
+    if (!fully_typed) return;
+    if (const auto* gvar = e.as<GlobalVarNode>()) {
+      globals.push_back(GetRef<GlobalVar>(gvar));
+    } else if (!e.as<OpNode>() && !e.as<ConstructorNode>() && !e->checked_type_.defined()) {
+      fully_typed = false;
+      return;
+    }
+    MixedModeVisitor::VisitLeaf(e);
+  }
+  void VisitExpr_(const LetNode* op) final {
+    auto pre_visit = [this](const LetNode* op) {
+      if (!op->checked_type_.defined()) {
+        fully_typed = false;
+      }
+      this->VisitExpr(op->var);
+      this->VisitExpr(op->value);
+    };
+    auto post_visit = [this](const LetNode* op) {
+      this->VisitExpr(op->body);
+      this->visit_counter_[op] += 1;
+    };
+    ExpandANormalForm(op, pre_visit, post_visit);
+  }
+};
+
+/*!
+ * \brief Find the functions of the module that need to be type checked again.
+ *
+ *  A function is re-checked if it was changed since its last inference, or if it calls,
+ *  directly or transitively, a function that is re-checked, because the inferred type of
+ *  the callee may change and propagate through the types of its callers.
+ *  Changes of the type definitions of the module are not tracked.
+ *
+ * \param mod The module.
+ * \return The global vars of the functions to check.
+ */
+std::unordered_set<GlobalVar, ObjectPtrHash, ObjectPtrEqual> FindStaleFunctions(
+    const IRModule& mod) {
+  std::unordered_set<GlobalVar, ObjectPtrHash, ObjectPtrEqual> stale;
+  std::vector<std::pair<GlobalVar, std::vector<GlobalVar>>> typed;
+  for (const auto& it : mod->functions) {
+    if (const auto* func_node = it.second.as<FunctionNode>()) {
+      TypeCacheChecker checker;
+      checker.VisitExpr(GetRef<Function>(func_node));
+      if (checker.fully_typed && func_node->checked_type_.as<FuncTypeNode>()) {
+        typed.emplace_back(it.first, std::move(checker.globals));
+      } else {
+        stale.insert(it.first);
+      }
+    }
+  }
+  // Propagate staleness from the callees to their callers until a fixed point is reached.
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (const auto& it : typed) {
+      if (stale.count(it.first)) {
+        continue;
+      }
+      for (const GlobalVar& callee : it.second) {
+        if (stale.count(callee)) {
+          stale.insert(it.first);
+          changed = true;
+          break;
+        }
+      }
+    }
+  }
+  return stale;
+}
+
 // TODO(@jroesch): Can we optimize this?
 void AddGlobalTypes(IRModule mod) {
   std::vector<std::pair<GlobalVar, Function> > updates;
@@ -816,6 +902,8 @@ void AddGlobalTypes(IRModule mod) {
 
 namespace transform {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.InferType.incremental", Bool);
+
 Pass InferType() {
   auto pass_info = PassInfo(0, "InferType", {});
   return tvm::transform::CreateModulePass(
@@ -827,6 +915,18 @@ Pass InferType() {
 
         pass_ctx->diag_ctx = DiagnosticContext::Default(updated_mod);
 
+        // In incremental mode, only the functions changed since the last inference
+        // and their callers are checked, the others keep their types.
+        bool incremental =
+            pass_ctx->GetConfig<Bool>("relay.InferType.incremental", Bool(false)).value();
+        std::unordered_set<GlobalVar, ObjectPtrHash, ObjectPtrEqual> stale;
+        if (incremental) {
+          stale = FindStaleFunctions(updated_mod);
+          if (stale.empty()) {
+            return updated_mod;
+          }
+        }
+
         // Add all the type annotations to the functions in the model.
         AddGlobalTypes(mod);
 
@@ -841,10 +941,11 @@ Pass InferType() {
           if (auto* func_node = it.second.as<FunctionNode>()) {
             auto func = GetRef<Function>(func_node);
 
-            // // If a function already has type information we can skip checking it.
-            // if (func->checked_type_.defined()) {
-            //   continue;
-            // }
+            // If a function already has up-to-date type information we can skip checking it.
+            if (incremental && !stale.count(it.first)) {
+              it.first->checked_type_ = func->checked_type();
+              continue;
+            }
 
             // TODO(@jroesch): we should be able to move the type inferencer outside
             // of this function but it seems to be more stateful then I expect.
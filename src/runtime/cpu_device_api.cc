@@ -25,8 +25,12 @@
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <cstring>
+#include <string>
+#include <vector>
 
 #include "workspace_pool.h"
 
@@ -88,18 +92,135 @@ class CPUDeviceAPI final : public DeviceAPI {
   }
 };
 
+/*! \brief The largest arena of a thread, the larger workspaces are served by the pool. */
+constexpr size_t kWorkspaceArenaMaxBytes = 64 << 20;
+
+/*! \brief The number of the arena regrowths of all threads, each one is a system allocation. */
+static std::atomic<uint64_t> num_arena_grow{0};
+/*! \brief The number of the workspaces of all threads which do not fit in the arenas. */
+static std::atomic<uint64_t> num_pool_alloc{0};
+
+/*!
+ * \brief A stack arena for the workspaces of a thread.
+ *
+ *  The generated code frees its workspaces in the reverse order of allocation, so allocating
+ *  a workspace bumps the stack top and freeing it pops the top. A workspace which does not fit
+ *  in the arena goes to the pool, and the arena is regrown to the peak demand the next time it
+ *  is empty, so the steady state does not allocate from the system.
+ */
+class CPUWorkspaceArena {
+ public:
+  ~CPUWorkspaceArena() {
+    if (data_ != nullptr) {
+      CPUDeviceAPI::Global()->FreeDataSpace(Device{kDLCPU, 0}, data_);
+    }
+  }
+  /*! \return The workspace, or nullptr if it does not fit in the arena. */
+  void* Alloc(size_t nbytes) {
+    nbytes = (nbytes + (kTempAllocaAlignment - 1)) / kTempAllocaAlignment * kTempAllocaAlignment;
+    if (nbytes == 0) nbytes = kTempAllocaAlignment;
+    if (nbytes > kWorkspaceArenaMaxBytes) return nullptr;
+    if (stack_.empty() && demand_ > capacity_) {
+      this->Grow();
+    }
+    size_t begin = stack_.empty() ? 0 : stack_.back().end;
+    if (begin + nbytes > capacity_) {
+      demand_ = std::min(std::max(demand_, begin + nbytes), kWorkspaceArenaMaxBytes);
+      return nullptr;
+    }
+    stack_.push_back({begin, begin + nbytes, false});
+    ++num_alloc;
+    return data_ + begin;
+  }
+  /*! \return Whether the workspace is allocated from the arena. */
+  bool Free(void* ptr) {
+    char* p = static_cast<char*>(ptr);
+    if (data_ == nullptr || p < data_ || p >= data_ + capacity_) return false;
+    size_t begin = static_cast<size_t>(p - data_);
+    ICHECK(!stack_.empty()) << "trying to free things that has not been allocated";
+    if (stack_.back().begin == begin) {
+      // quick path, last allocated.
+      stack_.pop_back();
+    } else {
+      // Out of order free, the workspace is popped together with the ones above it.
+      int index = static_cast<int>(stack_.size()) - 2;
+      for (; index >= 0 && stack_[index].begin != begin; --index) {
+      }
+      ICHECK_GE(index, 0) << "trying to free things that has not been allocated";
+      stack_[index].freed = true;
+    }
+    while (!stack_.empty() && stack_.back().freed) {
+      stack_.pop_back();
+    }
+    return true;
+  }
+
+  /*! \brief The number of the workspaces allocated from the arena of this thread. */
+  uint64_t num_alloc{0};
+
+ private:
+  /*! \brief A workspace in the stack. */
+  struct Entry {
+    size_t begin;
+    size_t end;
+    bool freed;
+  };
+
+  void Grow() {
+    CPUDeviceAPI* device = CPUDeviceAPI::Global();
+    Device dev{kDLCPU, 0};
+    if (data_ != nullptr) {
+      device->FreeDataSpace(dev, data_);
+    }
+    DLDataType type{kDLUInt, 8, 1};
+    data_ = static_cast<char*>(device->AllocDataSpace(dev, demand_, kTempAllocaAlignment, type));
+    capacity_ = demand_;
+    num_arena_grow.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /*! \brief The arena, only regrown when it is empty, so it never moves a live workspace. */
+  char* data_{nullptr};
+  size_t capacity_{0};
+  /*! \brief The peak size of the workspaces which are live at the same time. */
+  size_t demand_{0};
+  /*! \brief The live workspaces, in the order of allocation. */
+  std::vector<Entry> stack_;
+};
+
 struct CPUWorkspacePool : public WorkspacePool {
   CPUWorkspacePool() : WorkspacePool(kDLCPU, CPUDeviceAPI::Global()) {}
+  CPUWorkspaceArena arena;
 };
 
 void* CPUDeviceAPI::AllocWorkspace(Device dev, size_t size, DLDataType type_hint) {
-  return dmlc::ThreadLocalStore<CPUWorkspacePool>::Get()->AllocWorkspace(dev, size);
+  CPUWorkspacePool* pool = dmlc::ThreadLocalStore<CPUWorkspacePool>::Get();
+  if (void* ptr = pool->arena.Alloc(size)) {
+    return ptr;
+  }
+  num_pool_alloc.fetch_add(1, std::memory_order_relaxed);
+  return pool->AllocWorkspace(dev, size);
 }
 
 void CPUDeviceAPI::FreeWorkspace(Device dev, void* data) {
-  dmlc::ThreadLocalStore<CPUWorkspacePool>::Get()->FreeWorkspace(dev, data);
+  CPUWorkspacePool* pool = dmlc::ThreadLocalStore<CPUWorkspacePool>::Get();
+  if (!pool->arena.Free(data)) {
+    pool->FreeWorkspace(dev, data);
+  }
 }
 
+TVM_REGISTER_GLOBAL("runtime.CPUWorkspaceStats").set_body_typed([](std::string key) -> int64_t {
+  if (key == "arena_alloc") {
+    // Only the calling thread is counted, to keep the fast path free of shared counters.
+    return static_cast<int64_t>(dmlc::ThreadLocalStore<CPUWorkspacePool>::Get()->arena.num_alloc);
+  } else if (key == "arena_grow") {
+    return static_cast<int64_t>(num_arena_grow.load());
+  } else if (key == "pool_alloc") {
+    return static_cast<int64_t>(num_pool_alloc.load());
+  }
+  LOG(FATAL) << "Unknown workspace counter " << key;
+  return 0;
+});
+
 TVM_REGISTER_GLOBAL("device_api.cpu").set_body([](TVMArgs args, TVMRetValue* rv) {
   DeviceAPI* ptr = CPUDeviceAPI::Global();
   *rv = static_cast<void*>(ptr);
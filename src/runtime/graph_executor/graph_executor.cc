@@ -133,6 +133,13 @@ void GraphExecutor::SetInputZeroCopy(int index, DLTensor* data_ref) {
   for (auto i = 0; i < data_ref->ndim; ++i) {
     ICHECK_EQ(old_t->shape[i], data_ref->shape[i]);
   }
+  // The kernels may be called through their trusted entry, which does not check
+  // the dtype and strides of the arguments, so they must match here.
+  ICHECK(old_t->dtype == data_ref->dtype)
+      << "set_input_zero_copy expects dtype " << DLDataType2String(old_t->dtype) << ", but got "
+      << DLDataType2String(data_ref->dtype);
+  ICHECK(IsContiguous(*data_ref)) << "set_input_zero_copy expects a compact tensor";
+  ICHECK_EQ(data_ref->byte_offset, 0) << "set_input_zero_copy expects a zero byte_offset";
 
   // Update the data pointer for each argument of each op
   for (DLTensor* t : input_dltensors_[eid]) {
@@ -429,8 +436,13 @@ GraphExecutor::CreateTVMOp(const TVMOpParam& param, const std::vector<DLTensor>&
   }
 
   // Get compiled function from the module that contains both host and device
-  // code.
-  tvm::runtime::PackedFunc pf = module_.GetFunction(param.func_name, true);
+  // code. The arguments are the graph's own tensors whose shapes and dtypes are
+  // fixed at load time, so prefer the entry which skips the argument checks.
+  tvm::runtime::PackedFunc pf =
+      module_.GetFunction(param.func_name + symbol::tvm_trusted_entry_suffix, true);
+  if (pf == nullptr) {
+    pf = module_.GetFunction(param.func_name, true);
+  }
   ICHECK(pf != nullptr) << "no such function in module: " << param.func_name;
 
   auto fexec = [arg_ptr, pf]() {
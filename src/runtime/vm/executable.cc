@@ -49,6 +49,31 @@ namespace vm {
   ICHECK(val) << "Invalid VM file format in the " << section << " section." \
               << "\n";
 
+/*!
+ * \brief Read the header of a tensor saved by SaveDLTensor and seek past its payload.
+ * \param strm The stream, positioned at the beginning of the tensor.
+ * \return The shape of the tensor.
+ */
+std::vector<int64_t> SkipDLTensor(dmlc::SeekStream* strm) {
+  uint64_t header, reserved;
+  Device dev;
+  int ndim;
+  DLDataType dtype;
+  STREAM_CHECK(strm->Read(&header) && header == kTVMNDArrayMagic, "constant");
+  STREAM_CHECK(strm->Read(&reserved), "constant");
+  STREAM_CHECK(strm->Read(&dev), "constant");
+  STREAM_CHECK(strm->Read(&ndim), "constant");
+  STREAM_CHECK(strm->Read(&dtype), "constant");
+  std::vector<int64_t> shape(ndim);
+  if (ndim != 0) {
+    STREAM_CHECK(strm->ReadArray(&shape[0], ndim), "constant");
+  }
+  int64_t data_byte_size;
+  STREAM_CHECK(strm->Read(&data_byte_size), "constant");
+  strm->Seek(strm->Tell() + data_byte_size);
+  return shape;
+}
+
 // Helper to serialize a vm instruction.
 VMInstructionSerializer SerializeInstruction(const Instruction& instr);
 // Helper to deserialize a serialized vm instruction.
@@ -152,9 +177,18 @@ std::string Executable::Stats() const {
 
   // Get the number of constants and the shape of each of them.
   oss << "  Constant shapes (# " << constants.size() << "): [";
-  for (const auto& it : constants) {
-    const auto constant = Downcast<NDArray>(it);
-    const auto& shape = constant.Shape();
+  for (size_t i = 0; i < constants.size(); ++i) {
+    std::vector<int64_t> shape;
+    if (const_loaded_ == nullptr || const_loaded_[i].load(std::memory_order_acquire)) {
+      const auto constant = Downcast<NDArray>(constants[i]);
+      const auto& constant_shape = constant.Shape();
+      shape.assign(constant_shape.begin(), constant_shape.end());
+    } else {
+      // Read the shape from the serialized code without loading the constant.
+      dmlc::MemoryFixedSizeStream strm(const_cast<char*>(code_.data()), code_.size());
+      strm.Seek(const_offsets_[i]);
+      shape = SkipDLTensor(&strm);
+    }
 
     // Scalar
     if (shape.empty()) {
@@ -208,6 +242,9 @@ void SaveHeader(dmlc::Stream* strm) {
 }
 
 TVMByteArray Executable::Save() {
+  // The pending constants refer to `code_`, load them before it is overwritten.
+  LoadAllConstants();
+
   // Initialize the stream object.
   code_.clear();
   dmlc::MemoryStringStream strm(&code_);
@@ -250,8 +287,8 @@ void Executable::SaveGlobalSection(dmlc::Stream* strm) {
 
 void Executable::SaveConstantSection(dmlc::Stream* strm) {
   std::vector<DLTensor*> arrays;
-  for (const auto& obj : this->constants) {
-    const auto cell = Downcast<runtime::NDArray>(obj);
+  for (size_t i = 0; i < this->constants.size(); ++i) {
+    const auto cell = Downcast<runtime::NDArray>(GetConstant(i));
     arrays.push_back(const_cast<DLTensor*>(cell.operator->()));
   }
   strm->Write(static_cast<uint64_t>(this->constants.size()));
@@ -557,17 +594,21 @@ void Executable::LoadGlobalSection(dmlc::Stream* strm) {
   }
 }
 
-void Executable::LoadConstantSection(dmlc::Stream* strm) {
+void Executable::LoadConstantSection(dmlc::SeekStream* strm) {
   uint64_t sz;
   // Load the number of constants.
   STREAM_CHECK(strm->Read(&sz, sizeof(sz)), "constant");
 
   size_t size = static_cast<size_t>(sz);
-  // Load each of the constants.
+  // Record where each of the constants lives and skip its payload, the constants
+  // are materialized by GetConstant when they are first used.
+  this->constants.resize(size);
+  this->const_offsets_.resize(size);
+  this->const_loaded_.reset(new std::atomic<bool>[size]);
   for (size_t i = 0; i < size; i++) {
-    runtime::NDArray constant;
-    STREAM_CHECK(constant.Load(strm), "constant");
-    this->constants.push_back(constant);
+    this->const_loaded_[i].store(false, std::memory_order_relaxed);
+    this->const_offsets_[i] = strm->Tell();
+    SkipDLTensor(strm);
   }
 
   // Load the const to device mapping.
@@ -577,6 +618,29 @@ void Executable::LoadConstantSection(dmlc::Stream* strm) {
   this->const_device_type = const_device_type;
 }
 
+ObjectRef Executable::GetConstant(Index index) const {
+  ICHECK_LT(static_cast<size_t>(index), constants.size());
+  if (const_loaded_ == nullptr || const_loaded_[index].load(std::memory_order_acquire)) {
+    return constants[index];
+  }
+  std::lock_guard<std::mutex> lock(const_mutex_);
+  if (!const_loaded_[index].load(std::memory_order_relaxed)) {
+    dmlc::MemoryFixedSizeStream strm(const_cast<char*>(code_.data()), code_.size());
+    strm.Seek(const_offsets_[index]);
+    runtime::NDArray constant;
+    STREAM_CHECK(constant.Load(&strm), "constant");
+    constants[index] = constant;
+    const_loaded_[index].store(true, std::memory_order_release);
+  }
+  return constants[index];
+}
+
+void Executable::LoadAllConstants() const {
+  for (size_t i = 0; i < const_offsets_.size(); ++i) {
+    GetConstant(i);
+  }
+}
+
 void Executable::LoadPrimitiveOpNames(dmlc::Stream* strm) {
   std::vector<std::string> primitive_names;
   STREAM_CHECK(strm->Read(&primitive_names), "primitive name");
@@ -420,7 +420,6 @@ void VirtualMachine::RunLoop() {
         throw std::runtime_error("VM encountered fatal error");
       }
       case Opcode::LoadConst: {
-        auto constant_obj = exec_->constants[instr.const_index];
         // We cache the allocated object in the constant pool. To measure, the
         // first iteration will set the pool up. The other iterations will
         // directly reuse the allocated objects.
@@ -429,6 +428,7 @@ void VirtualMachine::RunLoop() {
         }
 
         if (!const_pool_[instr.const_index].defined()) {
+          auto constant_obj = exec_->GetConstant(instr.const_index);
           Device dev = GetDevice(exec_->const_device_type[instr.const_index]);
           const_pool_[instr.const_index] = CopyTo(constant_obj, dev);
         }
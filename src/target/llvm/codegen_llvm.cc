@@ -1127,6 +1127,7 @@ llvm::Value* CodeGenLLVM::VisitExpr_(const LetNode* op) {
 
 llvm::Value* CodeGenLLVM::VisitExpr_(const LoadNode* op) {
   DataType t = op->dtype;
+  ICHECK(is_one(op->predicate) || t.lanes() > 1) << op->predicate;
   bool is_volatile = volatile_buf_.count(op->buffer_var.get());
   llvm::Value* buffer = MakeValue(op->buffer_var);
   llvm::Value* index = MakeValue(op->index);
@@ -1145,6 +1146,39 @@ llvm::Value* CodeGenLLVM::VisitExpr_(const LoadNode* op) {
   } else {
     // vector load
     unsigned addrspace = llvm::dyn_cast<llvm::PointerType>(buffer->getType())->getAddressSpace();
+    if (!is_one(op->predicate)) {
+      // predicated load, the inactive lanes are not accessed.
+      ICHECK_EQ(op->predicate.dtype().lanes(), t.lanes());
+      llvm::Type* vtype = DTypeToLLVMType(t);
+      llvm::Value* mask = MakeValue(op->predicate);
+      llvm::Value* passthru = llvm::UndefValue::get(vtype);
+      llvm::CallInst* load;
+      const RampNode* ramp = op->index.as<RampNode>();
+      if (ramp && is_one(ramp->stride)) {
+        int alignment, native_bits;
+        GetAlignment(t, op->buffer_var.get(), ramp->base, &alignment, &native_bits);
+        llvm::Value* ptr = CreateBufferPtr(t.element_of(), buffer, MakeValue(ramp->base));
+        ptr = builder_->CreatePointerCast(ptr, vtype->getPointerTo(addrspace));
+#if TVM_LLVM_VERSION >= 130
+        load = builder_->CreateMaskedLoad(vtype, ptr, llvm::Align(alignment), mask, passthru);
+#elif TVM_LLVM_VERSION >= 110
+        load = builder_->CreateMaskedLoad(ptr, llvm::Align(alignment), mask, passthru);
+#else
+        load = builder_->CreateMaskedLoad(ptr, alignment, mask, passthru);
+#endif
+      } else {
+        llvm::Value* ptrs = CreateBufferPtr(t.element_of(), buffer, index);
+#if TVM_LLVM_VERSION >= 130
+        load = builder_->CreateMaskedGather(vtype, ptrs, llvm::Align(t.bytes()), mask, passthru);
+#elif TVM_LLVM_VERSION >= 110
+        load = builder_->CreateMaskedGather(ptrs, llvm::Align(t.bytes()), mask, passthru);
+#else
+        load = builder_->CreateMaskedGather(ptrs, t.bytes(), mask, passthru);
+#endif
+      }
+      AddAliasInfo(load, op->buffer_var.get(), op->index);
+      return load;
+    }
     if (const RampNode* ramp = op->index.as<RampNode>()) {
       if (is_one(ramp->stride)) {
         int alignment, native_bits;
@@ -1241,8 +1275,8 @@ llvm::Value* CodeGenLLVM::VisitExpr_(const BroadcastNode* op) {
 }
 
 void CodeGenLLVM::VisitStmt_(const StoreNode* op) {
-  ICHECK(is_one(op->predicate)) << op->predicate;
   DataType t = op->value.dtype();
+  ICHECK(is_one(op->predicate) || t.lanes() > 1) << op->predicate;
   bool is_volatile = volatile_buf_.count(op->buffer_var.get());
   llvm::Value* buffer = MakeValue(op->buffer_var);
   llvm::Value* index = MakeValue(op->index);
@@ -1263,6 +1297,33 @@ void CodeGenLLVM::VisitStmt_(const StoreNode* op) {
   } else {
     // vector store
     unsigned addrspace = llvm::dyn_cast<llvm::PointerType>(buffer->getType())->getAddressSpace();
+    if (!is_one(op->predicate)) {
+      // predicated store, the inactive lanes are not written.
+      ICHECK_EQ(op->predicate.dtype().lanes(), t.lanes());
+      llvm::Value* mask = MakeValue(op->predicate);
+      llvm::CallInst* store;
+      const RampNode* ramp = op->index.as<RampNode>();
+      if (ramp && is_one(ramp->stride)) {
+        int alignment, native_bits;
+        GetAlignment(t, op->buffer_var.get(), ramp->base, &alignment, &native_bits);
+        llvm::Value* ptr = CreateBufferPtr(t.element_of(), buffer, MakeValue(ramp->base));
+        ptr = builder_->CreatePointerCast(ptr, DTypeToLLVMType(t)->getPointerTo(addrspace));
+#if TVM_LLVM_VERSION >= 110
+        store = builder_->CreateMaskedStore(value, ptr, llvm::Align(alignment), mask);
+#else
+        store = builder_->CreateMaskedStore(value, ptr, alignment, mask);
+#endif
+      } else {
+        llvm::Value* ptrs = CreateBufferPtr(t.element_of(), buffer, index);
+#if TVM_LLVM_VERSION >= 110
+        store = builder_->CreateMaskedScatter(value, ptrs, llvm::Align(t.bytes()), mask);
+#else
+        store = builder_->CreateMaskedScatter(value, ptrs, t.bytes(), mask);
+#endif
+      }
+      AddAliasInfo(store, op->buffer_var.get(), op->index);
+      return;
+    }
     if (const RampNode* ramp = op->index.as<RampNode>()) {
       if (is_one(ramp->stride)) {
         int alignment, native_bits;
@@ -62,7 +62,52 @@ FuncType PrimFuncNode::func_type_annotation() const {
   return FuncType(param_types, ret_type, {}, {});
 }
 
+TensorIntrin::TensorIntrin(PrimFunc desc, PrimFunc impl) {
+  CHECK_EQ(desc->params.size(), impl->params.size())
+      << "ValueError: The number of parameters of the description and the implementation of the "
+         "tensor intrinsic doesn't match.";
+  for (size_t i = 0; i < desc->params.size(); i++) {
+    CHECK(desc->params[i]->dtype.is_handle()) << "ValueError: Parameters of the description of the "
+                                                 "tensor intrinsic should be handle only.";
+    CHECK(impl->params[i]->dtype.is_handle()) << "ValueError: Parameters of the implementation of "
+                                                 "the tensor intrinsic should be handle only.";
+  }
+  CHECK_EQ(desc->buffer_map.size(), impl->buffer_map.size())
+      << "ValueError: The number of buffers of the description and the implementation of the "
+         "tensor intrinsic doesn't match.";
+
+  ObjectPtr<TensorIntrinNode> n = make_object<TensorIntrinNode>();
+  n->desc = std::move(desc);
+  n->impl = std::move(impl);
+  data_ = std::move(n);
+}
+
+class TensorIntrinManager {
+ public:
+  Map<String, tir::TensorIntrin> reg;
+
+  static TensorIntrinManager* Global() {
+    static TensorIntrinManager* inst = new TensorIntrinManager();
+    return inst;
+  }
+};
+
+void TensorIntrin::Register(String name, TensorIntrin intrin) {
+  TensorIntrinManager* manager = TensorIntrinManager::Global();
+  CHECK_EQ(manager->reg.count(name), 0U)
+      << "ValueError: TensorIntrin '" << name << "' has already been registered";
+  manager->reg.Set(name, intrin);
+}
+
+TensorIntrin TensorIntrin::Get(String name) {
+  const TensorIntrinManager* manager = TensorIntrinManager::Global();
+  auto it = manager->reg.find(name);
+  CHECK(it != manager->reg.end()) << "ValueError: TensorIntrin '" << name << "' is not registered";
+  return (*it).second;
+}
+
 TVM_REGISTER_NODE_TYPE(PrimFuncNode);
+TVM_REGISTER_NODE_TYPE(TensorIntrinNode);
 
 TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
     .set_dispatch<PrimFuncNode>([](const ObjectRef& ref, ReprPrinter* p) {
@@ -85,5 +130,13 @@ TVM_REGISTER_GLOBAL("tir.PrimFunc")
       return PrimFunc(params, body, ret_type, buffer_map, attrs, span);
     });
 
+TVM_REGISTER_GLOBAL("tir.TensorIntrin")
+    .set_body_typed([](PrimFunc desc_func, PrimFunc intrin_func) {
+      return TensorIntrin(desc_func, intrin_func);
+    });
+
+TVM_REGISTER_GLOBAL("tir.TensorIntrinRegister").set_body_typed(TensorIntrin::Register);
+TVM_REGISTER_GLOBAL("tir.TensorIntrinGet").set_body_typed(TensorIntrin::Get);
+
 }  // namespace tir
 }  // namespace tvm
@@ -97,6 +97,14 @@ void CheckCompleteBlock(const ScheduleState& self, const StmtSRef& block_sref,
 bool IsAffineBinding(const BlockRealize& realize, const Map<Var, Range>& loop_var_ranges,
                      arith::Analyzer* analyzer);
 
+/*!
+ * \brief Check whether the block has an affine binding
+ * \param self The schedule state
+ * \param block The block to be checked
+ * \throw ScheduleError If the block does not have an affine binding
+ */
+void CheckAffineBinding(const ScheduleState& self, Block block);
+
 /*!
  * \brief Extracts the ranges of loop variables in a path of the sref tree
  * \param low_inclusive The lowest node in the path
@@ -142,6 +150,66 @@ Array<StmtSRef> GetLoops(const StmtSRef& block_sref);
  * \return A list of leaf blocks
  */
 Array<StmtSRef> GetChildBlocks(const ScheduleState& self, const StmtSRef& parent_sref);
+/*!
+ * \brief Get the BlockRealize of the given block
+ * \param self The schedule state
+ * \param block_sref The StmtSRef of the queried block
+ * \return The BlockRealize of the given block
+ */
+BlockRealize GetBlockRealize(const ScheduleState& self, const StmtSRef& block_sref);
+/*!
+ * \brief Get the producers of a specific block, i.e. the blocks in the same scope that the given
+ * block has read-after-write dependency on
+ * \param self The schedule state
+ * \param block_sref The block in the query
+ * \return A list of blocks, the producers of the given block
+ */
+Array<StmtSRef> GetProducers(const ScheduleState& self, const StmtSRef& block_sref);
+/*!
+ * \brief Get the consumers of a specific block, i.e. the blocks in the same scope that have
+ * read-after-write dependency on the given block
+ * \param self The schedule state
+ * \param block_sref The block in the query
+ * \return A list of blocks, the consumers of the given block
+ */
+Array<StmtSRef> GetConsumers(const ScheduleState& self, const StmtSRef& block_sref);
+/*!
+ * \brief Get the lowest common ancestor of a list of srefs, inclusive
+ * \param srefs The srefs in the query, which are required to be in the same sref tree
+ * \return The lowest common ancestor
+ */
+StmtSRef GetSRefLowestCommonAncestor(const Array<StmtSRef>& srefs);
+
+/******** Buffer access ********/
+/*!
+ * \brief Get the n-th read or write buffer of the given block
+ * \param self The schedule state
+ * \param block The queried block
+ * \param n The index of the buffer in the block's read or write region
+ * \param is_write A flag indicating the region is read or write
+ * \return The buffer of the n-th read/write region
+ * \throw ScheduleError If the index is out of range
+ */
+Buffer GetNthAccessBuffer(const ScheduleState& self, const Block& block, int n, bool is_write);
+/*!
+ * \brief Get the buffer region of the specific buffer in a list of buffer regions
+ * \param buffer_regions The buffer regions to be searched
+ * \param buffer The buffer to be found
+ * \return The region of the buffer, or NullOpt if the buffer is not in the list
+ */
+Optional<BufferRegion> GetBufferRegionFromBuffer(const Array<BufferRegion>& buffer_regions,
+                                                 const Buffer& buffer);
+/*!
+ * \brief Relax the region a block accesses over the loops between the block and the given
+ * ancestor, i.e. get the region accessed by a single iteration of the ancestor
+ * \param self The schedule state
+ * \param block_sref The block that accesses the region
+ * \param ancestor_sref The loop or block the region is relaxed to, exclusive
+ * \param region The buffer region accessed by the block, in terms of the block vars
+ * \return The relaxed integer sets of each dimension
+ */
+Array<arith::IntSet> RelaxBufferRegion(const ScheduleState& self, const StmtSRef& block_sref,
+                                       const StmtSRef& ancestor_sref, const BufferRegion& region);
 
 }  // namespace tir
 }  // namespace tvm
@@ -186,6 +186,28 @@ bool IsAffineBinding(const BlockRealize& realize, const Map<Var, Range>& loop_va
   return true;
 }
 
+void CheckAffineBinding(const ScheduleState& self, Block block) {
+  class NotAffineBindingError : public ScheduleError {
+   public:
+    explicit NotAffineBindingError(IRModule mod, Block block)
+        : mod_(std::move(mod)), block_(std::move(block)) {}
+    String FastErrorString() const final {
+      return "ScheduleError: The block is required to have an affine binding";
+    }
+    String DetailRenderTemplate() const final {
+      return "The block {0} is required to have an affine binding";
+    }
+    IRModule mod() const final { return mod_; }
+    Array<ObjectRef> LocationsOfInterest() const final { return {block_}; }
+    IRModule mod_;
+    Block block_;
+  };
+
+  if (!self->IsAffineBlockBinding(self->stmt2ref.at(block.get()))) {
+    throw NotAffineBindingError(self->mod, std::move(block));
+  }
+}
+
 Map<Var, Range> LoopDomainOfSRefTreePath(const StmtSRef& low_inclusive,
                                          const Optional<StmtSRef>& high_exclusive,
                                          const runtime::StorageScope& extra_relax_scope) {
@@ -298,5 +320,187 @@ Array<StmtSRef> GetChildBlocks(const ScheduleState& self, const StmtSRef& parent
   throw;
 }
 
+BlockRealize GetBlockRealize(const ScheduleState& self, const StmtSRef& block_sref) {
+  struct BlockRealizeFinder : public StmtVisitor {
+    explicit BlockRealizeFinder(const BlockNode* target_block)
+        : target_block(target_block), result(nullptr) {}
+
+    void VisitStmt(const Stmt& stmt) final {
+      if (result != nullptr) {
+        return;
+      }
+      StmtVisitor::VisitStmt(stmt);
+    }
+
+    void VisitStmt_(const BlockRealizeNode* block_realize) final {
+      if (block_realize->block.get() == target_block) {
+        result = block_realize;
+      }
+      // No need to visit recursively, since the deeper BlockRealizes must not be the result.
+    }
+
+    const BlockNode* target_block;
+    const BlockRealizeNode* result;
+  };
+
+  const BlockNode* block = TVM_SREF_TO_BLOCK(block, block_sref);
+  if (block_sref->parent == nullptr) {
+    // The root block of a PrimFunc
+    for (const auto& kv : self->mod->functions) {
+      if (const auto* func = kv.second.as<PrimFuncNode>()) {
+        if (const auto* realize = func->body.as<BlockRealizeNode>()) {
+          if (realize->block.get() == block) {
+            return GetRef<BlockRealize>(realize);
+          }
+        }
+      }
+    }
+    LOG(FATAL) << "IndexError: Cannot find the PrimFunc whose root block is:\n"
+               << GetRef<Block>(block);
+    throw;
+  }
+  BlockRealizeFinder finder(block);
+  const StmtSRefNode* parent = block_sref->parent;
+  if (const auto* loop = parent->StmtAs<ForNode>()) {
+    finder(loop->body);
+  } else if (const auto* parent_block = parent->StmtAs<BlockNode>()) {
+    finder(parent_block->body);
+  }
+  ICHECK(finder.result != nullptr)
+      << "InternalError: Cannot find the BlockRealize of block:\n"
+      << GetRef<Block>(block);
+  return GetRef<BlockRealize>(finder.result);
+}
+
+/*!
+ * \brief Collect the blocks on one end of the read-after-write dependencies of a block
+ * \param deps The dependencies to be looked into
+ * \param is_src Collect the source or the destination end of the dependencies
+ * \return The blocks collected, deduplicated and in the order of appearance
+ */
+Array<StmtSRef> CollectRAWDepEnds(const Array<Dependency>& deps, bool is_src) {
+  std::unordered_set<const StmtSRefNode*> visited;
+  Array<StmtSRef> result;
+  for (const Dependency& dep : deps) {
+    if (dep->kind != DepKind::kRAW) {
+      continue;
+    }
+    const StmtSRef& sref = is_src ? dep->src : dep->dst;
+    if (visited.insert(sref.get()).second) {
+      result.push_back(sref);
+    }
+  }
+  return result;
+}
+
+Array<StmtSRef> GetProducers(const ScheduleState& self, const StmtSRef& block_sref) {
+  Optional<StmtSRef> scope_root = GetScopeRoot(block_sref);
+  if (!scope_root.defined()) {
+    return {};
+  }
+  BlockScope scope = self->GetBlockScope(scope_root.value());
+  return CollectRAWDepEnds(scope->GetDepsByDst(block_sref), /*is_src=*/true);
+}
+
+Array<StmtSRef> GetConsumers(const ScheduleState& self, const StmtSRef& block_sref) {
+  Optional<StmtSRef> scope_root = GetScopeRoot(block_sref);
+  if (!scope_root.defined()) {
+    return {};
+  }
+  BlockScope scope = self->GetBlockScope(scope_root.value());
+  return CollectRAWDepEnds(scope->GetDepsBySrc(block_sref), /*is_src=*/false);
+}
+
+StmtSRef GetSRefLowestCommonAncestor(const Array<StmtSRef>& srefs) {
+  CHECK(!srefs.empty()) << "ValueError: The input array is required to have at least one sref";
+  std::unordered_map<const StmtSRefNode*, size_t> sref_visited_cnt;
+  for (const StmtSRef& sref : srefs) {
+    for (const StmtSRefNode* p = sref.get(); p != nullptr; p = p->parent) {
+      ++sref_visited_cnt[p];
+    }
+  }
+  size_t n_sref = srefs.size();
+  for (const StmtSRefNode* p = srefs[0].get(); p != nullptr; p = p->parent) {
+    if (sref_visited_cnt.at(p) == n_sref) {
+      return GetRef<StmtSRef>(p);
+    }
+  }
+  LOG(FATAL) << "ValueError: The input srefs are not in the same sref tree";
+  throw;
+}
+
+/******** Buffer access ********/
+
+Buffer GetNthAccessBuffer(const ScheduleState& self, const Block& block, int n, bool is_write) {
+  class BufferIndexOutOfRangeError : public ScheduleError {
+   public:
+    explicit BufferIndexOutOfRangeError(IRModule mod, Block block, int buffer_index,
+                                        bool is_write)
+        : mod_(std::move(mod)),
+          block_(std::move(block)),
+          buffer_index_(buffer_index),
+          is_write_(is_write) {}
+
+    String FastErrorString() const final {
+      if (is_write_) {
+        return "ScheduleError: The input `buffer_index` is out of range. It is required to be in "
+               "range [0, num_write_regions) where `num_write_regions` is the number of buffer "
+               "regions written by the block.";
+      } else {
+        return "ScheduleError: The input `buffer_index` is out of range. It is required to be in "
+               "range [0, num_read_regions) where `num_read_regions` is the number of buffer "
+               "regions read by the block.";
+      }
+    }
+
+    String DetailRenderTemplate() const final {
+      std::ostringstream os;
+      size_t num = is_write_ ? block_->writes.size() : block_->reads.size();
+      std::string access_type = is_write_ ? "write" : "read";
+      os << "The block {0} has " << num << " " << access_type
+         << " regions, so `buffer_index` is required to be in [0, " << num
+         << "). However, the input `buffer_index` is " << buffer_index_
+         << ", which is out of the expected range.";
+      return os.str();
+    }
+
+    IRModule mod() const final { return mod_; }
+    Array<ObjectRef> LocationsOfInterest() const final { return {block_}; }
+
+   private:
+    IRModule mod_;
+    Block block_;
+    int buffer_index_;
+    bool is_write_;
+  };
+
+  const Array<BufferRegion>& access_region = is_write ? block->writes : block->reads;
+  if (n < 0 || static_cast<int>(access_region.size()) <= n) {
+    throw BufferIndexOutOfRangeError(self->mod, block, n, is_write);
+  }
+  return access_region[n]->buffer;
+}
+
+Optional<BufferRegion> GetBufferRegionFromBuffer(const Array<BufferRegion>& buffer_regions,
+                                                 const Buffer& buffer) {
+  for (const BufferRegion& region : buffer_regions) {
+    if (region->buffer.same_as(buffer)) {
+      return region;
+    }
+  }
+  return NullOpt;
+}
+
+Array<arith::IntSet> RelaxBufferRegion(const ScheduleState& self, const StmtSRef& block_sref,
+                                       const StmtSRef& ancestor_sref, const BufferRegion& region) {
+  BlockRealize realize = GetBlockRealize(self, block_sref);
+  Map<Var, PrimExpr> binding = GetBindings(realize);
+  Map<Var, Range> dom = LoopDomainOfSRefTreePath(
+      /*low_inclusive=*/GetRef<StmtSRef>(block_sref->parent),
+      /*high_exclusive=*/ancestor_sref,
+      /*extra_relax_scope=*/runtime::StorageScope::Create(region->buffer->scope));
+  return arith::EvalSet(Substitute(region->region, binding), AsIntSet(dom));
+}
+
 }  // namespace tir
 }  // namespace tvm
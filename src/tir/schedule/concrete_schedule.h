@@ -78,13 +78,28 @@ class ConcreteScheduleNode : public ScheduleNode {
   BlockRV GetBlock(const String& name, const String& func_name = "main") override;
   Array<LoopRV> GetLoops(const BlockRV& block_rv) override;
   /******** Schedule: loops manipulation ********/
+  LoopRV Fuse(const Array<LoopRV>& loop_rvs) override;
+  Array<LoopRV> Split(const LoopRV& loop_rv, const Array<Optional<ExprRV>>& factors) override;
+  void Reorder(const Array<LoopRV>& ordered_loop_rvs) override;
   /******** Schedule: compute location ********/
+  void ComputeAt(const BlockRV& block_rv, const LoopRV& loop_rv, bool preserve_unit_loops) override;
+  void ReverseComputeAt(const BlockRV& block_rv, const LoopRV& loop_rv,
+                        bool preserve_unit_loops) override;
   void ComputeInline(const BlockRV& block) override;
   void ReverseComputeInline(const BlockRV& block) override;
   /******** Schedule: loop binding/annotation ********/
+  void Parallel(const LoopRV& loop_rv) override;
+  void Vectorize(const LoopRV& loop_rv) override;
+  void Unroll(const LoopRV& loop_rv) override;
   /******** Schedule: cache read/write ********/
+  BlockRV CacheRead(const BlockRV& block_rv, int read_buffer_index,
+                    const String& storage_scope) override;
+  BlockRV CacheWrite(const BlockRV& block_rv, int write_buffer_index,
+                     const String& storage_scope) override;
   /******** Schedule: reduction ********/
   /******** Schedule: blockize & tensorize ********/
+  BlockRV Blockize(const LoopRV& loop_rv) override;
+  void Tensorize(const LoopRV& loop_rv, const String& intrin) override;
 
   /******** Utility functions ********/
  protected:
@@ -124,6 +139,12 @@ class ConcreteScheduleNode : public ScheduleNode {
   inline Array<ExprRV> CreateRV(const Array<PrimExpr>& exprs);
   /*! \brief Remove a random variable from the symbol table */
   inline void RemoveFromSymbolTable(const ObjectRef& rv);
+  /*!
+   * \brief Get the srefs of a list of loop random variables
+   * \param loop_rvs The loop random variables to be looked up
+   * \return The corresponding loop srefs
+   */
+  inline Array<StmtSRef> GetSRefs(const Array<LoopRV>& loop_rvs) const;
 };
 
 // implementations
@@ -143,6 +164,10 @@ inline For ConcreteScheduleNode::Get(const LoopRV& loop_rv) const {
 }
 
 inline PrimExpr ConcreteScheduleNode::Get(const ExprRV& expr_rv) const {
+  if (expr_rv->IsInstance<IntImmNode>()) {
+    // Constant integers are not random variables, and evaluate to themselves
+    return expr_rv;
+  }
   auto it = this->symbol_table_.find(expr_rv);
   if (it == this->symbol_table_.end()) {
     LOG(FATAL) << "IndexError: Cannot find corresponding ExprRV: " << expr_rv;
@@ -198,6 +223,15 @@ inline StmtSRef ConcreteScheduleNode::GetSRef(const LoopRV& loop_rv) const {
   return GetRef<StmtSRef>(sref);
 }
 
+inline Array<StmtSRef> ConcreteScheduleNode::GetSRefs(const Array<LoopRV>& loop_rvs) const {
+  Array<StmtSRef> result;
+  result.reserve(loop_rvs.size());
+  for (const LoopRV& loop_rv : loop_rvs) {
+    result.push_back(this->GetSRef(loop_rv));
+  }
+  return result;
+}
+
 /******** Adding/Removing elements in the symbol table ********/
 
 template <class T>
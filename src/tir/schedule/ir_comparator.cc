@@ -0,0 +1,299 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "./utils.h"
+
+namespace tvm {
+namespace tir {
+
+/******** Tensorize Comparator ********/
+
+bool TensorizeComparator::VisitExpr(const PrimExpr& n, const PrimExpr& other) {
+  if (n.same_as(other)) {
+    return true;
+  }
+  if (n->type_index() != other->type_index() || n.dtype() != other.dtype()) {
+    return false;
+  }
+  return ExprComparator::VisitExpr(n, other);
+}
+
+bool TensorizeComparator::VisitStmt(const Stmt& n, const Stmt& other) {
+  if (n.same_as(other)) {
+    return true;
+  }
+  if (n->type_index() != other->type_index()) {
+    return false;
+  }
+  return StmtComparator::VisitStmt(n, other);
+}
+
+bool TensorizeComparator::VisitExprDefault_(const Object* op, const PrimExpr& other) {
+  return false;
+}
+
+bool TensorizeComparator::VisitStmtDefault_(const Object* op, const Stmt& other) { return false; }
+
+// Stmts
+
+bool TensorizeComparator::VisitStmt_(const ForNode* op, const Stmt& other) {
+  const auto* rhs = other.as<ForNode>();
+  if (!analyzer_->CanProveEqual(op->min, rhs->min) ||
+      !analyzer_->CanProveEqual(op->extent, rhs->extent)) {
+    return false;
+  }
+  return DefEqual(op->loop_var, rhs->loop_var) && VisitStmt(op->body, rhs->body);
+}
+
+bool TensorizeComparator::VisitStmt_(const SeqStmtNode* op, const Stmt& other) {
+  const auto* rhs = other.as<SeqStmtNode>();
+  return CompareArray(op->seq, rhs->seq, &TensorizeComparator::VisitStmt);
+}
+
+bool TensorizeComparator::VisitStmt_(const IfThenElseNode* op, const Stmt& other) {
+  const auto* rhs = other.as<IfThenElseNode>();
+  if (op->else_case.defined() != rhs->else_case.defined()) {
+    return false;
+  }
+  return VisitExpr(op->condition, rhs->condition) && VisitStmt(op->then_case, rhs->then_case) &&
+         (!op->else_case.defined() || VisitStmt(op->else_case, rhs->else_case));
+}
+
+bool TensorizeComparator::VisitStmt_(const EvaluateNode* op, const Stmt& other) {
+  const auto* rhs = other.as<EvaluateNode>();
+  return VisitExpr(op->value, rhs->value);
+}
+
+bool TensorizeComparator::VisitStmt_(const BufferStoreNode* op, const Stmt& other) {
+  const auto* rhs = other.as<BufferStoreNode>();
+  return CompareBuffer(op->buffer, rhs->buffer) &&
+         CompareBufferIndices(op->buffer, rhs->buffer, op->indices, rhs->indices) &&
+         VisitExpr(op->value, rhs->value);
+}
+
+bool TensorizeComparator::VisitStmt_(const BlockRealizeNode* op, const Stmt& other) {
+  const auto* rhs = other.as<BlockRealizeNode>();
+  return CompareArray(op->iter_values, rhs->iter_values, &TensorizeComparator::VisitExpr) &&
+         VisitExpr(op->predicate, rhs->predicate) && VisitStmt(op->block, rhs->block);
+}
+
+bool TensorizeComparator::VisitStmt_(const BlockNode* op, const Stmt& other) {
+  const auto* rhs = other.as<BlockNode>();
+  // Only the computation is compared. The buffer allocations inside the block are not supported.
+  if (!op->alloc_buffers.empty() || !rhs->alloc_buffers.empty()) {
+    return false;
+  }
+  if (op->iter_vars.size() != rhs->iter_vars.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < op->iter_vars.size(); ++i) {
+    const IterVar& lhs_iter = op->iter_vars[i];
+    const IterVar& rhs_iter = rhs->iter_vars[i];
+    if (lhs_iter->iter_type != rhs_iter->iter_type ||
+        !analyzer_->CanProveEqual(lhs_iter->dom->extent, rhs_iter->dom->extent) ||
+        !DefEqual(lhs_iter->var, rhs_iter->var)) {
+      return false;
+    }
+  }
+  if (op->init.defined() != rhs->init.defined()) {
+    return false;
+  }
+  if (op->init.defined() && !VisitStmt(op->init.value(), rhs->init.value())) {
+    return false;
+  }
+  return VisitStmt(op->body, rhs->body);
+}
+
+// Exprs
+
+#define TVM_DECLARE_TENSORIZE_COMPARATOR_BINOP(OpName)                            \
+  bool TensorizeComparator::VisitExpr_(const OpName* op, const PrimExpr& other) { \
+    const auto* rhs = other.as<OpName>();                                         \
+    return VisitExpr(op->a, rhs->a) && VisitExpr(op->b, rhs->b);                  \
+  }
+
+TVM_DECLARE_TENSORIZE_COMPARATOR_BINOP(AddNode);
+TVM_DECLARE_TENSORIZE_COMPARATOR_BINOP(SubNode);
+TVM_DECLARE_TENSORIZE_COMPARATOR_BINOP(MulNode);
+TVM_DECLARE_TENSORIZE_COMPARATOR_BINOP(DivNode);
+TVM_DECLARE_TENSORIZE_COMPARATOR_BINOP(ModNode);
+TVM_DECLARE_TENSORIZE_COMPARATOR_BINOP(FloorDivNode);
+TVM_DECLARE_TENSORIZE_COMPARATOR_BINOP(FloorModNode);
+TVM_DECLARE_TENSORIZE_COMPARATOR_BINOP(MinNode);
+TVM_DECLARE_TENSORIZE_COMPARATOR_BINOP(MaxNode);
+TVM_DECLARE_TENSORIZE_COMPARATOR_BINOP(EQNode);
+TVM_DECLARE_TENSORIZE_COMPARATOR_BINOP(NENode);
+TVM_DECLARE_TENSORIZE_COMPARATOR_BINOP(LTNode);
+TVM_DECLARE_TENSORIZE_COMPARATOR_BINOP(LENode);
+TVM_DECLARE_TENSORIZE_COMPARATOR_BINOP(GTNode);
+TVM_DECLARE_TENSORIZE_COMPARATOR_BINOP(GENode);
+TVM_DECLARE_TENSORIZE_COMPARATOR_BINOP(AndNode);
+TVM_DECLARE_TENSORIZE_COMPARATOR_BINOP(OrNode);
+
+#undef TVM_DECLARE_TENSORIZE_COMPARATOR_BINOP
+
+bool TensorizeComparator::VisitExpr_(const NotNode* op, const PrimExpr& other) {
+  const auto* rhs = other.as<NotNode>();
+  return VisitExpr(op->a, rhs->a);
+}
+
+bool TensorizeComparator::VisitExpr_(const SelectNode* op, const PrimExpr& other) {
+  const auto* rhs = other.as<SelectNode>();
+  return VisitExpr(op->condition, rhs->condition) && VisitExpr(op->true_value, rhs->true_value) &&
+         VisitExpr(op->false_value, rhs->false_value);
+}
+
+bool TensorizeComparator::VisitExpr_(const CastNode* op, const PrimExpr& other) {
+  const auto* rhs = other.as<CastNode>();
+  return VisitExpr(op->value, rhs->value);
+}
+
+bool TensorizeComparator::VisitExpr_(const CallNode* op, const PrimExpr& other) {
+  const auto* rhs = other.as<CallNode>();
+  return op->op.same_as(rhs->op) &&
+         CompareArray(op->args, rhs->args, &TensorizeComparator::VisitExpr);
+}
+
+bool TensorizeComparator::VisitExpr_(const BroadcastNode* op, const PrimExpr& other) {
+  const auto* rhs = other.as<BroadcastNode>();
+  return op->lanes == rhs->lanes && VisitExpr(op->value, rhs->value);
+}
+
+bool TensorizeComparator::VisitExpr_(const RampNode* op, const PrimExpr& other) {
+  const auto* rhs = other.as<RampNode>();
+  return op->lanes == rhs->lanes && VisitExpr(op->base, rhs->base) &&
+         VisitExpr(op->stride, rhs->stride);
+}
+
+bool TensorizeComparator::VisitExpr_(const VarNode* op, const PrimExpr& other) {
+  const auto* rhs = other.as<VarNode>();
+  auto it = equal_map_.find(GetRef<Var>(rhs));
+  if (it == equal_map_.end()) {
+    return false;
+  }
+  return it->second.get() == op;
+}
+
+bool TensorizeComparator::VisitExpr_(const IntImmNode* op, const PrimExpr& other) {
+  return op->value == other.as<IntImmNode>()->value;
+}
+
+bool TensorizeComparator::VisitExpr_(const FloatImmNode* op, const PrimExpr& other) {
+  return op->value == other.as<FloatImmNode>()->value;
+}
+
+bool TensorizeComparator::VisitExpr_(const StringImmNode* op, const PrimExpr& other) {
+  return op->value == other.as<StringImmNode>()->value;
+}
+
+bool TensorizeComparator::VisitExpr_(const BufferLoadNode* op, const PrimExpr& other) {
+  const auto* rhs = other.as<BufferLoadNode>();
+  return CompareBuffer(op->buffer, rhs->buffer) &&
+         CompareBufferIndices(op->buffer, rhs->buffer, op->indices, rhs->indices);
+}
+
+// Helpers
+
+bool TensorizeComparator::DefEqual(const Var& lhs, const Var& rhs) {
+  if (lhs->dtype != rhs->dtype) {
+    return false;
+  }
+  auto it = equal_map_.find(rhs);
+  if (it != equal_map_.end()) {
+    return it->second.same_as(lhs);
+  }
+  equal_map_[rhs] = lhs;
+  lhs_defined_vars_.insert(lhs.get());
+  return true;
+}
+
+bool TensorizeComparator::CompareBuffer(const Buffer& lhs, const Buffer& rhs) {
+  auto it = rhs_buffer_map_.find(rhs);
+  if (it != rhs_buffer_map_.end()) {
+    return it->second.same_as(lhs);
+  }
+  // The buffer in the workload may have more dimensions than the one in the description, whose
+  // leading dimensions are fixed during the computation
+  if (lhs->dtype != rhs->dtype || lhs->shape.size() < rhs->shape.size()) {
+    return false;
+  }
+  rhs_buffer_map_[rhs] = lhs;
+  return true;
+}
+
+bool TensorizeComparator::CompareBufferIndices(const Buffer& lhs, const Buffer& rhs,
+                                               const Array<PrimExpr>& lhs_indices,
+                                               const Array<PrimExpr>& rhs_indices) {
+  if (lhs_indices.size() != lhs->shape.size() || rhs_indices.size() != rhs->shape.size()) {
+    return false;
+  }
+  auto f_uses_defined_var = [this](const PrimExpr& expr) {
+    return ExprUseVar(expr, [this](const VarNode* var) { return lhs_defined_vars_.count(var); });
+  };
+  int offset = static_cast<int>(lhs_indices.size()) - static_cast<int>(rhs_indices.size());
+  Array<PrimExpr> indices_base;
+  indices_base.reserve(lhs_indices.size());
+  for (int i = 0; i < offset; ++i) {
+    indices_base.push_back(lhs_indices[i]);
+  }
+  for (int i = 0; i < static_cast<int>(rhs_indices.size()); ++i) {
+    PrimExpr rhs_index = Substitute(rhs_indices[i], [this](const Var& var) -> Optional<PrimExpr> {
+      auto it = equal_map_.find(var);
+      if (it == equal_map_.end()) {
+        return NullOpt;
+      }
+      return Downcast<PrimExpr>(it->second);
+    });
+    indices_base.push_back(analyzer_->Simplify(lhs_indices[i + offset] - rhs_index));
+  }
+  // The offset is required to be invariant inside the computation
+  for (const PrimExpr& base : indices_base) {
+    if (f_uses_defined_var(base)) {
+      return false;
+    }
+  }
+  auto it = buffer_indices_.find(lhs);
+  if (it == buffer_indices_.end()) {
+    buffer_indices_.emplace(lhs, std::move(indices_base));
+    return true;
+  }
+  const Array<PrimExpr>& recorded = it->second;
+  for (size_t i = 0; i < recorded.size(); ++i) {
+    if (!analyzer_->CanProveEqual(recorded[i], indices_base[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool TensorizeComparator::CompareArray(const Array<T>& lhs, const Array<T>& rhs,
+                                       bool (TensorizeComparator::*cmp)(const T&, const T&)) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs.size(); ++i) {
+    if (!(this->*cmp)(lhs[i], rhs[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace tir
+}  // namespace tvm
@@ -25,8 +25,76 @@ namespace tvm {
 namespace tir {
 
 /******** Schedule: loops manipulation ********/
+/*!
+ * \brief Split a loop into a list of consecutive loops. It requires:
+ * 1) The loop can't have annotation or thread binding.
+ * 2) The loop must start with 0.
+ * \param self The state of the schedule
+ * \param loop_sref The sref to the loop being split
+ * \param factors The splitting factors
+ * \return An array of srefs to the loops after splitting
+ */
+TVM_DLL Array<StmtSRef> Split(ScheduleState self, const StmtSRef& loop_sref,
+                              const Array<PrimExpr>& factors);
+/*!
+ * \brief Fuse a list of consecutive loops into one. It requires:
+ * 1) The loops can't have annotations or thread bindings.
+ * 2) The (i+1)-th loop must be the only child of the i-th loop.
+ * 3) All loops must start with 0.
+ * \param self The state of the schedule
+ * \param loop_srefs An array of srefs to the loops to be fused
+ * \return The sref to the fused loop
+ */
+TVM_DLL StmtSRef Fuse(ScheduleState self, const Array<StmtSRef>& loop_srefs);
+/*!
+ * \brief Reorder a list of loops. It doesn't require the loops to be consecutive.
+ * It requires:
+ * 1) The loops are in the same chain. That means: the loops can be ordered to [l_1, l_2, ... ,
+ *     l_n] where l_i is an ancestor of l_{i+1} and there are only single-branch loops between
+ *     l_1 and l_n (which also indicates they are under the same scope).
+ * 2) After reordering, the domain of an outer loop cannot depend on any of the inner loops.
+ * 3) For every block under the loop nests, its block binding must be affine, and the block
+ *    variables must be either data parallel or reduction.
+ * 4) No duplicated loops are allowed in the arguments.
+ * \param self The state of the schedule
+ * \param ordered_loop_srefs An array of srefs which indicates the new order of loops
+ */
+TVM_DLL void Reorder(ScheduleState self, const Array<StmtSRef>& ordered_loop_srefs);
 
 /******** Schedule: compute location ********/
+/*!
+ * \brief Move a producer block under the specific loop, and regenerate the loops induced by the
+ * block so that the buffer region produced by the producer block could cover those regions read by
+ * the consumers under the given loop. It requires:
+ * 1) `block` and `loop` are under the same scope, and `loop` is not the ancestor of `block`
+ * 2) The scope block has stage-pipeline property
+ * 3) The block is a complete block or a reduction block, and it is the only writer of the buffers
+ * it writes
+ * 4) All the consumers of the block are under the given loop, and there is a position in the body
+ * of the loop after all the producers and before all the consumers of the block
+ * \param self The schedule state
+ * \param block_sref The block to be moved
+ * \param loop_sref The loop where the block to be moved to
+ * \param preserve_unit_loops Whether to keep the trivial loops whose extents are 1
+ */
+TVM_DLL void ComputeAt(ScheduleState self, const StmtSRef& block_sref, const StmtSRef& loop_sref,
+                       bool preserve_unit_loops);
+/*!
+ * \brief Move a consumer block under the specific loop, and regenerate the loops induced by the
+ * block so that the buffer region consumed by the consumer block could cover those regions written
+ * by the producers under the given loop. It requires:
+ * 1) `block` and `loop` are under the same scope, and `loop` is not the ancestor of `block`
+ * 2) The scope block has stage-pipeline property
+ * 3) The block is a complete block
+ * 4) All the producers of the block are under the given loop, and there is a position in the body
+ * of the loop after all the producers and before all the consumers of the block
+ * \param self The schedule state
+ * \param block_sref The block to be moved
+ * \param loop_sref The loop where the block to be moved to
+ * \param preserve_unit_loops Whether to keep the trivial loops whose extents are 1
+ */
+TVM_DLL void ReverseComputeAt(ScheduleState self, const StmtSRef& block_sref,
+                              const StmtSRef& loop_sref, bool preserve_unit_loops);
 /*!
  * \brief Inline a block into its consumer(s). It requires:
  * 1) The block is a complete non-root block, which only produces one buffer
@@ -54,12 +122,81 @@ TVM_DLL void ComputeInline(ScheduleState self, const StmtSRef& block_sref);
 TVM_DLL void ReverseComputeInline(ScheduleState self, const StmtSRef& block_sref);
 
 /******** Schedule: loop binding/annotation ********/
+/*!
+ * \brief Parallelize the input loop. It requires:
+ * 1) The scope block that the loop is in should have stage-pipeline property
+ * 2) All the blocks under the loop have affine bindings
+ * 3) For each block under the loop, the loop can only be contained in data-parallel block iters'
+ * bindings
+ * \param self The state of the schedule
+ * \param loop_sref The sref of the loop to be parallelized
+ */
+TVM_DLL void Parallel(ScheduleState self, const StmtSRef& loop_sref);
+/*!
+ * \brief Vectorize the input loop. It requires:
+ * 1) The scope block that the loop is in should have stage-pipeline property
+ * 2) All the blocks under the loop have affine bindings
+ * 3) For each block under the loop, the loop can only be contained in data-parallel block iters'
+ * bindings
+ * \param self The state of the schedule
+ * \param loop_sref The sref of the loop to be vectorized
+ */
+TVM_DLL void Vectorize(ScheduleState self, const StmtSRef& loop_sref);
+/*!
+ * \brief Unroll the input loop. It requires nothing
+ * \param self The state of the schedule
+ * \param loop_sref The loop to be unrolled
+ */
+TVM_DLL void Unroll(ScheduleState self, const StmtSRef& loop_sref);
 
 /******** Schedule: cache read/write ********/
+/*!
+ * \brief Create a block that reads a buffer region into a read cache. It requires:
+ * 1) There is at most one block who writes the buffer in the scope.
+ * 2) The scope block has stage-pipeline property.
+ * \param self The state of the schedule
+ * \param block_sref The consumer block of the target buffer.
+ * \param read_buffer_index The index of the buffer in block's read region.
+ * \param storage_scope The target storage scope.
+ * \return The cache stage block.
+ */
+TVM_DLL StmtSRef CacheRead(ScheduleState self, const StmtSRef& block_sref, int read_buffer_index,
+                           const String& storage_scope);
+/*!
+ * \brief Create a block that writes a buffer region into a write cache. It requires:
+ * 1) There is only one block who writes the target buffer.
+ * 2) The scope block has stage-pipeline property.
+ * \param self The state of the schedule
+ * \param block_sref The producer of the buffer
+ * \param write_buffer_index The index of the buffer in block's write region
+ * \param storage_scope The target storage scope
+ * \return The cache stage block.
+ */
+TVM_DLL StmtSRef CacheWrite(ScheduleState self, const StmtSRef& block_sref, int write_buffer_index,
+                            const String& storage_scope);
 
 /******** Schedule: reduction ********/
 
 /******** Schedule: blockize & tensorize ********/
+/*!
+ * \brief Convert the subtree rooted at a specific loop into a block. The block vars of the original
+ * block are divided into the ones bound to the loops outside the subtree, which become the block
+ * vars of the new outer block, and the ones bound to the loops inside the subtree.
+ * \param self The state of the schedule
+ * \param loop_sref The root of the subtree, which contains only nested loops and a single block
+ * \return The new outer block
+ */
+TVM_DLL StmtSRef Blockize(ScheduleState self, const StmtSRef& loop_sref);
+/*!
+ * \brief Tensorize the computation enclosed by a loop with a tensor intrinsic. The subtree of the
+ * loop is blockized first, and its computation is required to match the description of the
+ * intrinsic structurally, with each buffer access shifted by a fixed offset. The body of the new
+ * block is then replaced by the implementation of the intrinsic.
+ * \param self The state of the schedule
+ * \param loop_sref The loop to be tensorized
+ * \param intrin The tensor intrinsic
+ */
+TVM_DLL void Tensorize(ScheduleState self, const StmtSRef& loop_sref, const TensorIntrin& intrin);
 
 }  // namespace tir
 }  // namespace tvm
@@ -0,0 +1,514 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "../utils.h"
+
+namespace tvm {
+namespace tir {
+
+/******** Error Classes ********/
+
+class NotSingleBlockUnderLoopError : public ScheduleError {
+ public:
+  explicit NotSingleBlockUnderLoopError(IRModule mod, For loop)
+      : mod_(std::move(mod)), loop_(std::move(loop)) {}
+
+  String FastErrorString() const final {
+    return "ScheduleError: The loop is required to have only nested loops and a single block "
+           "under it";
+  }
+
+  String DetailRenderTemplate() const final {
+    return "The loop {0} is required to have only nested loops and a single block under it";
+  }
+
+  IRModule mod() const final { return mod_; }
+  Array<ObjectRef> LocationsOfInterest() const final { return {loop_}; }
+
+  IRModule mod_;
+  For loop_;
+};
+
+class SubspaceNotDivisibleError : public ScheduleError {
+ public:
+  explicit SubspaceNotDivisibleError(IRModule mod, For scope_loop, Block block)
+      : mod_(std::move(mod)), scope_loop_(std::move(scope_loop)), block_(std::move(block)) {}
+
+  String FastErrorString() const final {
+    return "ScheduleError: The bindings of the block below can not be blockized";
+  }
+
+  String DetailRenderTemplate() const final {
+    return "The bindings of the block {0} below can not be blockized by the loops starting at {1}";
+  }
+
+  IRModule mod() const final { return mod_; }
+  Array<ObjectRef> LocationsOfInterest() const final { return {block_, scope_loop_}; }
+
+  IRModule mod_;
+  For scope_loop_;
+  Block block_;
+};
+
+class TensorizeError : public ScheduleError {
+ public:
+  explicit TensorizeError(IRModule mod, Block block) : mod_(std::move(mod)), block_(block) {}
+
+  String FastErrorString() const final {
+    return "ScheduleError: The computation doesn't match the description of the tensor intrinsic";
+  }
+
+  String DetailRenderTemplate() const final {
+    return "The computation in block {0} doesn't match the description of the tensor intrinsic";
+  }
+
+  IRModule mod() const final { return mod_; }
+  Array<ObjectRef> LocationsOfInterest() const final { return {block_}; }
+
+  IRModule mod_;
+  Block block_;
+};
+
+/******** Blockize ********/
+
+/*!
+ * \brief Collect the nested loops starting at the given loop, and the only block under them
+ * \param self The schedule state
+ * \param loop_sref The outermost loop
+ * \param loops The nested loops, from outer to inner
+ * \return The block realize of the only block under the loops
+ * \throw ScheduleError If there are statements other than nested loops and a single block
+ */
+BlockRealize CheckGetSingleChildBlockRealize(const ScheduleState& self, const StmtSRef& loop_sref,
+                                             Array<For>* loops) {
+  const ForNode* loop = TVM_SREF_TO_FOR(loop, loop_sref);
+  Stmt stmt = GetRef<For>(loop);
+  while (const auto* for_node = stmt.as<ForNode>()) {
+    loops->push_back(GetRef<For>(for_node));
+    stmt = for_node->body;
+  }
+  if (const auto* realize = stmt.as<BlockRealizeNode>()) {
+    return GetRef<BlockRealize>(realize);
+  }
+  throw NotSingleBlockUnderLoopError(self->mod, GetRef<For>(loop));
+}
+
+/*!
+ * \brief Relax the buffer regions over the given domain of variables
+ * \param regions The buffer regions to be relaxed
+ * \param dom_map The domain of the variables to be relaxed
+ * \param analyzer The analyzer
+ * \return The relaxed regions
+ */
+Array<BufferRegion> RelaxBufferRegions(const Array<BufferRegion>& regions,
+                                       const Map<Var, Range>& dom_map, arith::Analyzer* analyzer) {
+  Array<BufferRegion> result;
+  result.reserve(regions.size());
+  for (const BufferRegion& region : regions) {
+    Array<arith::IntSet> int_sets = arith::EvalSet(region->region, AsIntSet(dom_map));
+    Region relaxed;
+    relaxed.reserve(int_sets.size());
+    for (size_t i = 0; i < int_sets.size(); ++i) {
+      const arith::IntSet& int_set = int_sets[i];
+      if (int_set.HasLowerBound() && int_set.HasUpperBound()) {
+        PrimExpr min = analyzer->Simplify(int_set.min());
+        PrimExpr extent = analyzer->Simplify(int_set.max() - int_set.min() + 1);
+        relaxed.push_back(Range::FromMinExtent(min, extent));
+      } else {
+        relaxed.push_back(Range::FromMinExtent(0, region->buffer->shape[i]));
+      }
+    }
+    result.push_back(BufferRegion(region->buffer, relaxed));
+  }
+  return result;
+}
+
+/*!
+ * \brief Generate the outer block that wraps the subtree of the given loop, without mutating the
+ * schedule state
+ * \param self The schedule state
+ * \param loop_sref The root of the subtree to be blockized
+ * \param block_sref_reuse Maps the original block to the inner block
+ * \return The block realize of the outer block, which replaces the loop
+ */
+BlockRealize GenerateBlockizedOuterBlock(const ScheduleState& self, const StmtSRef& loop_sref,
+                                         Map<Block, Block>* block_sref_reuse) {
+  const ForNode* loop = TVM_SREF_TO_FOR(loop, loop_sref);
+  // Step 1. Collect the loops and the block under the loop
+  Array<For> inner_loops;
+  BlockRealize block_realize = CheckGetSingleChildBlockRealize(self, loop_sref, &inner_loops);
+  const Block& block = block_realize->block;
+  const StmtSRef& block_sref = self->stmt2ref.at(block.get());
+  // Step 2. Divide the block bindings into the part of the outer loops and the part of the inner
+  // loops
+  arith::Analyzer analyzer;
+  Array<Var> inner_loop_vars;
+  inner_loop_vars.reserve(inner_loops.size());
+  for (const For& inner_loop : inner_loops) {
+    inner_loop_vars.push_back(inner_loop->loop_var);
+  }
+  Array<Array<arith::IterMark>> division = arith::SubspaceDivide(
+      block_realize->iter_values, LoopDomainOfSRefTreePath(GetRef<StmtSRef>(block_sref->parent)),
+      inner_loop_vars, block_realize->predicate, /*require_bijective=*/false, &analyzer);
+  if (division.empty()) {
+    throw SubspaceNotDivisibleError(self->mod, GetRef<For>(loop), block);
+  }
+  PrimExpr outer_predicate = division.back()[0]->extent;
+  PrimExpr inner_predicate = division.back()[1]->extent;
+  // Step 3. Generate the block vars of the outer block and the inner block. Each block var `v` is
+  // split into `v_o * inner_extent + v`, where `v_o` is a new block var of the outer block
+  Array<IterVar> outer_iter_vars;
+  Array<PrimExpr> outer_bindings;
+  Array<IterVar> inner_iter_vars;
+  Array<PrimExpr> inner_bindings;
+  Map<Var, PrimExpr> block_var_subst;
+  Map<Var, Range> inner_block_var_doms;
+  bool has_outer_reduction = false;
+  for (size_t i = 0; i < block->iter_vars.size(); ++i) {
+    const IterVar& iter_var = block->iter_vars[i];
+    const arith::IterMark& outer_mark = division[i][0];
+    const arith::IterMark& inner_mark = division[i][1];
+    PrimExpr outer_binding =
+        arith::NormalizeIterMapToExpr(Downcast<arith::IterMapExpr>(outer_mark->source));
+    PrimExpr inner_binding =
+        arith::NormalizeIterMapToExpr(Downcast<arith::IterMapExpr>(inner_mark->source));
+    Optional<Var> outer_var = NullOpt;
+    if (!is_one(outer_mark->extent)) {
+      IterVar outer_iter(/*dom=*/Range::FromMinExtent(0, outer_mark->extent),
+                         /*var=*/iter_var->var.copy_with_suffix("o"),
+                         /*iter_type=*/iter_var->iter_type);
+      outer_iter_vars.push_back(outer_iter);
+      outer_bindings.push_back(outer_binding);
+      outer_var = outer_iter->var;
+      has_outer_reduction = has_outer_reduction || iter_var->iter_type == kCommReduce;
+    }
+    if (!is_one(inner_mark->extent) || !outer_var.defined()) {
+      IterVar inner_iter(/*dom=*/Range::FromMinExtent(0, inner_mark->extent),
+                         /*var=*/iter_var->var,
+                         /*iter_type=*/iter_var->iter_type);
+      inner_iter_vars.push_back(inner_iter);
+      inner_bindings.push_back(inner_binding);
+      inner_block_var_doms.Set(iter_var->var, inner_iter->dom);
+      if (outer_var.defined()) {
+        block_var_subst.Set(iter_var->var, outer_var.value() * inner_mark->extent + iter_var->var);
+      } else if (!is_zero(outer_binding)) {
+        block_var_subst.Set(iter_var->var, outer_binding + iter_var->var);
+      }
+    } else {
+      block_var_subst.Set(iter_var->var, outer_var.value());
+    }
+  }
+  // Step 4. Generate the inner block. Its init statement is moved to the outer block if the outer
+  // block is a reduction block.
+  auto f_subst_regions = [&block_var_subst](const Array<BufferRegion>& regions) {
+    Array<BufferRegion> result;
+    result.reserve(regions.size());
+    for (const BufferRegion& region : regions) {
+      result.push_back(BufferRegion(region->buffer, Substitute(region->region, block_var_subst)));
+    }
+    return result;
+  };
+  Block inner_block = block;
+  {
+    BlockNode* n = inner_block.CopyOnWrite();
+    n->iter_vars = inner_iter_vars;
+    n->reads = f_subst_regions(block->reads);
+    n->writes = f_subst_regions(block->writes);
+    n->body = Substitute(block->body, block_var_subst);
+    if (has_outer_reduction || !block->init.defined()) {
+      n->init = NullOpt;
+    } else {
+      n->init = Substitute(block->init.value(), block_var_subst);
+    }
+  }
+  // Step 5. Generate the init statement of the outer block, which loops over the inner data
+  // parallel block vars
+  Optional<Stmt> outer_init = NullOpt;
+  if (has_outer_reduction && block->init.defined()) {
+    Stmt init = Substitute(block->init.value(), block_var_subst);
+    std::vector<Var> init_loop_vars;
+    std::vector<PrimExpr> init_loop_extents;
+    Map<Var, PrimExpr> init_subst;
+    for (const IterVar& inner_iter : inner_iter_vars) {
+      if (inner_iter->iter_type == kDataPar && ExprUseVar(init, inner_iter->var)) {
+        Var init_loop_var = inner_iter->var.copy_with_suffix("_init");
+        init_subst.Set(inner_iter->var, init_loop_var);
+        init_loop_vars.push_back(init_loop_var);
+        init_loop_extents.push_back(inner_iter->dom->extent);
+      }
+    }
+    init = Substitute(init, init_subst);
+    for (int i = static_cast<int>(init_loop_vars.size()) - 1; i >= 0; --i) {
+      init = For(/*loop_var=*/init_loop_vars[i],
+                 /*min=*/0,
+                 /*extent=*/init_loop_extents[i],
+                 /*kind=*/ForKind::kSerial,
+                 /*body=*/init);
+    }
+    outer_init = init;
+  }
+  // Step 6. Generate the body of the outer block, i.e. the inner loops and the inner block
+  Stmt body = BlockRealize(/*iter_values=*/inner_bindings,
+                           /*predicate=*/inner_predicate,
+                           /*block=*/inner_block);
+  for (int i = static_cast<int>(inner_loops.size()) - 1; i >= 0; --i) {
+    ObjectPtr<ForNode> n = make_object<ForNode>(*inner_loops[i].get());
+    n->body = body;
+    body = For(n);
+  }
+  // Step 7. Generate the outer block, whose regions are the ones of the inner block relaxed over
+  // the inner block vars
+  Block outer_block(/*iter_vars=*/outer_iter_vars,
+                    /*reads=*/RelaxBufferRegions(inner_block->reads, inner_block_var_doms, &analyzer),
+                    /*writes=*/
+                    RelaxBufferRegions(inner_block->writes, inner_block_var_doms, &analyzer),
+                    /*name_hint=*/block->name_hint + "_o",
+                    /*body=*/body,
+                    /*init=*/outer_init);
+  block_sref_reuse->Set(block, inner_block);
+  return BlockRealize(/*iter_values=*/outer_bindings,
+                      /*predicate=*/outer_predicate,
+                      /*block=*/outer_block);
+}
+
+StmtSRef Blockize(ScheduleState self, const StmtSRef& loop_sref) {
+  StmtSRef scope_root_sref = GetScopeRoot(loop_sref).value();
+  Map<Block, Block> block_sref_reuse;
+  BlockRealize outer_realize = GenerateBlockizedOuterBlock(self, loop_sref, &block_sref_reuse);
+  self->Replace(loop_sref, outer_realize, block_sref_reuse);
+  self->UpdateScopeBlockInfo(GetBlockRealize(self, scope_root_sref));
+  return self->stmt2ref.at(outer_realize->block.get());
+}
+
+/******** Tensorize ********/
+
+/*!
+ * \brief Get the body of the description or the implementation of a tensor intrinsic, skipping
+ * the root block if there is one
+ * \param func The description or the implementation
+ * \return The body
+ */
+Stmt GetTensorIntrinBody(const PrimFunc& func) {
+  if (const auto* realize = func->body.as<BlockRealizeNode>()) {
+    if (realize->block->iter_vars.empty()) {
+      return realize->block->body;
+    }
+  }
+  return func->body;
+}
+
+/*!
+ * \brief Rewrite the implementation of a tensor intrinsic, so that it accesses the regions of the
+ * workload buffers instead of the buffers declared by the intrinsic
+ */
+class TensorIntrinImplRewriter : private StmtExprMutator {
+ public:
+  using BufferRegionMap = std::unordered_map<Buffer, BufferRegion, ObjectPtrHash, ObjectPtrEqual>;
+
+  /*!
+   * \brief Rewrite the implementation of a tensor intrinsic
+   * \param impl_body The body of the implementation
+   * \param buffer_map Maps each buffer of the implementation to the workload region it accesses
+   * \param analyzer The analyzer
+   * \return The rewritten body
+   */
+  static Stmt Rewrite(const Stmt& impl_body, const BufferRegionMap& buffer_map,
+                      arith::Analyzer* analyzer) {
+    TensorIntrinImplRewriter rewriter(buffer_map);
+    for (const auto& kv : buffer_map) {
+      rewriter.BindBufferVars(kv.first, kv.second, analyzer);
+    }
+    return rewriter(impl_body);
+  }
+
+ private:
+  explicit TensorIntrinImplRewriter(const BufferRegionMap& buffer_map) : buffer_map_(buffer_map) {}
+
+  void BindBufferVars(const Buffer& buffer, const BufferRegion& source, arith::Analyzer* analyzer) {
+    const Buffer& target = source->buffer;
+    int ndim = target->shape.size();
+    Array<PrimExpr> strides = target->strides;
+    if (strides.empty()) {
+      std::vector<PrimExpr> compact_strides(ndim);
+      PrimExpr stride = make_const(DataType::Int(32), 1);
+      for (int i = ndim - 1; i >= 0; --i) {
+        compact_strides[i] = stride;
+        stride = stride * target->shape[i];
+      }
+      strides = Array<PrimExpr>{compact_strides.begin(), compact_strides.end()};
+    }
+    PrimExpr elem_offset = target->elem_offset;
+    for (int i = 0; i < ndim; ++i) {
+      elem_offset = elem_offset + source->region[i]->min * strides[i];
+    }
+    var_map_[buffer->data.get()] = target->data;
+    if (const auto* var = buffer->elem_offset.as<VarNode>()) {
+      var_map_[var] = analyzer->Simplify(elem_offset);
+    } else {
+      // A fixed offset is used as is by the implementation, e.g. in access_ptr, so it can only
+      // address a region that starts exactly at that offset.
+      CHECK(analyzer->CanProveEqual(buffer->elem_offset, elem_offset))
+          << "ValueError: The buffer " << buffer->name
+          << " in the implementation of the tensor intrinsic has a fixed elem_offset "
+          << buffer->elem_offset << ", but the matched region of " << target->name
+          << " starts at offset " << analyzer->Simplify(elem_offset)
+          << ". Declare the elem_offset of the buffer as a variable, e.g. with "
+             "offset_factor in T.match_buffer.";
+    }
+    int offset = ndim - static_cast<int>(buffer->strides.size());
+    for (int i = 0; i < static_cast<int>(buffer->strides.size()); ++i) {
+      if (const auto* var = buffer->strides[i].as<VarNode>()) {
+        var_map_[var] = strides[offset + i];
+      }
+    }
+  }
+
+  Array<PrimExpr> RewriteIndices(const BufferRegion& source, const Array<PrimExpr>& indices) {
+    int offset = static_cast<int>(source->region.size()) - static_cast<int>(indices.size());
+    Array<PrimExpr> result;
+    result.reserve(source->region.size());
+    for (int i = 0; i < offset; ++i) {
+      result.push_back(source->region[i]->min);
+    }
+    for (int i = 0; i < static_cast<int>(indices.size()); ++i) {
+      result.push_back(source->region[offset + i]->min + indices[i]);
+    }
+    return result;
+  }
+
+  Array<BufferRegion> RewriteRegions(const Array<BufferRegion>& regions) {
+    Array<BufferRegion> result;
+    result.reserve(regions.size());
+    for (const BufferRegion& region : regions) {
+      auto it = buffer_map_.find(region->buffer);
+      if (it == buffer_map_.end()) {
+        result.push_back(region);
+        continue;
+      }
+      const BufferRegion& source = it->second;
+      int offset = static_cast<int>(source->region.size()) - static_cast<int>(region->region.size());
+      Region new_region;
+      new_region.reserve(source->region.size());
+      for (int i = 0; i < offset; ++i) {
+        new_region.push_back(source->region[i]);
+      }
+      for (int i = 0; i < static_cast<int>(region->region.size()); ++i) {
+        const Range& range = region->region[i];
+        new_region.push_back(
+            Range::FromMinExtent(source->region[offset + i]->min + range->min, range->extent));
+      }
+      result.push_back(BufferRegion(source->buffer, new_region));
+    }
+    return result;
+  }
+
+  PrimExpr VisitExpr_(const VarNode* op) final {
+    auto it = var_map_.find(op);
+    return it != var_map_.end() ? it->second : GetRef<PrimExpr>(op);
+  }
+
+  PrimExpr VisitExpr_(const BufferLoadNode* op) final {
+    BufferLoad load = Downcast<BufferLoad>(StmtExprMutator::VisitExpr_(op));
+    auto it = buffer_map_.find(load->buffer);
+    if (it == buffer_map_.end()) {
+      return std::move(load);
+    }
+    return BufferLoad(it->second->buffer, RewriteIndices(it->second, load->indices));
+  }
+
+  Stmt VisitStmt_(const BufferStoreNode* op) final {
+    BufferStore store = Downcast<BufferStore>(StmtExprMutator::VisitStmt_(op));
+    auto it = buffer_map_.find(store->buffer);
+    if (it == buffer_map_.end()) {
+      return std::move(store);
+    }
+    return BufferStore(it->second->buffer, store->value,
+                       RewriteIndices(it->second, store->indices));
+  }
+
+  Stmt VisitStmt_(const BlockNode* op) final {
+    Block block = Downcast<Block>(StmtExprMutator::VisitStmt_(op));
+    BlockNode* n = block.CopyOnWrite();
+    n->reads = RewriteRegions(n->reads);
+    n->writes = RewriteRegions(n->writes);
+    return std::move(block);
+  }
+
+  /*! \brief Maps each buffer of the implementation to the workload region it accesses */
+  const BufferRegionMap& buffer_map_;
+  /*! \brief Maps the data, elem_offset and strides of the buffers to the workload ones */
+  std::unordered_map<const VarNode*, PrimExpr> var_map_;
+};
+
+void Tensorize(ScheduleState self, const StmtSRef& loop_sref, const TensorIntrin& intrin) {
+  StmtSRef scope_root_sref = GetScopeRoot(loop_sref).value();
+  // Step 1. Blockize the subtree of the loop, without mutating the schedule state
+  Map<Block, Block> block_sref_reuse;
+  BlockRealize outer_realize = GenerateBlockizedOuterBlock(self, loop_sref, &block_sref_reuse);
+  const Block& outer_block = outer_realize->block;
+  // Step 2. Match the computation of the outer block against the description of the intrinsic
+  arith::Analyzer analyzer;
+  TensorizeComparator comparator(&analyzer);
+  if (!comparator.VisitStmt(outer_block->body, GetTensorIntrinBody(intrin->desc))) {
+    throw TensorizeError(self->mod, (*block_sref_reuse.begin()).first);
+  }
+  // Step 3. Map each buffer of the implementation to the workload region it accesses. The buffers
+  // of the description and the implementation correspond by the order of their parameters.
+  const PrimFunc& desc = intrin->desc;
+  const PrimFunc& impl = intrin->impl;
+  std::unordered_map<Buffer, Buffer, ObjectPtrHash, ObjectPtrEqual> desc2impl;
+  for (size_t i = 0; i < desc->params.size(); ++i) {
+    Optional<Buffer> desc_buffer = desc->buffer_map.Get(desc->params[i]);
+    Optional<Buffer> impl_buffer = impl->buffer_map.Get(impl->params[i]);
+    if (desc_buffer.defined() && impl_buffer.defined()) {
+      desc2impl[desc_buffer.value()] = impl_buffer.value();
+    }
+  }
+  TensorIntrinImplRewriter::BufferRegionMap impl2region;
+  for (const auto& kv : comparator.rhs_buffer_map_) {
+    const Buffer& desc_buffer = kv.first;
+    const Buffer& workload_buffer = kv.second;
+    const Array<PrimExpr>& indices_base = comparator.buffer_indices_.at(workload_buffer);
+    int offset = workload_buffer->shape.size() - desc_buffer->shape.size();
+    Region region;
+    region.reserve(indices_base.size());
+    for (int i = 0; i < offset; ++i) {
+      region.push_back(Range::FromMinExtent(indices_base[i], 1));
+    }
+    for (int i = 0; i < static_cast<int>(desc_buffer->shape.size()); ++i) {
+      region.push_back(Range::FromMinExtent(indices_base[offset + i], desc_buffer->shape[i]));
+    }
+    auto it = desc2impl.find(desc_buffer);
+    CHECK(it != desc2impl.end()) << "ValueError: The buffer " << desc_buffer->name
+                                 << " in the description of the tensor intrinsic is not bound to "
+                                    "any parameter";
+    impl2region[it->second] = BufferRegion(workload_buffer, region);
+  }
+  // Step 4. Replace the body of the outer block with the implementation
+  Stmt impl_body =
+      TensorIntrinImplRewriter::Rewrite(GetTensorIntrinBody(impl), impl2region, &analyzer);
+  Block new_block = outer_block;
+  new_block.CopyOnWrite()->body = impl_body;
+  BlockRealize new_realize = outer_realize;
+  new_realize.CopyOnWrite()->block = new_block;
+  self->Replace(loop_sref, new_realize, {});
+  self->UpdateScopeBlockInfo(GetBlockRealize(self, scope_root_sref));
+}
+
+}  // namespace tir
+}  // namespace tvm
@@ -0,0 +1,522 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <limits>
+#include <vector>
+
+#include "../utils.h"
+
+namespace tvm {
+namespace tir {
+
+/******** Error Classes ********/
+
+class NotSingleWriteBlock : public ScheduleError {
+ public:
+  explicit NotSingleWriteBlock(IRModule mod, Buffer buffer, Array<StmtSRef> write_blocks)
+      : mod_(std::move(mod)), buffer_(std::move(buffer)) {
+    ICHECK_GT(write_blocks.size(), 1);
+    write_blocks_.reserve(write_blocks.size());
+    for (const StmtSRef& block_sref : write_blocks) {
+      const BlockNode* block = TVM_SREF_TO_BLOCK(block, block_sref);
+      write_blocks_.push_back(GetRef<Block>(block));
+    }
+  }
+
+  String FastErrorString() const final {
+    return "ScheduleError: The buffer is allowed to be written by single block.";
+  }
+
+  String DetailRenderTemplate() const final {
+    size_t k = write_blocks_.size();
+    return "The buffer " + buffer_->name + " is expected to be written by single block, but got " +
+           std::to_string(k) + " blocks who write it.";
+  }
+
+  IRModule mod() const final { return mod_; }
+  Array<ObjectRef> LocationsOfInterest() const final {
+    return {write_blocks_.begin(), write_blocks_.end()};
+  }
+
+ private:
+  IRModule mod_;
+  Buffer buffer_;
+  Array<Block> write_blocks_;
+};
+
+/******** Helper Functions/Classes ********/
+
+/*! \brief The auxiliary info used for the insertion point and content of the cache stage. */
+struct CacheStageInfo {
+  /*! \brief The buffer to be read. */
+  Buffer read_buffer;
+  /*! \brief The buffer to be written. */
+  Buffer write_buffer;
+  /*! \brief The buffer allocation to be inserted into the block signature. */
+  Buffer alloc;
+  /*! \brief The loop or block whose body is where the cache stage should be inserted. */
+  StmtSRef loc_sref{nullptr};
+  /*! \brief The index to insert the cache stage in the body of `loc_sref`. */
+  int loc_pos;
+  /*! \brief The cache stage to be inserted. */
+  Stmt cache_stage;
+  /*!
+   * \brief The blocks whose accesses to `redirect_src` are redirected to `redirect_dst`,
+   * including all the blocks nested in them.
+   */
+  std::unordered_set<const BlockNode*> redirected_blocks;
+  /*! \brief The buffer whose accesses are redirected. */
+  Buffer redirect_src;
+  /*! \brief The buffer the accesses are redirected to. */
+  Buffer redirect_dst;
+  /*! \brief The map used for ScheduleStateNode::Replace. */
+  Map<Block, Block> block_reuse;
+};
+
+/*!
+ * \brief Convert the integer sets of each dimension to a buffer region
+ * \param buffer The buffer the region belongs to
+ * \param int_sets The integer sets of each dimension, which are required to be bounded
+ * \param analyzer The analyzer used for simplification
+ * \return The buffer region
+ */
+BufferRegion IntSetsToBufferRegion(const Buffer& buffer, const Array<arith::IntSet>& int_sets,
+                                   arith::Analyzer* analyzer) {
+  Region region;
+  region.reserve(int_sets.size());
+  ICHECK_EQ(int_sets.size(), buffer->shape.size());
+  for (size_t i = 0; i < int_sets.size(); ++i) {
+    const arith::IntSet& int_set = int_sets[i];
+    if (int_set.HasLowerBound() && int_set.HasUpperBound()) {
+      PrimExpr min = analyzer->Simplify(int_set.min());
+      PrimExpr extent = analyzer->Simplify(int_set.max() - int_set.min() + 1);
+      region.push_back(Range::FromMinExtent(min, extent));
+    } else {
+      region.push_back(Range::FromMinExtent(0, buffer->shape[i]));
+    }
+  }
+  return BufferRegion(buffer, region);
+}
+
+/*!
+ * \brief Create a loop nest that copies the given region from `info->read_buffer` to
+ * `info->write_buffer`, and record it as `info->cache_stage`
+ * \param cache_region The region to be copied
+ * \param info The cache stage information
+ * \param storage_scope The storage scope of the cache buffer
+ * \return The block of the cache stage
+ */
+Block MakeCacheStage(const BufferRegion& cache_region, CacheStageInfo* info,
+                     const String& storage_scope) {
+  // loop variables
+  std::vector<Var> loop_vars;
+  // bindings in block realize
+  std::vector<PrimExpr> iter_values;
+  // Create loop vars and block vars' binding_value
+  for (const Range& axis_range : cache_region->region) {
+    Var loop_var("ax" + std::to_string(loop_vars.size()));
+    loop_vars.push_back(loop_var);
+    iter_values.push_back(axis_range->min + loop_var);
+  }
+  // block variables
+  Array<IterVar> block_vars;
+  // block access region for read/write buffers
+  Region access_region;
+  // indices used in block body
+  Array<PrimExpr> access_indices;
+  // Create block vars, block's accessed region and accessing indices
+  for (const PrimExpr& dim : cache_region->buffer->shape) {
+    Var var("v" + std::to_string(access_indices.size()));
+    block_vars.push_back(IterVar(/*dom=*/Range::FromMinExtent(0, dim), /*var=*/var,
+                                 /*IterVarType=*/kDataPar));
+    access_indices.push_back(var);
+    access_region.push_back(Range::FromMinExtent(var, 1));
+  }
+  // Create the body block:
+  //   reads = [read_buffer[access_region]]
+  //   writes = [write_buffer[access_region]]
+  //     write_buffer[access_indices] = read_buffer[access_indices]
+  Block block(
+      /*iter_vars=*/std::move(block_vars),
+      /*reads=*/{BufferRegion(info->read_buffer, access_region)},
+      /*writes=*/{BufferRegion(info->write_buffer, access_region)},
+      /*name_hint=*/cache_region->buffer->name + "_" + storage_scope,
+      /*body=*/
+      BufferStore(info->write_buffer, BufferLoad(info->read_buffer, access_indices),
+                  access_indices));
+  // Create the block realize node
+  Stmt body = BlockRealize(/*iter_values=*/iter_values,
+                           /*predicate=*/Bool(true),
+                           /*block=*/block);
+  // Create surrounding loops
+  for (size_t i = loop_vars.size(); i >= 1; --i) {
+    body = For(/*loop_var=*/loop_vars[i - 1],
+               /*min=*/0,
+               /*extent=*/cache_region->region[i - 1]->extent,
+               /*kind=*/ForKind::kSerial,
+               /*body=*/body);
+  }
+  info->cache_stage = std::move(body);
+  return block;
+}
+
+/*!
+ * \brief Replace the buffer in a list of buffer regions
+ * \param regions The buffer regions
+ * \param src The buffer to be replaced
+ * \param dst The buffer to be replaced to
+ * \return The new buffer regions, or the input itself if nothing is replaced
+ */
+Array<BufferRegion> ReplaceBuffer(Array<BufferRegion> regions, const Buffer& src,
+                                  const Buffer& dst) {
+  regions.MutateByApply([&src, &dst](const BufferRegion& region) -> BufferRegion {
+    return region->buffer.same_as(src) ? BufferRegion(dst, region->region) : region;
+  });
+  return regions;
+}
+
+/*!
+ * \brief Mutate the scope root block to insert the cache stage, allocate the cache buffer, and
+ * redirect the accesses of the selected blocks
+ */
+class CacheStageInserter : public StmtExprMutator {
+ public:
+  /*!
+   * \brief Rewrite the scope root block according to the cache stage information
+   * \param scope_sref The scope root block
+   * \param info The cache stage information, whose `block_reuse` is updated
+   * \return The new scope root block
+   */
+  static Block Rewrite(const StmtSRef& scope_sref, CacheStageInfo* info) {
+    CacheStageInserter inserter(scope_sref, info);
+    const BlockNode* scope_block = TVM_SREF_TO_BLOCK(scope_block, scope_sref);
+    return Downcast<Block>(inserter(GetRef<Block>(scope_block)));
+  }
+
+ private:
+  explicit CacheStageInserter(const StmtSRef& scope_sref, CacheStageInfo* info)
+      : scope_sref_(scope_sref), info_(info) {}
+
+  Stmt VisitStmt_(const ForNode* loop) final {
+    Stmt stmt = StmtExprMutator::VisitStmt_(loop);
+    if (loop == info_->loc_sref->stmt) {
+      ObjectPtr<ForNode> n = make_object<ForNode>(*stmt.as<ForNode>());
+      n->body = InsertIntoSeqStmt(n->body, info_->loc_pos, info_->cache_stage);
+      stmt = For(n);
+    }
+    return stmt;
+  }
+
+  Stmt VisitStmt_(const BlockNode* block) final {
+    Block old_stmt = GetRef<Block>(block);
+    bool is_redirected = in_redirected_block_ || info_->redirected_blocks.count(block);
+    std::swap(in_redirected_block_, is_redirected);
+    Block stmt = Downcast<Block>(StmtExprMutator::VisitStmt_(block));
+    std::swap(in_redirected_block_, is_redirected);
+    ObjectPtr<BlockNode> n = make_object<BlockNode>(*stmt.get());
+    // Redirect the read/write regions and the match buffers
+    if (in_redirected_block_ || info_->redirected_blocks.count(block)) {
+      n->reads = ReplaceBuffer(n->reads, info_->redirect_src, info_->redirect_dst);
+      n->writes = ReplaceBuffer(n->writes, info_->redirect_src, info_->redirect_dst);
+      n->match_buffers.MutateByApply(
+          [this](const MatchBufferRegion& match_buffer) -> MatchBufferRegion {
+            const BufferRegion& source = match_buffer->source;
+            if (source->buffer.same_as(info_->redirect_src)) {
+              return MatchBufferRegion(match_buffer->buffer,
+                                       BufferRegion(info_->redirect_dst, source->region));
+            }
+            return match_buffer;
+          });
+    }
+    // Insert the cache stage if it is the right place
+    if (block == info_->loc_sref->stmt) {
+      n->body = InsertIntoSeqStmt(n->body, info_->loc_pos, info_->cache_stage);
+    }
+    // Allocate the cache buffer in the scope root
+    if (block == scope_sref_->stmt) {
+      n->alloc_buffers.push_back(info_->alloc);
+    }
+    stmt = Block(n);
+    info_->block_reuse.Set(old_stmt, stmt);
+    return std::move(stmt);
+  }
+
+  PrimExpr VisitExpr_(const BufferLoadNode* load) final {
+    PrimExpr expr = StmtExprMutator::VisitExpr_(load);
+    if (in_redirected_block_ && load->buffer.same_as(info_->redirect_src)) {
+      ObjectPtr<BufferLoadNode> n = make_object<BufferLoadNode>(*expr.as<BufferLoadNode>());
+      n->buffer = info_->redirect_dst;
+      return PrimExpr(n);
+    }
+    return expr;
+  }
+
+  Stmt VisitStmt_(const BufferStoreNode* store) final {
+    Stmt stmt = StmtExprMutator::VisitStmt_(store);
+    if (in_redirected_block_ && store->buffer.same_as(info_->redirect_src)) {
+      ObjectPtr<BufferStoreNode> n = make_object<BufferStoreNode>(*stmt.as<BufferStoreNode>());
+      n->buffer = info_->redirect_dst;
+      return Stmt(n);
+    }
+    return stmt;
+  }
+
+  /*! \brief The scope root block */
+  const StmtSRef& scope_sref_;
+  /*! \brief The cache stage information */
+  CacheStageInfo* info_;
+  /*! \brief Whether the visitor is inside a block whose accesses are redirected */
+  bool in_redirected_block_ = false;
+};
+
+/*!
+ * \brief Get the blocks in the scope that read the given buffer
+ * \param self The schedule state
+ * \param scope_sref The scope root block
+ * \param buffer The buffer to be read
+ * \param exclude_block The block to be excluded from the result, can be nullptr
+ * \return The blocks that read the buffer
+ */
+Array<StmtSRef> GetReaderBlocks(const ScheduleState& self, const StmtSRef& scope_sref,
+                                const Buffer& buffer, const StmtSRefNode* exclude_block) {
+  Array<StmtSRef> readers;
+  for (const StmtSRef& block_sref : GetChildBlocks(self, scope_sref)) {
+    const BlockNode* block = TVM_SREF_TO_BLOCK(block, block_sref);
+    if (block_sref.get() != exclude_block &&
+        GetBufferRegionFromBuffer(block->reads, buffer).defined()) {
+      readers.push_back(block_sref);
+    }
+  }
+  return readers;
+}
+
+/*!
+ * \brief Take the union of regions of the same buffer, dimension by dimension
+ * \param regions The regions, each of which has an integer set per dimension
+ * \param ndim The number of dimensions of the buffer
+ * \return The union of the regions
+ */
+Array<arith::IntSet> UnionRegions(const std::vector<Array<arith::IntSet>>& regions, int ndim) {
+  Array<arith::IntSet> result;
+  result.reserve(ndim);
+  for (int i = 0; i < ndim; ++i) {
+    Array<arith::IntSet> sets;
+    for (const Array<arith::IntSet>& region : regions) {
+      sets.push_back(region[i]);
+    }
+    result.push_back(arith::Union(sets));
+  }
+  return result;
+}
+
+/*!
+ * \brief Relax all the regions of a buffer accessed by a block, and take their union
+ * \param self The schedule state
+ * \param block_sref The block that accesses the buffer
+ * \param ancestor_sref The loop or block the regions are relaxed to, exclusive
+ * \param regions The read or write regions of the block
+ * \param buffer The buffer
+ * \return The union of the relaxed regions of the buffer
+ */
+Array<arith::IntSet> RelaxBufferRegions(const ScheduleState& self, const StmtSRef& block_sref,
+                                        const StmtSRef& ancestor_sref,
+                                        const Array<BufferRegion>& regions, const Buffer& buffer) {
+  std::vector<Array<arith::IntSet>> relaxed;
+  for (const BufferRegion& region : regions) {
+    if (region->buffer.same_as(buffer)) {
+      relaxed.push_back(RelaxBufferRegion(self, block_sref, ancestor_sref, region));
+    }
+  }
+  ICHECK(!relaxed.empty()) << "InternalError: The block does not access the buffer "
+                           << buffer->name;
+  return UnionRegions(relaxed, buffer->shape.size());
+}
+
+/*!
+ * \brief Find the lowest loop or block that contains all the given blocks, which is where the
+ * cache stage should be inserted
+ * \param block_srefs The blocks to be covered
+ * \return The lowest loop or block that strictly contains all the given blocks
+ */
+StmtSRef GetCacheStageLocation(const Array<StmtSRef>& block_srefs) {
+  Array<StmtSRef> parent_srefs;
+  parent_srefs.reserve(block_srefs.size());
+  for (const StmtSRef& block_sref : block_srefs) {
+    parent_srefs.push_back(GetRef<StmtSRef>(block_sref->parent));
+  }
+  return GetSRefLowestCommonAncestor(parent_srefs);
+}
+
+/******** Implementation ********/
+
+StmtSRef CacheRead(ScheduleState self, const StmtSRef& block_sref, int read_buffer_index,
+                   const String& storage_scope) {
+  /*!
+   * Check:
+   *   - The index is in the array of block reading region
+   *   - There is at most one block who write the buffer in the scope
+   *
+   * Mutate:
+   *   - Allocate new cache buffer under the current scope.
+   *   - If the buffer is written in the scope, find the lowest loop or block that contains the
+   *     writer and the readers, and copy the produced region right after the writer.
+   *   - Otherwise, copy the consumed region at the scope level before the first reader.
+   *   - Redirect the readers after the cache stage to the cache buffer.
+   */
+  // Step 1. Check index, getting the target buffer and the parent scope
+  runtime::StorageScope::Create(storage_scope);
+  const BlockNode* block = TVM_SREF_TO_BLOCK(block, block_sref);
+  Buffer read_buffer =
+      GetNthAccessBuffer(self, GetRef<Block>(block), read_buffer_index, /*is_write=*/false);
+  StmtSRef scope_sref = GetScopeRootAndCheckStagePipeline(self, block_sref);
+  BlockScope scope = self->GetBlockScope(scope_sref);
+  // Step 2. Create CacheStageInfo
+  CacheStageInfo info;
+  info.read_buffer = read_buffer;
+  // Create the corresponding buffer to be written, i.e. result of cache_read
+  info.write_buffer = WithScope(read_buffer, storage_scope);
+  // Create the corresponding buffer allocation
+  info.alloc = info.write_buffer;
+  info.redirect_src = info.read_buffer;
+  info.redirect_dst = info.write_buffer;
+  // Step 3. Update cache stage info.
+  arith::Analyzer analyzer;
+  BufferRegion cache_region{nullptr};
+  Array<StmtSRef> readers = GetReaderBlocks(self, scope_sref, read_buffer, nullptr);
+  auto it = scope->buffer_writers.find(read_buffer);
+  if (it != scope->buffer_writers.end()) {
+    // The buffer is written inside the scope, the cache stage is right after its writer
+    const Array<StmtSRef>& writers = it->second;
+    if (writers.size() > 1) {
+      throw NotSingleWriteBlock(self->mod, read_buffer, writers);
+    }
+    const StmtSRef& write_block_sref = writers[0];
+    const BlockNode* write_block = TVM_SREF_TO_BLOCK(write_block, write_block_sref);
+    Array<StmtSRef> related_blocks = readers;
+    related_blocks.push_back(write_block_sref);
+    info.loc_sref = GetCacheStageLocation(related_blocks);
+    info.loc_pos = GetSubtreeIndex(info.loc_sref, write_block_sref) + 1;
+    cache_region = IntSetsToBufferRegion(
+        read_buffer,
+        RelaxBufferRegions(self, write_block_sref, info.loc_sref, write_block->writes, read_buffer),
+        &analyzer);
+    // Only the readers after the writer read the cache
+    for (const StmtSRef& reader_sref : readers) {
+      if (reader_sref.same_as(write_block_sref)) {
+        continue;
+      }
+      if (GetSubtreeIndex(info.loc_sref, reader_sref) >= info.loc_pos) {
+        info.redirected_blocks.insert(reader_sref->StmtAs<BlockNode>());
+      }
+    }
+  } else {
+    // The buffer is an input of the scope, the cache stage is at the scope level, right before
+    // the first reader
+    info.loc_sref = scope_sref;
+    info.loc_pos = std::numeric_limits<int>::max();
+    std::vector<Array<arith::IntSet>> touched_regions;
+    for (const StmtSRef& reader_sref : readers) {
+      const BlockNode* reader = TVM_SREF_TO_BLOCK(reader, reader_sref);
+      info.loc_pos = std::min(info.loc_pos, GetSubtreeIndex(info.loc_sref, reader_sref));
+      info.redirected_blocks.insert(reader);
+      touched_regions.push_back(
+          RelaxBufferRegions(self, reader_sref, info.loc_sref, reader->reads, read_buffer));
+    }
+    cache_region = IntSetsToBufferRegion(
+        read_buffer, UnionRegions(touched_regions, read_buffer->shape.size()), &analyzer);
+  }
+  // Step 4. Making new cache stage block and rewrite readers.
+  Block cache_read_stage = MakeCacheStage(/*cache_region=*/cache_region, /*info=*/&info,
+                                          /*storage_scope=*/storage_scope);
+  Block new_scope = CacheStageInserter::Rewrite(scope_sref, &info);
+  // Step 5. Replacing and updating flags.
+  self->Replace(scope_sref, new_scope, info.block_reuse);
+  self->UpdateScopeBlockInfo(GetBlockRealize(self, scope_sref));
+  return self->stmt2ref.at(cache_read_stage.get());
+}
+
+StmtSRef CacheWrite(ScheduleState self, const StmtSRef& block_sref, int write_buffer_index,
+                    const String& storage_scope) {
+  /*!
+   * Check:
+   *   - The index is in the array of block writing region
+   *   - There is only one block who write the buffer in the scope
+   *
+   * Mutate:
+   *   - Allocate new cache buffer under the current scope.
+   *   - Find the lowest loop or block that contains the writer and the readers of the buffer.
+   *   - Copy the produced region back to the buffer, right after the writer.
+   *   - Redirect the writer, and the readers before the cache stage, to the cache buffer.
+   */
+  // Step 1. Checking index, getting the target buffer and the parent scope
+  runtime::StorageScope::Create(storage_scope);
+  const BlockNode* block = TVM_SREF_TO_BLOCK(block, block_sref);
+  Buffer write_buffer =
+      GetNthAccessBuffer(self, GetRef<Block>(block), write_buffer_index, /*is_write=*/true);
+  StmtSRef scope_sref = GetScopeRootAndCheckStagePipeline(self, block_sref);
+  BlockScope scope = self->GetBlockScope(scope_sref);
+  // Step 2. Check there is only one block who writes the buffer
+  const Array<StmtSRef>& writers = scope->buffer_writers.at(write_buffer);
+  if (writers.size() > 1) {
+    throw NotSingleWriteBlock(self->mod, write_buffer, writers);
+  }
+  // Step 3. Create CacheStageInfo
+  CacheStageInfo info;
+  info.read_buffer = WithScope(write_buffer, storage_scope);
+  // Create the corresponding buffer to be written, i.e. result of cache_write
+  info.write_buffer = write_buffer;
+  // Create the corresponding buffer allocation
+  info.alloc = info.read_buffer;
+  info.redirect_src = info.write_buffer;
+  info.redirect_dst = info.read_buffer;
+  // Step 4. Update cache stage info.
+  Array<StmtSRef> readers = GetReaderBlocks(self, scope_sref, write_buffer, block_sref.get());
+  if (readers.empty()) {
+    // The buffer is an output of the scope, write it back at the scope level
+    info.loc_sref = scope_sref;
+  } else {
+    Array<StmtSRef> related_blocks = readers;
+    related_blocks.push_back(block_sref);
+    info.loc_sref = GetCacheStageLocation(related_blocks);
+  }
+  int writer_pos = GetSubtreeIndex(info.loc_sref, block_sref);
+  info.loc_pos = writer_pos + 1;
+  info.redirected_blocks.insert(block);
+  // The readers in the same subtree as the writer read the cache before it is written back
+  for (const StmtSRef& reader_sref : readers) {
+    if (GetSubtreeIndex(info.loc_sref, reader_sref) == writer_pos) {
+      info.redirected_blocks.insert(reader_sref->StmtAs<BlockNode>());
+    }
+  }
+  arith::Analyzer analyzer;
+  BufferRegion cache_region = IntSetsToBufferRegion(
+      write_buffer,
+      RelaxBufferRegions(self, block_sref, info.loc_sref, block->writes, write_buffer),
+      &analyzer);
+  // Step 5. Making new cache stage block and rewrite the writer.
+  Block cache_write_stage = MakeCacheStage(/*cache_region=*/cache_region, /*info=*/&info,
+                                           /*storage_scope=*/storage_scope);
+  Block new_scope = CacheStageInserter::Rewrite(scope_sref, &info);
+  // Step 6. Replacing and updating flags.
+  self->Replace(scope_sref, new_scope, info.block_reuse);
+  self->UpdateScopeBlockInfo(GetBlockRealize(self, scope_sref));
+  return self->stmt2ref.at(cache_write_stage.get());
+}
+
+}  // namespace tir
+}  // namespace tvm
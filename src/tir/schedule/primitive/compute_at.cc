@@ -0,0 +1,660 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <limits>
+#include <unordered_set>
+
+#include "../utils.h"
+
+namespace tvm {
+namespace tir {
+
+/******** Error Classes ********/
+
+class NotInSameScopeError : public ScheduleError {
+ public:
+  static void CheckAndBindLoopDomain(const ScheduleState& self, const StmtSRef& block_sref,
+                                     const StmtSRef& loop_sref, const StmtSRef& scope_root_sref,
+                                     arith::Analyzer* analyzer) {
+    for (const StmtSRefNode* p = loop_sref.get();; p = p->parent) {
+      if (const ForNode* loop = p->StmtAs<ForNode>()) {
+        analyzer->Bind(loop->loop_var, Range::FromMinExtent(loop->min, loop->extent));
+      } else if (p != scope_root_sref.get()) {
+        throw NotInSameScopeError(self->mod, block_sref, loop_sref);
+      } else {
+        break;
+      }
+    }
+    for (const StmtSRefNode* p = block_sref->parent; p != scope_root_sref.get(); p = p->parent) {
+      if (p == loop_sref.get()) {
+        throw NotInSameScopeError(self->mod, block_sref, loop_sref);
+      }
+    }
+  }
+
+  String FastErrorString() const final {
+    return "ScheduleError: Expected the block and loop to be under the same block scope, and loop "
+           "not to be the ancestor of block";
+  }
+  String DetailRenderTemplate() const final {
+    return "ScheduleError: Expected the block {0} and loop {1} to be under the same block scope, "
+           "and loop not to be the ancestor of block";
+  }
+  IRModule mod() const final { return mod_; }
+  Array<ObjectRef> LocationsOfInterest() const final { return {block_, loop_}; }
+
+ private:
+  explicit NotInSameScopeError(IRModule mod, const StmtSRef& block_sref, const StmtSRef& loop_sref)
+      : mod_(mod),
+        block_(GetRef<Block>(block_sref->StmtAs<BlockNode>())),
+        loop_(GetRef<For>(loop_sref->StmtAs<ForNode>())) {}
+
+  IRModule mod_;
+  Block block_;
+  For loop_;
+};
+
+class NotCompleteOrReductionBlockError : public ScheduleError {
+ public:
+  explicit NotCompleteOrReductionBlockError(IRModule mod, Block block)
+      : mod_(mod), block_(std::move(block)) {}
+
+  String FastErrorString() const final {
+    return "ScheduleError: The block is neither a complete block nor a reduction block";
+  }
+  String DetailRenderTemplate() const final {
+    return R"(The block {0} is neither a complete block nor a reduction block.
+Definition of a complete block:
+1) All block vars are data parallel
+2) Dominant: the block is the only writer of its output, dominating the reader of its output buffers
+3) No overlap between the buffers the block reads and writes
+Definition of a reduction block:
+1) All block vars are data parallel or reduction
+2) Dominant: the block is the only writer of its output, dominating the reader of its output buffers
+3) The block has an init statement)";
+  }
+  IRModule mod() const final { return mod_; }
+  Array<ObjectRef> LocationsOfInterest() const final { return {block_}; }
+
+  IRModule mod_;
+  Block block_;
+};
+
+class NotAllRequiredBlocksAreVisitedError : public ScheduleError {
+ public:
+  explicit NotAllRequiredBlocksAreVisitedError(IRModule mod, int num_not_visited,
+                                               const Array<StmtSRef>& required,
+                                               bool is_compute_at)
+      : mod_(mod), num_not_visited_(num_not_visited), is_compute_at_(is_compute_at) {
+    required_.reserve(required.size());
+    for (const StmtSRef& block_sref : required) {
+      const BlockNode* block = TVM_SREF_TO_BLOCK(block, block_sref);
+      required_.push_back(GetRef<Block>(block));
+    }
+  }
+
+  String FastErrorString() const final {
+    return "ScheduleError: Not all required blocks are under the loop scope";
+  }
+
+  String DetailRenderTemplate() const final {
+    String relation = is_compute_at_ ? "consumer(s)" : "producer(s)";
+    std::ostringstream os;
+    os << "The primitive requires all the " << relation
+       << " of the given block to be present under the target loop. However, there are "
+       << num_not_visited_ << " " << relation << " not satisfying the constraint. List of the "
+       << relation << ":";
+    for (int i = 0, n = required_.size(); i < n; ++i) {
+      os << "{" << i << "}";
+    }
+    return os.str();
+  }
+
+  IRModule mod() const final { return mod_; }
+
+  Array<ObjectRef> LocationsOfInterest() const final {
+    return {required_.begin(), required_.end()};
+  }
+
+ private:
+  IRModule mod_;
+  int num_not_visited_;
+  Array<Block> required_;
+  bool is_compute_at_;
+};
+
+class PredicateNotRewritableError : public ScheduleError {
+ public:
+  explicit PredicateNotRewritableError(IRModule mod, Block block, PrimExpr predicate)
+      : mod_(mod), block_(std::move(block)), predicate_(std::move(predicate)) {}
+
+  String FastErrorString() const final {
+    return "ScheduleError: The predicate of the block cannot be expressed under the target loop";
+  }
+
+  String DetailRenderTemplate() const final {
+    std::ostringstream os;
+    os << "The predicate " << predicate_
+       << " of the block {0} refers to loops that are removed, in a form other than the bindings "
+          "of the block vars, so it cannot be expressed under the target loop";
+    return os.str();
+  }
+
+  IRModule mod() const final { return mod_; }
+  Array<ObjectRef> LocationsOfInterest() const final { return {block_}; }
+
+  IRModule mod_;
+  Block block_;
+  PrimExpr predicate_;
+};
+
+class ProducerConsumerSplitError : public ScheduleError {
+ public:
+  explicit ProducerConsumerSplitError(IRModule mod, Block block, For loop)
+      : mod_(mod), block_(std::move(block)), loop_(std::move(loop)) {}
+
+  String FastErrorString() const final {
+    return "ScheduleError: There is no position in the body of the loop that is after all the "
+           "producers and before all the consumers of the block";
+  }
+
+  String DetailRenderTemplate() const final {
+    return "There is no position in the body of loop {1} that is after all the producers and "
+           "before all the consumers of block {0}";
+  }
+
+  IRModule mod() const final { return mod_; }
+  Array<ObjectRef> LocationsOfInterest() const final { return {block_, loop_}; }
+
+ private:
+  IRModule mod_;
+  Block block_;
+  For loop_;
+};
+
+class NotSupportedRegionError : public ScheduleError {
+ public:
+  explicit NotSupportedRegionError(IRModule mod, Block block, Buffer buffer)
+      : mod_(mod), block_(std::move(block)), buffer_(std::move(buffer)) {}
+
+  String FastErrorString() const final {
+    return "ScheduleError: Cannot derive the iteration domain of the block from the region of a "
+           "buffer it reads";
+  }
+
+  String DetailRenderTemplate() const final {
+    return "Cannot derive the iteration domain of block {0} from the region of buffer " +
+           buffer_->name +
+           " it reads. Each dimension of the region is required to be either a single block var "
+           "or independent of the block vars";
+  }
+
+  IRModule mod() const final { return mod_; }
+  Array<ObjectRef> LocationsOfInterest() const final { return {block_}; }
+
+ private:
+  IRModule mod_;
+  Block block_;
+  Buffer buffer_;
+};
+
+class RegionNotProducedError : public ScheduleError {
+ public:
+  explicit RegionNotProducedError(IRModule mod, Block block, Buffer buffer, int dim)
+      : mod_(mod), block_(std::move(block)), buffer_(std::move(buffer)), dim_(dim) {}
+
+  String FastErrorString() const final {
+    return "ScheduleError: The block reads a region that is not produced yet under the loop";
+  }
+
+  String DetailRenderTemplate() const final {
+    std::ostringstream os;
+    os << "Block {0} reads a region of buffer " << buffer_->name
+       << " that does not depend on its block vars in dimension " << dim_
+       << ". The region is not provably covered by what the producers provide during one "
+          "iteration of the loop, so the block cannot be moved under it";
+    return os.str();
+  }
+
+  IRModule mod() const final { return mod_; }
+  Array<ObjectRef> LocationsOfInterest() const final { return {block_}; }
+
+ private:
+  IRModule mod_;
+  Block block_;
+  Buffer buffer_;
+  int dim_;
+};
+
+/******** Helper Functions/Classes ********/
+
+/*!
+ * \brief Check if a block is a complete block or a reduction block
+ * \param self The schedule state
+ * \param block_sref The block to be checked
+ * \param scope_root_sref The scope root of the block
+ * \throw ScheduleError If the block is neither a complete block nor a reduction block
+ */
+void CheckCompleteOrReductionBlock(const ScheduleState& self, const StmtSRef& block_sref,
+                                   const StmtSRef& scope_root_sref) {
+  if (IsCompleteBlock(self, block_sref, scope_root_sref)) {
+    return;
+  }
+  const BlockNode* block = TVM_SREF_TO_BLOCK(block, block_sref);
+  bool is_reduction = block->init.defined();
+  for (const IterVar& iter_var : block->iter_vars) {
+    if (iter_var->iter_type != kDataPar && iter_var->iter_type != kCommReduce) {
+      is_reduction = false;
+    }
+  }
+  BlockScope scope = self->GetBlockScope(scope_root_sref);
+  for (const BufferRegion& write_region : block->writes) {
+    if (scope->buffer_writers.at(write_region->buffer).size() != 1) {
+      is_reduction = false;
+    }
+  }
+  if (!is_reduction) {
+    throw NotCompleteOrReductionBlockError(self->mod, GetRef<Block>(block));
+  }
+}
+
+/*!
+ * \brief Check if a sref is strictly under the given loop
+ * \param loop_sref The loop
+ * \param sref The sref to be checked
+ * \return A boolean indicating if `sref` is under `loop_sref`
+ */
+bool IsUnderLoop(const StmtSRef& loop_sref, const StmtSRef& sref) {
+  for (const StmtSRefNode* p = sref->parent; p != nullptr; p = p->parent) {
+    if (p == loop_sref.get()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*!
+ * \brief Find the position in the body of the loop to insert the block, which is after all the
+ * producers and before all the consumers under the loop
+ * \tparam is_compute_at Indicates if the primitive is compute_at or reverse_compute_at
+ * \param self The schedule state
+ * \param block_sref The block to be moved
+ * \param loop_sref The loop where the block is moved to
+ * \param producer_srefs The producers of the block
+ * \param consumer_srefs The consumers of the block
+ * \return The position in the loop body
+ * \throw ScheduleError If there is no such position
+ */
+template <bool is_compute_at>
+int FindInsertionPos(const ScheduleState& self, const StmtSRef& block_sref,
+                     const StmtSRef& loop_sref, const Array<StmtSRef>& producer_srefs,
+                     const Array<StmtSRef>& consumer_srefs) {
+  // The last subtree containing a producer, and the first subtree containing a consumer
+  int last_producer_pos = -1;
+  int first_consumer_pos = std::numeric_limits<int>::max();
+  for (const StmtSRef& producer_sref : producer_srefs) {
+    if (IsUnderLoop(loop_sref, producer_sref)) {
+      last_producer_pos = std::max(last_producer_pos, GetSubtreeIndex(loop_sref, producer_sref));
+    }
+  }
+  for (const StmtSRef& consumer_sref : consumer_srefs) {
+    if (IsUnderLoop(loop_sref, consumer_sref)) {
+      first_consumer_pos =
+          std::min(first_consumer_pos, GetSubtreeIndex(loop_sref, consumer_sref));
+    }
+  }
+  if (last_producer_pos >= first_consumer_pos) {
+    const BlockNode* block = TVM_SREF_TO_BLOCK(block, block_sref);
+    const ForNode* loop = TVM_SREF_TO_FOR(loop, loop_sref);
+    throw ProducerConsumerSplitError(self->mod, GetRef<Block>(block), GetRef<For>(loop));
+  }
+  // compute_at puts the block as late as possible, right before the first consumer, while
+  // reverse_compute_at puts the block as early as possible, right after the last producer
+  return is_compute_at ? first_consumer_pos : last_producer_pos + 1;
+}
+
+/*!
+ * \brief Calculate the region that the block has to provide (compute_at) or is allowed to consume
+ * (reverse_compute_at) during a single iteration of the loop, and derive the iteration domain of
+ * each block var from it
+ * \tparam is_compute_at Indicates if the primitive is compute_at or reverse_compute_at
+ * \param self The schedule state
+ * \param block_sref The block to be moved
+ * \param loop_sref The loop where the block is moved to
+ * \param related_srefs The consumers (compute_at) or producers (reverse_compute_at) of the block,
+ * all of which are under the loop
+ * \param analyzer The analyzer with the domain of the loop and its ancestors bound
+ * \return The iteration domain of each block var
+ */
+template <bool is_compute_at>
+std::vector<Range> CalculateBlockVarDomain(const ScheduleState& self, const StmtSRef& block_sref,
+                                           const StmtSRef& loop_sref,
+                                           const Array<StmtSRef>& related_srefs,
+                                           arith::Analyzer* analyzer) {
+  const BlockNode* block = TVM_SREF_TO_BLOCK(block, block_sref);
+  // The buffers the block provides to (compute_at) or consumes from (reverse_compute_at) the
+  // related blocks
+  const Array<BufferRegion>& own_regions = is_compute_at ? block->writes : block->reads;
+  std::unordered_map<const BufferNode*, std::vector<Array<arith::IntSet>>> touched_regions;
+  for (const BufferRegion& region : own_regions) {
+    touched_regions[region->buffer.get()] = {};
+  }
+  // Step 1. Collect the regions the related blocks touch during a single iteration of the loop
+  for (const StmtSRef& related_sref : related_srefs) {
+    const BlockNode* related = TVM_SREF_TO_BLOCK(related, related_sref);
+    const Array<BufferRegion>& regions = is_compute_at ? related->reads : related->writes;
+    for (const BufferRegion& region : regions) {
+      auto it = touched_regions.find(region->buffer.get());
+      if (it != touched_regions.end()) {
+        it->second.push_back(RelaxBufferRegion(self, related_sref, loop_sref, region));
+      }
+    }
+  }
+  // Step 2. Match the touched regions with the region accessed by the block itself
+  std::unordered_map<const VarNode*, std::vector<arith::IntSet>> var_sets;
+  for (const BufferRegion& own_region : own_regions) {
+    const std::vector<Array<arith::IntSet>>& touched = touched_regions.at(own_region->buffer.get());
+    if (touched.empty()) {
+      continue;
+    }
+    int ndim = own_region->region.size();
+    for (int i = 0; i < ndim; ++i) {
+      const Range& range = own_region->region[i];
+      const VarNode* var = range->min.as<VarNode>();
+      bool is_block_var = false;
+      if (var != nullptr && is_one(range->extent)) {
+        for (const IterVar& iter_var : block->iter_vars) {
+          is_block_var = is_block_var || iter_var->var.get() == var;
+        }
+      }
+      if (!is_block_var) {
+        // Producing more than required is safe, while consuming more than produced is not
+        bool use_block_var = false;
+        for (const IterVar& iter_var : block->iter_vars) {
+          use_block_var = use_block_var || ExprUseVar(range->min, iter_var->var);
+        }
+        if (!is_compute_at && use_block_var) {
+          throw NotSupportedRegionError(self->mod, GetRef<Block>(block), own_region->buffer);
+        }
+        if (!is_compute_at) {
+          // The block reads the same region in every iteration of its own loops, which has to
+          // be provided by the producers in every iteration of the target loop
+          Array<arith::IntSet> dim_sets;
+          for (const Array<arith::IntSet>& region : touched) {
+            dim_sets.push_back(region[i]);
+          }
+          arith::IntSet produced = arith::Union(dim_sets);
+          if (!produced.HasLowerBound() || !produced.HasUpperBound() ||
+              !analyzer->CanProve(produced.min() <= range->min) ||
+              !analyzer->CanProve(range->min + range->extent <= produced.max() + 1)) {
+            throw RegionNotProducedError(self->mod, GetRef<Block>(block), own_region->buffer, i);
+          }
+        }
+        continue;
+      }
+      Array<arith::IntSet> dim_sets;
+      for (const Array<arith::IntSet>& region : touched) {
+        dim_sets.push_back(region[i]);
+      }
+      var_sets[var].push_back(arith::Union(dim_sets));
+    }
+  }
+  // Step 3. Derive the domain of each block var, which never goes beyond its original domain
+  std::vector<Range> result;
+  result.reserve(block->iter_vars.size());
+  for (const IterVar& iter_var : block->iter_vars) {
+    arith::IntSet dom = arith::IntSet::FromRange(iter_var->dom);
+    auto it = var_sets.find(iter_var->var.get());
+    if (it != var_sets.end()) {
+      Array<arith::IntSet> sets{it->second.begin(), it->second.end()};
+      // compute_at has to provide all the required regions, while reverse_compute_at can only
+      // consume the region provided by all the producers
+      arith::IntSet required = is_compute_at ? arith::Union(sets) : arith::Intersect(sets);
+      if (required.HasLowerBound() && required.HasUpperBound()) {
+        dom = arith::Intersect({required, dom});
+      }
+    }
+    PrimExpr min = analyzer->Simplify(dom.min());
+    PrimExpr extent = analyzer->Simplify(dom.max() - dom.min() + 1);
+    result.push_back(Range::FromMinExtent(min, extent));
+  }
+  return result;
+}
+
+/*!
+ * \brief Rewrite the predicate of a block onto its new loop nest. The predicate refers to the
+ * original loops of the block, so every binding of a block var in it is replaced by the new
+ * binding. The loops that enclose the target loop are kept, and may still be referred to.
+ */
+class BlockPredicateRewriter : private ExprMutator {
+ public:
+  /*!
+   * \brief Rewrite the predicate of a block
+   * \param predicate The original predicate
+   * \param old_bindings The original bindings of the block vars
+   * \param new_bindings The bindings of the block vars in the new loop nest
+   * \param removed_loop_vars The original loops of the block that do not enclose the target loop
+   * \return The rewritten predicate, or NullOpt if it still refers to a removed loop
+   */
+  static Optional<PrimExpr> Rewrite(const PrimExpr& predicate, const Array<PrimExpr>& old_bindings,
+                                    const Array<PrimExpr>& new_bindings,
+                                    const std::unordered_set<const VarNode*>& removed_loop_vars) {
+    BlockPredicateRewriter rewriter(old_bindings, new_bindings);
+    PrimExpr result = rewriter(predicate);
+    if (ExprUseVar(result, [&](const VarNode* var) { return removed_loop_vars.count(var) > 0; })) {
+      return NullOpt;
+    }
+    return result;
+  }
+
+ private:
+  explicit BlockPredicateRewriter(const Array<PrimExpr>& old_bindings,
+                                  const Array<PrimExpr>& new_bindings)
+      : old_bindings_(old_bindings), new_bindings_(new_bindings) {}
+
+  PrimExpr VisitExpr(const PrimExpr& expr) final {
+    for (size_t i = 0; i < old_bindings_.size(); ++i) {
+      // Constant bindings carry no loop var, and would match unrelated constants.
+      if (!old_bindings_[i]->IsInstance<IntImmNode>() &&
+          ExprDeepEqual()(expr, old_bindings_[i])) {
+        return new_bindings_[i];
+      }
+    }
+    return ExprMutator::VisitExpr(expr);
+  }
+
+  const Array<PrimExpr>& old_bindings_;
+  const Array<PrimExpr>& new_bindings_;
+};
+
+/*!
+ * \brief Generate the loop nest for the block to be moved, according to the domain of block vars
+ * \param self The schedule state
+ * \param block_sref The sref to the block to be moved
+ * \param loop_sref The sref to the target loop
+ * \param var_doms The iteration domain of each block var
+ * \param preserve_unit_loops Whether to keep the trivial loops whose extents are 1
+ * \return The generated loop nest
+ */
+Stmt MakeLoopNest(const ScheduleState& self, const StmtSRef& block_sref,
+                  const StmtSRef& loop_sref, const std::vector<Range>& var_doms,
+                  bool preserve_unit_loops) {
+  const BlockNode* block = TVM_SREF_TO_BLOCK(block, block_sref);
+  std::vector<Var> loop_vars;
+  std::vector<PrimExpr> loop_extents;
+  Array<PrimExpr> iter_values;
+  iter_values.reserve(var_doms.size());
+  for (const Range& dom : var_doms) {
+    if (!preserve_unit_loops && is_one(dom->extent)) {
+      iter_values.push_back(dom->min);
+      continue;
+    }
+    Var loop_var("ax" + std::to_string(loop_vars.size()));
+    iter_values.push_back(is_zero(dom->min) ? PrimExpr(loop_var) : dom->min + loop_var);
+    loop_vars.push_back(loop_var);
+    loop_extents.push_back(dom->extent);
+  }
+  // Carry the predicate of the block over to the new loop vars
+  BlockRealize realize = GetBlockRealize(self, block_sref);
+  PrimExpr predicate = realize->predicate;
+  if (!is_one(predicate)) {
+    std::unordered_set<const VarNode*> removed_loop_vars;
+    for (const StmtSRefNode* p = block_sref->parent; p != nullptr; p = p->parent) {
+      if (const auto* loop = p->StmtAs<ForNode>()) {
+        removed_loop_vars.insert(loop->loop_var.get());
+      }
+    }
+    for (const StmtSRefNode* p = loop_sref.get(); p != nullptr; p = p->parent) {
+      if (const auto* loop = p->StmtAs<ForNode>()) {
+        removed_loop_vars.erase(loop->loop_var.get());
+      }
+    }
+    Optional<PrimExpr> new_predicate = BlockPredicateRewriter::Rewrite(
+        predicate, realize->iter_values, iter_values, removed_loop_vars);
+    if (!new_predicate.defined()) {
+      throw PredicateNotRewritableError(self->mod, GetRef<Block>(block), predicate);
+    }
+    predicate = new_predicate.value();
+  }
+  Stmt body = BlockRealize(/*iter_values=*/iter_values, /*predicate=*/predicate,
+                           /*block=*/GetRef<Block>(block));
+  for (int i = static_cast<int>(loop_vars.size()) - 1; i >= 0; --i) {
+    body = For(/*loop_var=*/loop_vars[i],
+               /*min=*/0,
+               /*extent=*/loop_extents[i],
+               /*kind=*/ForKind::kSerial,
+               /*body=*/body);
+  }
+  return body;
+}
+
+/*!
+ * \brief Reconstruct the scope root block, removing the block from its original place and
+ * inserting the new loop nest into the target loop
+ */
+class ScopeReconstructor : private StmtMutator {
+ public:
+  static Block Reconstruct(const Block& scope_root, const Stmt& rm_src_stmt,
+                           const Stmt& rm_tgt_stmt, const ForNode* loop, int insert_pos,
+                           const Stmt& new_subtree) {
+    ScopeReconstructor reconstructor(rm_src_stmt, rm_tgt_stmt, loop, insert_pos, new_subtree);
+    return Downcast<Block>(reconstructor.VisitStmt(scope_root));
+  }
+
+ private:
+  explicit ScopeReconstructor(const Stmt& rm_src_stmt, const Stmt& rm_tgt_stmt,
+                              const ForNode* loop, int insert_pos, const Stmt& new_subtree)
+      : rm_src_stmt_(rm_src_stmt),
+        rm_tgt_stmt_(rm_tgt_stmt),
+        loop_(loop),
+        insert_pos_(insert_pos),
+        new_subtree_(new_subtree) {}
+
+  Stmt VisitStmt(const Stmt& stmt) final {
+    if (stmt.same_as(rm_src_stmt_)) {
+      return StmtMutator::VisitStmt(rm_tgt_stmt_);
+    }
+    return StmtMutator::VisitStmt(stmt);
+  }
+
+  Stmt VisitStmt_(const ForNode* loop) final {
+    Stmt stmt = StmtMutator::VisitStmt_(loop);
+    if (loop == loop_) {
+      ObjectPtr<ForNode> n = make_object<ForNode>(*stmt.as<ForNode>());
+      n->body = InsertIntoSeqStmt(n->body, insert_pos_, new_subtree_);
+      return For(n);
+    }
+    return stmt;
+  }
+
+  /*! \brief The statement where the block is removed from */
+  const Stmt& rm_src_stmt_;
+  /*! \brief The statement after the block is removed */
+  const Stmt& rm_tgt_stmt_;
+  /*! \brief The loop where the block is moved to */
+  const ForNode* loop_;
+  /*! \brief The position in the loop body to insert the block */
+  int insert_pos_;
+  /*! \brief The new loop nest of the block */
+  const Stmt& new_subtree_;
+};
+
+template <bool is_compute_at>
+void ComputeAtOrReverseComputeAtImpl(ScheduleState self, const StmtSRef& block_sref,
+                                     const StmtSRef& loop_sref, bool preserve_unit_loops) {
+  const BlockNode* block = TVM_SREF_TO_BLOCK(block, block_sref);
+  const ForNode* loop = TVM_SREF_TO_FOR(loop, loop_sref);
+  arith::Analyzer analyzer;
+  // Step 1. Bunch of checks
+  // Check 1) `block` and `loop` are under the same scope, and `loop` is not the ancestor of `block`
+  // Check 2) The scope block has stage-pipeline property
+  StmtSRef scope_root_sref = GetScopeRootAndCheckStagePipeline(self, block_sref);
+  NotInSameScopeError::CheckAndBindLoopDomain(self, block_sref, loop_sref, scope_root_sref,
+                                              &analyzer);
+  // Check 3) The block is a complete block, or a reduction block for compute_at
+  if (is_compute_at) {
+    CheckCompleteOrReductionBlock(self, block_sref, scope_root_sref);
+  } else {
+    CheckCompleteBlock(self, block_sref, scope_root_sref);
+  }
+  // Check 4) All the required blocks are under the loop, and there is a valid position to insert
+  Array<StmtSRef> producer_srefs = GetProducers(self, block_sref);
+  Array<StmtSRef> consumer_srefs = GetConsumers(self, block_sref);
+  const Array<StmtSRef>& related_srefs = is_compute_at ? consumer_srefs : producer_srefs;
+  int num_not_visited = 0;
+  for (const StmtSRef& related_sref : related_srefs) {
+    if (!IsUnderLoop(loop_sref, related_sref)) {
+      ++num_not_visited;
+    }
+  }
+  if (related_srefs.empty() || num_not_visited > 0) {
+    throw NotAllRequiredBlocksAreVisitedError(self->mod, num_not_visited, related_srefs,
+                                              is_compute_at);
+  }
+  int insert_pos = FindInsertionPos<is_compute_at>(self, block_sref, loop_sref, producer_srefs,
+                                                   consumer_srefs);
+  // Step 2. Calculate the domain of block vars under a single iteration of the loop
+  std::vector<Range> var_doms = CalculateBlockVarDomain<is_compute_at>(
+      self, block_sref, loop_sref, related_srefs, &analyzer);
+  // Step 3. Generate the new loop nest of the block
+  Stmt new_subtree = MakeLoopNest(self, block_sref, loop_sref, var_doms, preserve_unit_loops);
+  // Step 4. Remove the block from its original place and insert the loop nest into the loop
+  Stmt rm_src_stmt{nullptr};
+  Stmt rm_tgt_stmt{nullptr};
+  ICHECK(LeafBlockRemovalPlan(block_sref, &rm_src_stmt, &rm_tgt_stmt))
+      << "InternalError: The block cannot be removed from its original place";
+  const BlockNode* scope_root = TVM_SREF_TO_BLOCK(scope_root, scope_root_sref);
+  Block new_scope_root = ScopeReconstructor::Reconstruct(
+      GetRef<Block>(scope_root), rm_src_stmt, rm_tgt_stmt, loop, insert_pos, new_subtree);
+  // Step 5. Replace the scope root and update the cached flags
+  self->Replace(scope_root_sref, new_scope_root, {{GetRef<Block>(scope_root), new_scope_root}});
+  self->UpdateScopeBlockInfo(GetBlockRealize(self, scope_root_sref));
+}
+
+void ComputeAt(ScheduleState self, const StmtSRef& block_sref, const StmtSRef& loop_sref,
+               bool preserve_unit_loops) {
+  ComputeAtOrReverseComputeAtImpl<true>(self, block_sref, loop_sref, preserve_unit_loops);
+}
+
+void ReverseComputeAt(ScheduleState self, const StmtSRef& block_sref, const StmtSRef& loop_sref,
+                      bool preserve_unit_loops) {
+  ComputeAtOrReverseComputeAtImpl<false>(self, block_sref, loop_sref, preserve_unit_loops);
+}
+
+}  // namespace tir
+}  // namespace tvm
@@ -188,76 +188,6 @@ class OpaqueAccessError : public ScheduleError {
   Block scope_root_;
 };
 
-/*!
- * \brief Construct a new AST, with a specific sref tree leaf removed.
- * The leaf's ancestors who have only a single child will be removed too.
- * \param leaf_block_sref The block/loop sref to the sref tree leaf to be removed
- * \param src_stmt The root of the subtree where the replacement begins
- * \param tgt_stmt The root of the subtree after the replacement
- * \return A boolean indicating if the leaf can be removed successfully
- * \note Removal is not conducted beyond scope-level.
- *
- * An example of the removal plan, say we are removing the leaf block "B" from the AST.
- *
- *  \code
- *    with block([], "scope_root"):
- *        ...
- *        with block([128, 128], "B") as [vi, vj]:
- *            B[vi, vj] = A[vi, vj] + 1.0
- *        with block([128, 128], "C") as [vi, vj]:
- *            C[vi, vj] = B[vi, vj] * 2.0
- *  \endcode
- *
- * Ths method does not mutate the AST, instead it returns the a `(src_stmt, tgt_stmt)` pair as a
- * plan to substitute certain pieces of the IR.
- *
- * In our example, it returns block "scope_root" as `src_stmt`, and the result `tgt_stmt` is:
- *
- *  \code
- *    with block([], "scope_root"):
- *        ...
- *        with block([128, 128], "C") as [vi, vj]:
- *            C[vi, vj] = B[vi, vj] * 2.0
- *  \endcode
- */
-bool LeafBlockRemovalPlan(const StmtSRef& leaf_block_sref, Stmt* src_stmt, Stmt* tgt_stmt) {
-  // Go upwards until find an ancestor with more than one child
-  const StmtNode* last_stmt = leaf_block_sref->stmt;
-  StmtSRefNode* sref = leaf_block_sref->parent;
-  for (;; last_stmt = sref->stmt, sref = sref->parent) {
-    if (const auto* loop = sref->StmtAs<ForNode>()) {
-      if (const auto* seq = loop->body.as<SeqStmtNode>()) {
-        if (seq->size() > 1) {
-          break;
-        }
-      }
-    } else {
-      // Removal is not done beyond scope-level.
-      // When encountering a block, i.e. the scope root, we simply stop
-      break;
-    }
-  }
-  if (const auto* block = sref->StmtAs<BlockNode>()) {
-    if (const auto* seq = block->body.as<SeqStmtNode>()) {
-      ObjectPtr<BlockNode> n = make_object<BlockNode>(*block);
-      n->body = RemoveFromSeqStmt(GetRef<SeqStmt>(seq), GetRef<Stmt>(last_stmt));
-      *src_stmt = GetRef<Stmt>(block);
-      *tgt_stmt = Stmt(std::move(n));
-      return true;
-    }
-  }
-  if (const auto* loop = sref->StmtAs<ForNode>()) {
-    if (const auto* seq = loop->body.as<SeqStmtNode>()) {
-      ObjectPtr<ForNode> n = make_object<ForNode>(*loop);
-      n->body = RemoveFromSeqStmt(GetRef<SeqStmt>(seq), GetRef<Stmt>(last_stmt));
-      *src_stmt = GetRef<Stmt>(loop);
-      *tgt_stmt = Stmt(std::move(n));
-      return true;
-    }
-  }
-  return false;
-}
-
 /*!
  * \brief The base class of the inliner, which handles:
  * 1) Substitute a subtree with the specific block being inlined
@@ -0,0 +1,153 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "../utils.h"
+
+namespace tvm {
+namespace tir {
+
+class WrongBlockIterTypeError : public ScheduleError {
+ public:
+  explicit WrongBlockIterTypeError(IRModule mod, ForKind for_kind, Var loop_var, Block block)
+      : mod_(std::move(mod)), loop_var_(std::move(loop_var)), block_(std::move(block)) {
+    op_str_ = for_kind == ForKind::kParallel ? "parallel" : "vectorize";
+  }
+
+  String FastErrorString() const final {
+    std::ostringstream os;
+    os << "ScheduleError: The \"" << op_str_
+       << "\" cannot be fulfilled with regard to some of its underlying block";
+    return os.str();
+  }
+
+  String DetailRenderTemplate() const final {
+    std::ostringstream os;
+    os << "The \"" << op_str_
+       << "\" cannot be fulfilled with regard to block {0} because some block iter whose block "
+          "binding contains the loop var "
+       << loop_var_ << " is not a data parallel block iter";
+    return os.str();
+  }
+
+  IRModule mod() const final { return mod_; }
+  Array<ObjectRef> LocationsOfInterest() const final { return {block_}; }
+
+  IRModule mod_;
+  std::string op_str_;
+  Var loop_var_;
+  Block block_;
+};
+
+/*!
+ * \brief Check if a loop can be parallelized/vectorized with regard to a specific block
+ * \details There are two conditions:
+ * 1) The block is required to have affine bindings, and
+ * 2) For each block iter whose binding contains the input loop variable, the block iter is
+ * required to be data parallel
+ * \param self The schedule state
+ * \param for_kind The desired ForKind (only `kParallel` and `kVectorized` are allowed)
+ * \param loop_var The loop variable of the loop to be checked
+ * \param block_realize The block-realize of the block to be checked
+ * \throws ScheduleError If the input loop cannot be parallelized/vectorized with regard to the
+ * input block
+ */
+void CheckLoopParallelizableInBlock(const ScheduleState& self, ForKind for_kind,
+                                    const Var& loop_var, const BlockRealize& block_realize) {
+  const Block& block = block_realize->block;
+
+  // Cond 1. The block is required to have affine bindings.
+  CheckAffineBinding(self, block);
+
+  // Cond 2. For each block iter whose binding contains `loop_var`, the block iter is required to be
+  // data parallel
+  ICHECK_EQ(block->iter_vars.size(), block_realize->iter_values.size());
+  int n_iters = static_cast<int>(block->iter_vars.size());
+  for (int i = 0; i < n_iters; ++i) {
+    const IterVar& iter_var = block->iter_vars[i];
+    const PrimExpr& binding = block_realize->iter_values[i];
+    if (iter_var->iter_type != kDataPar && ExprUseVar(binding, loop_var)) {
+      throw WrongBlockIterTypeError(self->mod, for_kind, loop_var, block);
+    }
+  }
+}
+
+/*!
+ * \brief For each block (recursive) under the given loop, check whether the input loop can be
+ * parallelized/vectorized with regard to the block
+ * \param self The schedule state
+ * \param loop The loop to be parallelized/vectorized
+ * \param for_kind The desired ForKind (only `kParallel` and `kVectorized` are allowed)
+ */
+void CheckParallelizability(const ScheduleState& self, const For& loop, ForKind for_kind) {
+  PreOrderVisit(loop, [&](const ObjectRef& node) {
+    if (const auto* realize = node.as<BlockRealizeNode>()) {
+      CheckLoopParallelizableInBlock(self, for_kind, loop->loop_var,
+                                     GetRef<BlockRealize>(realize));
+    }
+    return true;
+  });
+}
+
+/*!
+ * \brief The implementation of parallelizing/vectorizing the input loop
+ * \param self The schedule state
+ * \param loop_sref The sref of the loop to be parallelized/vectorized
+ * \param for_kind The type of the operation (only `kParallel` and `kVectorized` are allowed)
+ */
+void ParallelizeComputation(const ScheduleState& self, const StmtSRef& loop_sref,
+                            ForKind for_kind) {
+  const ForNode* loop = TVM_SREF_TO_FOR(loop, loop_sref);
+
+  /*
+   * Check:
+   * - 1. the scope that the loop is in is a stage pipeline
+   * - 2. all the blocks under the given loop have affine block bindings
+   * - 3. the input loop can be only bound to data parallel block iters
+   * When the above conditions are all satisfied, this input loop can be parallelized/vectorized.
+   */
+  // Step 1. Check whether the scope that the loop is in has a stage pipeline
+  GetScopeRootAndCheckStagePipeline(self, loop_sref);
+
+  // Step 2. Check whether the loop can be parallelized/vectorized with regard to each underlying
+  // block.
+  CheckParallelizability(self, GetRef<For>(loop), for_kind);
+
+  // Step 3. Loop update and IR replacement
+  ObjectPtr<ForNode> new_loop = make_object<ForNode>(*loop);
+  new_loop->kind = for_kind;
+  self->Replace(loop_sref, For(new_loop), {});
+}
+
+void Parallel(ScheduleState self, const StmtSRef& loop_sref) {
+  ParallelizeComputation(self, loop_sref, ForKind::kParallel);
+}
+
+void Vectorize(ScheduleState self, const StmtSRef& loop_sref) {
+  ParallelizeComputation(self, loop_sref, ForKind::kVectorized);
+}
+
+void Unroll(ScheduleState self, const StmtSRef& loop_sref) {
+  const ForNode* loop = TVM_SREF_TO_FOR(loop, loop_sref);
+  ObjectPtr<ForNode> new_loop = make_object<ForNode>(*loop);
+  new_loop->kind = ForKind::kUnrolled;
+  new_loop->thread_binding = NullOpt;
+  self->Replace(loop_sref, For(new_loop), {});
+}
+
+}  // namespace tir
+}  // namespace tvm
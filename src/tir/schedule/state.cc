@@ -191,79 +191,38 @@ const PrimFuncNode* GetRootPrimFunc(const IRModule& mod, const StmtNode* root_bl
 
 /**************** Creation ****************/
 
-/*! \brief A helper class to create a new ScheduleStateNode from an IRModule */
-class StateCreator : private StmtVisitor {
+/*! \brief A helper class to update BlockInfo for a ScheduleStateNode */
+class BlockInfoCollector : private StmtVisitor {
  public:
   /*!
-   * \brief The entry function
-   * \param self The schedule state to be completed
+   * \brief Collect the BlockInfo of all blocks in a subtree whose srefs have been created
+   * \param self The schedule state to be updated
+   * \param stmt The root of the subtree to be analyzed
    */
-  static ObjectPtr<ScheduleStateNode> Create(IRModule mod, int debug_mode) {
-    ObjectPtr<ScheduleStateNode> n = make_object<ScheduleStateNode>();
-    ScheduleStateNode* self = n.get();
-    // Set `n->mod`
-    n->mod = std::move(mod);
-    // Set `n->debug_mode`
-    n->debug_mode = debug_mode;
-    // Set `n->stmt2ref` and `n->block_info`
-    StateCreator creator(self);
-    for (const auto& kv : n->mod->functions) {
-      const BaseFunc& base_func = kv.second;
-      if (const auto* func = base_func.as<PrimFuncNode>()) {
-        creator.VisitStmt(func->body);
-      }
-    }
-    return n;
+  static void Collect(ScheduleStateNode* self, const Stmt& stmt) {
+    BlockInfoCollector collector(self);
+    collector.VisitStmt(stmt);
   }
 
  private:
-  explicit StateCreator(ScheduleStateNode* self)
-      : self_(self), srefs_{}, block2realize_{}, block_frames_{} {
-    block_frames_.emplace({});
-  }
-
-  /*!
-   * \brief Add a new statement to the stack, which becomes the current scope
-   * \param stmt A for-loop statement or a block statement
-   * \return A sref to the stmt
-   */
-  StmtSRef PushSRef(const StmtNode* stmt) {
-    if (srefs_.empty()) {
-      srefs_.push_back(
-          StmtSRef(stmt,
-                   /*parent=*/nullptr,
-                   /*seq_index=*/-1));  // `seq_index` will be set properly in SetSeqIndex
-    } else {
-      StmtSRefNode* parent = srefs_.back().get();
-      srefs_.push_back(
-          StmtSRef(stmt, parent,
-                   /*seq_index=*/-1));  // `seq_index` will be set properly in SetSeqIndex
-    }
-    return srefs_.back();
-  }
-
-  /*! \brief Pop the top of the scope and record it in stmt2ref map */
-  StmtSRef PopAndRecordSRef() {
-    StmtSRef sref = std::move(srefs_.back());
-    self_->stmt2ref[sref->stmt] = sref;
-    srefs_.pop_back();
-    return sref;
+  explicit BlockInfoCollector(ScheduleStateNode* self)
+      : self_(self), block2realize_{}, block_frames_{} {
+    block_frames_.emplace_back();
   }
 
   void MakeBlockInfo(StmtSRef scope_root) {
-    bool is_root_block = srefs_.empty();
+    bool is_root_block = scope_root->parent == nullptr;
     // Calculate `BlockInfo::scope`
     Array<StmtSRef> child_block_srefs = std::move(block_frames_.back());
-    BlockInfo& info =
-        self_->block_info.emplace(scope_root, BlockInfo(BlockScope(child_block_srefs)))
-            .first->second;
+    BlockInfo& info = self_->block_info[scope_root] = BlockInfo(BlockScope(child_block_srefs));
     // Set `affine_binding`
     if (is_root_block) {
       info.affine_binding = true;
     } else {
       info.affine_binding =
           IsAffineBinding(/*realize=*/block2realize_.at(scope_root->stmt),
-                          /*loop_var_ranges=*/LoopDomainOfSRefTreePath(srefs_.back()),
+                          /*loop_var_ranges=*/
+                          LoopDomainOfSRefTreePath(GetRef<StmtSRef>(scope_root->parent)),
                           /*analyzer=*/&analyzer_);
     }
     // Set `region_cover` to true, will be updated on its scope block
@@ -399,9 +358,7 @@ class StateCreator : private StmtVisitor {
 
   void VisitStmt_(const ForNode* loop) final {
     analyzer_.Bind(loop->loop_var, Range::FromMinExtent(loop->min, loop->extent));
-    PushSRef(loop);
     VisitStmt(loop->body);
-    PopAndRecordSRef();
   }
 
   void VisitStmt_(const BlockRealizeNode* realize) final {
@@ -409,9 +366,8 @@ class StateCreator : private StmtVisitor {
     const BlockNode* block = realize->block.get();
     block2realize_.emplace(block, GetRef<BlockRealize>(realize));
     // Recursive visit
-    PushSRef(block);
     VisitStmt(block->body);  // `block->init` is not visited
-    StmtSRef sref = PopAndRecordSRef();
+    const StmtSRef& sref = self_->stmt2ref.at(block);
     // Create BlockInfo for the block
     MakeBlockInfo(sref);
     // Update parent scope
@@ -419,6 +375,86 @@ class StateCreator : private StmtVisitor {
     block_frames_.back().push_back(sref);
   }
 
+  /*! \brief The schedule state to be updated */
+  ScheduleStateNode* self_;
+  /*! \brief The BlockRealize corresponding to blocks */
+  std::unordered_map<const StmtNode*, BlockRealize> block2realize_;
+  /*! \brief The stack frames of blocks in the DFS visit. */
+  std::vector<Array<StmtSRef>> block_frames_;
+  /*! \brief The auxilary analyzer */
+  arith::Analyzer analyzer_;
+};
+
+/*! \brief A helper class to create a new ScheduleStateNode from an IRModule */
+class StateCreator : private StmtVisitor {
+ public:
+  /*!
+   * \brief The entry function
+   * \param self The schedule state to be completed
+   */
+  static ObjectPtr<ScheduleStateNode> Create(IRModule mod, int debug_mode) {
+    ObjectPtr<ScheduleStateNode> n = make_object<ScheduleStateNode>();
+    ScheduleStateNode* self = n.get();
+    // Set `n->mod`
+    n->mod = std::move(mod);
+    // Set `n->debug_mode`
+    n->debug_mode = debug_mode;
+    // Set `n->stmt2ref` and `n->block_info`
+    StateCreator creator(self);
+    for (const auto& kv : n->mod->functions) {
+      const BaseFunc& base_func = kv.second;
+      if (const auto* func = base_func.as<PrimFuncNode>()) {
+        creator.VisitStmt(func->body);
+        BlockInfoCollector::Collect(self, func->body);
+      }
+    }
+    return n;
+  }
+
+ private:
+  explicit StateCreator(ScheduleStateNode* self) : self_(self), srefs_{} {}
+
+  /*!
+   * \brief Add a new statement to the stack, which becomes the current scope
+   * \param stmt A for-loop statement or a block statement
+   * \return A sref to the stmt
+   */
+  StmtSRef PushSRef(const StmtNode* stmt) {
+    if (srefs_.empty()) {
+      srefs_.push_back(
+          StmtSRef(stmt,
+                   /*parent=*/nullptr,
+                   /*seq_index=*/-1));  // `seq_index` will be set properly in SetSeqIndex
+    } else {
+      StmtSRefNode* parent = srefs_.back().get();
+      srefs_.push_back(
+          StmtSRef(stmt, parent,
+                   /*seq_index=*/-1));  // `seq_index` will be set properly in SetSeqIndex
+    }
+    return srefs_.back();
+  }
+
+  /*! \brief Pop the top of the scope and record it in stmt2ref map */
+  StmtSRef PopAndRecordSRef() {
+    StmtSRef sref = std::move(srefs_.back());
+    self_->stmt2ref[sref->stmt] = sref;
+    srefs_.pop_back();
+    return sref;
+  }
+
+  void VisitStmt_(const ForNode* loop) final {
+    PushSRef(loop);
+    VisitStmt(loop->body);
+    PopAndRecordSRef();
+  }
+
+  void VisitStmt_(const BlockRealizeNode* realize) final {
+    const BlockNode* block = realize->block.get();
+    PushSRef(block);
+    VisitStmt(block->body);  // `block->init` is not visited
+    PopAndRecordSRef();
+  }
+
   void VisitStmt_(const SeqStmtNode* seq_stmt) final {
     // Set `seq_index` information for SeqStmtNode
     StmtVisitor::VisitStmt_(seq_stmt);
@@ -429,12 +465,6 @@ class StateCreator : private StmtVisitor {
   ScheduleStateNode* self_;
   /*! \brief The stack frame used to indicate the current scope */
   std::vector<StmtSRef> srefs_;
-  /*! \brief The BlockRealize corresponding to blocks */
-  std::unordered_map<const StmtNode*, BlockRealize> block2realize_;
-  /*! \brief The stack frames of blocks in the DFS visit. */
-  std::vector<Array<StmtSRef>> block_frames_;
-  /*! \brief The auxilary analyzer */
-  arith::Analyzer analyzer_;
 };
 
 /**************** Constructor ****************/
@@ -1053,6 +1083,14 @@ BlockInfo ScheduleStateNode::GetBlockInfo(const StmtSRef& block_sref) const {
   return it->second;
 }
 
+void ScheduleStateNode::UpdateScopeBlockInfo(const BlockRealize& scope_root_realize) {
+  const StmtSRef& scope_root = this->stmt2ref.at(scope_root_realize->block.get());
+  auto it = this->block_info.find(scope_root);
+  bool region_cover = it == this->block_info.end() ? true : it->second.region_cover;
+  BlockInfoCollector::Collect(this, scope_root_realize);
+  this->block_info.at(scope_root).region_cover = region_cover;
+}
+
 TVM_DLL Array<Bool> GetCachedFlags(const ScheduleState& self, const StmtSRef& block_sref) {
   const BlockInfo& info = self->GetBlockInfo(block_sref);
   return {Bool(info.affine_binding),  //
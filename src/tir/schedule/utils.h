@@ -37,7 +37,9 @@
 #include "../../support/array.h"
 #include "./analysis.h"
 #include "./error.h"
+#include "./ir_comparator.h"
 #include "./primitive.h"
+#include "./transform.h"
 
 namespace tvm {
 namespace tir {
@@ -143,6 +145,42 @@ inline Stmt RemoveFromSeqStmt(const SeqStmt& seq, const Stmt& to_remove) {
   return SeqStmt::Flatten(new_stmts);
 }
 
+/*!
+ * \brief Insert a statement into the body of a loop or a block at the specific position.
+ * If the body is not a SeqStmt, a SeqStmt containing both the body and the statement is created.
+ * \param body The body to be inserted into
+ * \param pos The position of the statement in the result
+ * \param stmt The statement to be inserted
+ * \return The insertion result
+ */
+inline Stmt InsertIntoSeqStmt(const Stmt& body, int pos, const Stmt& stmt) {
+  if (const auto* seq = body.as<SeqStmtNode>()) {
+    ICHECK(0 <= pos && pos <= static_cast<int>(seq->size()));
+    Array<Stmt> new_stmts = seq->seq;
+    new_stmts.insert(new_stmts.begin() + pos, stmt);
+    return SeqStmt(new_stmts);
+  }
+  ICHECK(pos == 0 || pos == 1);
+  return pos == 0 ? SeqStmt({stmt, body}) : SeqStmt({body, stmt});
+}
+
+/******** SRef tree ********/
+
+/*!
+ * \brief Get the position of the subtree that contains `sref` in the body of `ancestor_sref`
+ * \param ancestor_sref The ancestor loop or block
+ * \param sref The descendant loop or block, which must be strictly under `ancestor_sref`
+ * \return The index of the subtree in the body of `ancestor_sref`, or 0 if the body is not a
+ * SeqStmt
+ */
+inline int GetSubtreeIndex(const StmtSRef& ancestor_sref, const StmtSRef& sref) {
+  const StmtSRefNode* p = sref.get();
+  for (; p->parent != ancestor_sref.get(); p = p->parent) {
+    ICHECK(p->parent != nullptr) << "InternalError: The sref is not under the given ancestor";
+  }
+  return p->seq_index == -1 ? 0 : static_cast<int>(p->seq_index);
+}
+
 /******** Integer set ********/
 
 /*!
@@ -0,0 +1,402 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file auto_cache_tiling.cc
+ * \brief Tile and interchange perfectly nested affine loop nests to fit the L1 cache.
+ *
+ * The pass looks for bands of serial loops with constant extents whose innermost body is a
+ * single BufferStore, i.e. the loop nests left by the default injective and reduction
+ * schedules. A band is transformed when
+ *  - every buffer access is an affine function of the loop vars (checked by DetectIterMap);
+ *  - every iteration either writes a distinct element, or updates the stored element with a
+ *    commutative reduction (+, *, min, max), so that any iteration order gives the same result;
+ *  - the data touched by the whole nest does not fit in the cache.
+ * Each loop is then split by a tile size chosen so that the data touched by one tile fits in
+ * half of the cache, the tile loops are moved outside, and within the tile the loop with the
+ * most contiguous or invariant accesses is moved innermost. A loop whose extent has no divisor
+ * close to the tile size, e.g. a prime extent, is tiled anyway and its last tile is guarded.
+ */
+#include <tvm/arith/analyzer.h>
+#include <tvm/arith/iter_affine_map.h>
+#include <tvm/arith/pattern.h>
+#include <tvm/node/structural_equal.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/target/target.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace tir {
+
+struct AutoCacheTilingConfigNode : public tvm::AttrsNode<AutoCacheTilingConfigNode> {
+  bool enable;
+  int cache_size;
+
+  TVM_DECLARE_ATTRS(AutoCacheTilingConfigNode, "tir.transform.AutoCacheTilingConfig") {
+    TVM_ATTR_FIELD(enable)
+        .describe("Whether to tile the perfectly nested loop nests")
+        .set_default(false);
+    TVM_ATTR_FIELD(cache_size)
+        .describe(
+            "The size of the cache in bytes. "
+            "When not positive, the l1-cache-size of the target or 32KB is used")
+        .set_default(0);
+  }
+};
+
+class AutoCacheTilingConfig : public Attrs {
+ public:
+  TVM_DEFINE_NOTNULLABLE_OBJECT_REF_METHODS(AutoCacheTilingConfig, Attrs,
+                                            AutoCacheTilingConfigNode);
+};
+
+TVM_REGISTER_NODE_TYPE(AutoCacheTilingConfigNode);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.AutoCacheTiling", AutoCacheTilingConfig);
+
+/*! \brief A buffer access in the loop nest, with the coefficient of each loop var per dim. */
+struct TiledAccess {
+  Buffer buffer;
+  /*! \brief coeffs[d][v] is the coefficient of the v-th loop var in the d-th index. */
+  std::vector<std::vector<int64_t>> coeffs;
+};
+
+class LoopNestTiler {
+ public:
+  LoopNestTiler(std::vector<const ForNode*> loops, const BufferStoreNode* store,
+                int64_t cache_size)
+      : loops_(std::move(loops)), store_(store), cache_size_(cache_size) {
+    for (const ForNode* loop : loops_) {
+      loop_vars_.push_back(loop->loop_var);
+      extents_.push_back(Downcast<IntImm>(loop->extent)->value);
+      dom_map_.Set(loop->loop_var, Range::FromMinExtent(loop->min, loop->extent));
+    }
+  }
+
+  /*! \brief Return the tiled loop nest, or NullOpt if the nest is left as is. */
+  Optional<Stmt> Tile() {
+    if (!CollectAccesses() || !IsReorderable()) {
+      return NullOpt;
+    }
+    int n = static_cast<int>(loops_.size());
+    if (Footprint(extents_) <= cache_size_) {
+      return NullOpt;
+    }
+    // Step 1. Pick the largest uniform tile size that fits in half of the cache
+    std::vector<int64_t> tiles;
+    for (int64_t t = 256; t >= 2; t /= 2) {
+      tiles = TileSizes(t);
+      if (Footprint(tiles) <= cache_size_ / 2) {
+        break;
+      }
+    }
+    bool split = false;
+    for (int i = 0; i < n; ++i) {
+      split = split || (tiles[i] > 1 && tiles[i] < extents_[i]);
+    }
+    if (!split) {
+      return NullOpt;
+    }
+    // Step 2. Pick the innermost loop of a tile
+    int innermost = n - 1;
+    int best_score = Score(innermost);
+    for (int i = 0; i < n; ++i) {
+      int score = Score(i);
+      if (score > best_score) {
+        best_score = score;
+        innermost = i;
+      }
+    }
+    // Step 3. Build the tile loops outside and the loops within a tile inside
+    std::vector<For> outer_loops;
+    std::vector<For> inner_loops;
+    int innermost_pos = -1;
+    Map<Var, PrimExpr> vmap;
+    PrimExpr guard = const_true();
+    for (int i = 0; i < n; ++i) {
+      const ForNode* loop = loops_[i];
+      const Var& var = loop->loop_var;
+      if (tiles[i] == 1) {
+        outer_loops.push_back(GetRef<For>(loop));
+      } else if (tiles[i] == extents_[i]) {
+        innermost_pos = i == innermost ? static_cast<int>(inner_loops.size()) : innermost_pos;
+        inner_loops.push_back(GetRef<For>(loop));
+      } else {
+        Var outer = var.copy_with_suffix(".outer");
+        Var inner = var.copy_with_suffix(".inner");
+        PrimExpr factor = make_const(var.dtype(), tiles[i]);
+        int64_t num_tiles = (extents_[i] + tiles[i] - 1) / tiles[i];
+        outer_loops.push_back(For(outer, make_zero(var.dtype()),
+                                  make_const(var.dtype(), num_tiles), ForKind::kSerial,
+                                  Evaluate(0)));
+        innermost_pos = i == innermost ? static_cast<int>(inner_loops.size()) : innermost_pos;
+        inner_loops.push_back(
+            For(inner, make_zero(var.dtype()), factor, ForKind::kSerial, Evaluate(0)));
+        vmap.Set(var, loop->min + outer * factor + inner);
+        if (extents_[i] % tiles[i] != 0) {
+          guard = guard && (outer * factor + inner < make_const(var.dtype(), extents_[i]));
+        }
+      }
+    }
+    if (innermost_pos != -1) {
+      auto it = inner_loops.begin() + innermost_pos;
+      std::rotate(it, it + 1, inner_loops.end());
+    }
+    Stmt body = Substitute(GetRef<Stmt>(store_), vmap);
+    if (!is_one(guard)) {
+      body = IfThenElse(likely(guard), body);
+    }
+    for (auto loop = inner_loops.rbegin(); loop != inner_loops.rend(); ++loop) {
+      body = Rewrap(*loop, body);
+    }
+    for (auto loop = outer_loops.rbegin(); loop != outer_loops.rend(); ++loop) {
+      body = Rewrap(*loop, body);
+    }
+    return body;
+  }
+
+ private:
+  static Stmt Rewrap(const For& loop, Stmt body) {
+    ObjectPtr<ForNode> n = make_object<ForNode>(*loop.get());
+    n->body = std::move(body);
+    return For(n);
+  }
+
+  bool CollectAccesses() {
+    bool success = AddAccess(store_->buffer, store_->indices);
+    PostOrderVisit(store_->value, [&](const ObjectRef& node) {
+      if (const auto* load = node.as<BufferLoadNode>()) {
+        success = success && AddAccess(load->buffer, load->indices);
+      } else if (node->IsInstance<LoadNode>() || node->IsInstance<ProducerLoadNode>() ||
+                 node->IsInstance<LetNode>()) {
+        success = false;
+      }
+    });
+    return success && SideEffect(store_->value) <= CallEffectKind::kReadState;
+  }
+
+  bool AddAccess(const Buffer& buffer, const Array<PrimExpr>& indices) {
+    for (const PrimExpr& extent : buffer->shape) {
+      if (!extent->IsInstance<IntImmNode>()) {
+        return false;
+      }
+    }
+    if (arith::DetectIterMap(indices, dom_map_, const_true(), false, &analyzer_).empty()) {
+      return false;
+    }
+    TiledAccess access{buffer, {}};
+    for (const PrimExpr& index : indices) {
+      Array<PrimExpr> coeffs = arith::DetectLinearEquation(index, loop_vars_);
+      if (coeffs.empty()) {
+        return false;
+      }
+      std::vector<int64_t> dim_coeffs;
+      for (size_t i = 0; i < loop_vars_.size(); ++i) {
+        const auto* coeff = analyzer_.Simplify(coeffs[i]).as<IntImmNode>();
+        if (coeff == nullptr) {
+          return false;
+        }
+        dim_coeffs.push_back(coeff->value);
+      }
+      access.coeffs.push_back(std::move(dim_coeffs));
+    }
+    accesses_.push_back(std::move(access));
+    return true;
+  }
+
+  /*!
+   * \brief Check if the iterations can be executed in any order: either every iteration writes
+   * its own element, or all of them update the element by the same commutative reduction.
+   */
+  bool IsReorderable() {
+    const Buffer& buffer = store_->buffer;
+    BufferLoad self_load(buffer, store_->indices);
+    int num_self_loads = 0;
+    for (size_t i = 1; i < accesses_.size(); ++i) {
+      if (accesses_[i].buffer->data.same_as(buffer->data)) {
+        ++num_self_loads;
+      }
+    }
+    if (num_self_loads == 0) {
+      return !arith::DetectIterMap(store_->indices, dom_map_, const_true(), true, &analyzer_).empty();
+    }
+    if (num_self_loads > 1) {
+      return false;
+    }
+    auto f_is_reduction = [&](const PrimExpr& a, const PrimExpr& b) {
+      StructuralEqual equal;
+      return (equal(a, self_load) && !UsesBuffer(b)) || (equal(b, self_load) && !UsesBuffer(a));
+    };
+    const PrimExpr& value = store_->value;
+    if (const auto* op = value.as<AddNode>()) return f_is_reduction(op->a, op->b);
+    if (const auto* op = value.as<MulNode>()) return f_is_reduction(op->a, op->b);
+    if (const auto* op = value.as<MinNode>()) return f_is_reduction(op->a, op->b);
+    if (const auto* op = value.as<MaxNode>()) return f_is_reduction(op->a, op->b);
+    return false;
+  }
+
+  bool UsesBuffer(const PrimExpr& expr) const {
+    bool found = false;
+    PostOrderVisit(expr, [&](const ObjectRef& node) {
+      if (const auto* load = node.as<BufferLoadNode>()) {
+        found = found || load->buffer->data.same_as(store_->buffer->data);
+      }
+    });
+    return found;
+  }
+
+  /*!
+   * \brief The tile size of each loop: the largest divisor of its extent not exceeding t. If
+   * that divisor is not larger than half of t, e.g. for a prime extent, the loop is tiled by t
+   * and its last tile is guarded instead.
+   */
+  std::vector<int64_t> TileSizes(int64_t t) const {
+    std::vector<int64_t> tiles;
+    for (int64_t extent : extents_) {
+      int64_t target = std::min(t, extent);
+      int64_t tile = target;
+      while (extent % tile != 0) {
+        --tile;
+      }
+      tiles.push_back(tile * 2 > target ? tile : target);
+    }
+    return tiles;
+  }
+
+  /*! \brief The number of bytes touched when each loop runs the given number of iterations. */
+  int64_t Footprint(const std::vector<int64_t>& tiles) const {
+    int64_t bytes = 0;
+    for (const TiledAccess& access : accesses_) {
+      int64_t elems = 1;
+      for (size_t d = 0; d < access.coeffs.size(); ++d) {
+        int64_t extent = 1;
+        for (size_t i = 0; i < tiles.size(); ++i) {
+          extent += std::abs(access.coeffs[d][i]) * (tiles[i] - 1);
+        }
+        elems *= std::min(extent, Downcast<IntImm>(access.buffer->shape[d])->value);
+      }
+      bytes += elems * access.buffer->dtype.bytes();
+    }
+    return bytes;
+  }
+
+  /*! \brief How much the accesses benefit from the i-th loop being innermost. */
+  int Score(int i) const {
+    int score = 0;
+    for (const TiledAccess& access : accesses_) {
+      int64_t stride = 0;
+      int64_t dim_stride = 1;
+      for (int d = static_cast<int>(access.coeffs.size()) - 1; d >= 0; --d) {
+        stride += access.coeffs[d][i] * dim_stride;
+        dim_stride *= Downcast<IntImm>(access.buffer->shape[d])->value;
+      }
+      if (std::abs(stride) == 1) {
+        score += 2;
+      } else if (stride == 0) {
+        score += 1;
+      }
+    }
+    return score;
+  }
+
+  std::vector<const ForNode*> loops_;
+  const BufferStoreNode* store_;
+  int64_t cache_size_;
+  Array<Var> loop_vars_;
+  std::vector<int64_t> extents_;
+  Map<Var, Range> dom_map_;
+  /*! \brief The accesses of the nest, the store first. */
+  std::vector<TiledAccess> accesses_;
+  arith::Analyzer analyzer_;
+};
+
+class AutoCacheTilingRewriter : public StmtMutator {
+ public:
+  explicit AutoCacheTilingRewriter(int64_t cache_size) : cache_size_(cache_size) {}
+
+  Stmt VisitStmt_(const ForNode* op) final {
+    std::vector<const ForNode*> loops;
+    Stmt body = GetRef<For>(op);
+    while (const auto* loop = body.as<ForNode>()) {
+      if (loop->kind != ForKind::kSerial || loop->thread_binding.defined() ||
+          !loop->annotations.empty() || !loop->extent->IsInstance<IntImmNode>()) {
+        break;
+      }
+      loops.push_back(loop);
+      body = loop->body;
+    }
+    const auto* store = body.as<BufferStoreNode>();
+    if (store != nullptr && loops.size() >= 2) {
+      if (Optional<Stmt> tiled = LoopNestTiler(loops, store, cache_size_).Tile()) {
+        return tiled.value();
+      }
+    }
+    return StmtMutator::VisitStmt_(op);
+  }
+
+ private:
+  int64_t cache_size_;
+};
+
+namespace transform {
+
+Pass AutoCacheTiling() {
+  auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
+    auto cfg = ctx->GetConfig<AutoCacheTilingConfig>("tir.AutoCacheTiling");
+    if (!cfg.defined()) {
+      cfg = AttrsWithDefaultValues<AutoCacheTilingConfig>();
+    }
+    if (!cfg.value()->enable) {
+      return f;
+    }
+    Optional<Target> target = f->GetAttr<Target>(tvm::attr::kTarget);
+    if (!target.defined()) {
+      target = Target::Current(true);
+    }
+    if (target.defined() && target.value()->kind->device_type != kDLCPU) {
+      return f;
+    }
+    int64_t cache_size = cfg.value()->cache_size;
+    if (cache_size <= 0) {
+      cache_size = 32 * 1024;
+      if (target.defined()) {
+        cache_size =
+            target.value()->GetAttr<Integer>("l1-cache-size", Integer(cache_size)).value()->value;
+      }
+    }
+    auto* n = f.CopyOnWrite();
+    n->body = AutoCacheTilingRewriter(cache_size)(std::move(n->body));
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tir.AutoCacheTiling", {});
+}
+
+TVM_REGISTER_GLOBAL("tir.transform.AutoCacheTiling").set_body_typed(AutoCacheTiling);
+
+}  // namespace transform
+
+}  // namespace tir
+}  // namespace tvm
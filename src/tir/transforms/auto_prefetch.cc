@@ -0,0 +1,299 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file auto_prefetch.cc
+ * \brief Insert software prefetches for the strided and indirect loads of innermost loops.
+ *
+ * Unlike InjectPrefetch, which lowers the prefetch_scope attributes placed by the schedule,
+ * this pass works on flattened TIR and decides by itself what to prefetch. For every innermost
+ * serial loop it looks at the loads from the function arguments (which live in DRAM):
+ *  - a load whose index is linear in the loop var is prefetched when its stride is large enough
+ *    to defeat the hardware prefetcher;
+ *  - a load whose index is not linear in the loop var (e.g. an embedding lookup `T[idx[i]]`) is
+ *    always prefetched.
+ * The prefetched address is the one accessed `distance` iterations later, clamped to the last
+ * iteration of the loop, so the index loads of indirect accesses stay in bounds.
+ */
+#include <tvm/arith/analyzer.h>
+#include <tvm/arith/pattern.h>
+#include <tvm/node/structural_equal.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/target/target.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include <cstdlib>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace tir {
+
+struct AutoPrefetchConfigNode : public tvm::AttrsNode<AutoPrefetchConfigNode> {
+  bool enable;
+  int distance;
+  int min_stride_bytes;
+  int max_prefetch_per_loop;
+
+  TVM_DECLARE_ATTRS(AutoPrefetchConfigNode, "tir.transform.AutoPrefetchConfig") {
+    TVM_ATTR_FIELD(enable)
+        .describe("Whether to insert prefetches automatically")
+        .set_default(false);
+    TVM_ATTR_FIELD(distance)
+        .describe("The number of loop iterations to prefetch ahead")
+        .set_default(8);
+    TVM_ATTR_FIELD(min_stride_bytes)
+        .describe("The minimum stride in bytes of a linear access to be prefetched")
+        .set_default(64);
+    TVM_ATTR_FIELD(max_prefetch_per_loop)
+        .describe("The maximum number of prefetches inserted into one loop")
+        .set_default(4);
+  }
+};
+
+class AutoPrefetchConfig : public Attrs {
+ public:
+  TVM_DEFINE_NOTNULLABLE_OBJECT_REF_METHODS(AutoPrefetchConfig, Attrs, AutoPrefetchConfigNode);
+};
+
+TVM_REGISTER_NODE_TYPE(AutoPrefetchConfigNode);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.AutoPrefetch", AutoPrefetchConfig);
+
+/*! \brief Collect the loads from global buffers in the body of an innermost loop. */
+class PrefetchCandidateCollector : public StmtExprVisitor {
+ public:
+  struct Candidate {
+    Load load;
+    /*! \brief Whether the load is only executed under some condition. */
+    bool conditional;
+  };
+
+  explicit PrefetchCandidateCollector(const std::unordered_set<const VarNode*>& global_buffers)
+      : global_buffers_(global_buffers) {}
+
+  std::vector<Candidate> candidates;
+  /*! \brief The vars defined inside the loop body, which cannot be used before it. */
+  std::unordered_set<const VarNode*> defined_vars;
+
+ private:
+  void VisitExpr_(const LoadNode* op) final {
+    StmtExprVisitor::VisitExpr_(op);
+    if (global_buffers_.count(op->buffer_var.get())) {
+      candidates.push_back({GetRef<Load>(op), cond_depth_ > 0});
+    }
+  }
+
+  void VisitExpr_(const LetNode* op) final {
+    defined_vars.insert(op->var.get());
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitStmt_(const LetStmtNode* op) final {
+    defined_vars.insert(op->var.get());
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const AllocateNode* op) final {
+    defined_vars.insert(op->buffer_var.get());
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const IfThenElseNode* op) final {
+    this->VisitExpr(op->condition);
+    ++cond_depth_;
+    this->VisitStmt(op->then_case);
+    if (op->else_case.defined()) {
+      this->VisitStmt(op->else_case);
+    }
+    --cond_depth_;
+  }
+
+  void VisitExpr_(const SelectNode* op) final {
+    this->VisitExpr(op->condition);
+    ++cond_depth_;
+    this->VisitExpr(op->true_value);
+    this->VisitExpr(op->false_value);
+    --cond_depth_;
+  }
+
+  void VisitExpr_(const CallNode* op) final {
+    if (op->op.same_as(builtin::if_then_else())) {
+      this->VisitExpr(op->args[0]);
+      ++cond_depth_;
+      this->VisitExpr(op->args[1]);
+      this->VisitExpr(op->args[2]);
+      --cond_depth_;
+    } else {
+      StmtExprVisitor::VisitExpr_(op);
+    }
+  }
+
+  const std::unordered_set<const VarNode*>& global_buffers_;
+  int cond_depth_{0};
+};
+
+class AutoPrefetchInjector : public StmtMutator {
+ public:
+  AutoPrefetchInjector(std::unordered_set<const VarNode*> global_buffers, AutoPrefetchConfig cfg)
+      : global_buffers_(std::move(global_buffers)), cfg_(std::move(cfg)) {}
+
+  Stmt VisitStmt_(const ForNode* op) final {
+    bool has_inner_loop = false;
+    std::swap(has_inner_loop, has_inner_loop_);
+    Stmt stmt = StmtMutator::VisitStmt_(op);
+    std::swap(has_inner_loop, has_inner_loop_);
+    // Tell the enclosing loop that it is not innermost
+    has_inner_loop_ = true;
+    if (has_inner_loop || op->kind != ForKind::kSerial) {
+      return stmt;
+    }
+    if (const auto* extent = op->extent.as<IntImmNode>()) {
+      if (extent->value <= cfg_->distance) {
+        return stmt;
+      }
+    }
+    op = stmt.as<ForNode>();
+    Array<Stmt> prefetches = MakePrefetches(op);
+    if (prefetches.empty()) {
+      return stmt;
+    }
+    prefetches.push_back(op->body);
+    ObjectPtr<ForNode> n = CopyOnWrite(op);
+    n->body = SeqStmt(prefetches);
+    return Stmt(n);
+  }
+
+ private:
+  Array<Stmt> MakePrefetches(const ForNode* loop) {
+    PrefetchCandidateCollector collector(global_buffers_);
+    collector(loop->body);
+
+    const Var& loop_var = loop->loop_var;
+    // The loop var `distance` iterations later, clamped to the last iteration
+    PrimExpr ahead = min(loop_var + make_const(loop_var.dtype(), cfg_->distance),
+                         loop->min + loop->extent - 1);
+    Map<Var, PrimExpr> vmap{{loop_var, ahead}};
+
+    Array<Stmt> prefetches;
+    std::vector<std::pair<Var, PrimExpr>> visited;
+    for (const PrefetchCandidateCollector::Candidate& candidate : collector.candidates) {
+      if (static_cast<int>(prefetches.size()) >= cfg_->max_prefetch_per_loop) {
+        break;
+      }
+      const Load& load = candidate.load;
+      PrimExpr index = load->index;
+      if (const auto* ramp = index.as<RampNode>()) {
+        index = ramp->base;
+      }
+      auto f_defined_in_body = [&](const VarNode* v) { return collector.defined_vars.count(v); };
+      if (!ExprUseVar(index, loop_var) || ExprUseVar(index, f_defined_in_body)) {
+        continue;
+      }
+      Array<PrimExpr> coeffs = arith::DetectLinearEquation(index, {loop_var});
+      if (!coeffs.empty()) {
+        // Contiguous accesses are already handled well by the hardware prefetcher
+        const auto* stride = analyzer_.Simplify(coeffs[0]).as<IntImmNode>();
+        if (stride == nullptr ||
+            std::abs(stride->value) * load->dtype.bytes() < cfg_->min_stride_bytes) {
+          continue;
+        }
+      } else if (candidate.conditional && ContainsLoad(index)) {
+        // The index loads of an indirect access may be out of bounds when its guard is false
+        continue;
+      }
+      PrimExpr prefetch_index = analyzer_.Simplify(Substitute(index, vmap));
+      bool duplicate = false;
+      for (const auto& kv : visited) {
+        if (kv.first.same_as(load->buffer_var) && StructuralEqual()(kv.second, prefetch_index)) {
+          duplicate = true;
+          break;
+        }
+      }
+      if (duplicate) {
+        continue;
+      }
+      visited.emplace_back(load->buffer_var, prefetch_index);
+      DataType dtype = load->dtype.element_of();
+      PrimExpr address = Call(DataType::Handle(), builtin::address_of(),
+                              {Load(dtype, load->buffer_var, prefetch_index, const_true())});
+      prefetches.push_back(Evaluate(Call(dtype, builtin::prefetch(), {address, 0, 3, 1})));
+    }
+    return prefetches;
+  }
+
+  static bool ContainsLoad(const PrimExpr& expr) {
+    bool found = false;
+    PostOrderVisit(expr, [&found](const ObjectRef& node) {
+      if (node->IsInstance<LoadNode>()) {
+        found = true;
+      }
+    });
+    return found;
+  }
+
+  /*! \brief The data vars of the buffers passed in as function arguments. */
+  std::unordered_set<const VarNode*> global_buffers_;
+  AutoPrefetchConfig cfg_;
+  /*! \brief Whether the loop being visited contains another loop. */
+  bool has_inner_loop_{false};
+  arith::Analyzer analyzer_;
+};
+
+namespace transform {
+
+Pass AutoPrefetch() {
+  auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
+    auto cfg = ctx->GetConfig<AutoPrefetchConfig>("tir.AutoPrefetch");
+    if (!cfg.defined()) {
+      cfg = AttrsWithDefaultValues<AutoPrefetchConfig>();
+    }
+    if (!cfg.value()->enable) {
+      return f;
+    }
+    auto target = f->GetAttr<Target>(tvm::attr::kTarget);
+    if (target.defined() && target.value()->kind->device_type != kDLCPU) {
+      return f;
+    }
+    std::unordered_set<const VarNode*> global_buffers;
+    for (const Var& param : f->params) {
+      if (param.dtype().is_handle()) {
+        global_buffers.insert(param.get());
+      }
+    }
+    for (const auto& kv : f->buffer_map) {
+      global_buffers.insert(kv.second->data.get());
+    }
+    auto* n = f.CopyOnWrite();
+    n->body = AutoPrefetchInjector(std::move(global_buffers), cfg.value())(std::move(n->body));
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tir.AutoPrefetch", {});
+}
+
+TVM_REGISTER_GLOBAL("tir.transform.AutoPrefetch").set_body_typed(AutoPrefetch);
+
+}  // namespace transform
+
+}  // namespace tir
+}  // namespace tvm
@@ -21,6 +21,7 @@
  * \file make_packed_api.cc Lower PrimFunc to use the packed function API.
  */
 #include <tvm/runtime/device_api.h>
+#include <tvm/runtime/module.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/target/target.h>
 #include <tvm/tir/analysis.h>
@@ -30,6 +31,7 @@
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
+#include <string>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -105,7 +107,14 @@ inline Stmt MakeAssertEQ(PrimExpr lhs, PrimExpr rhs, std::string msg) {
   return AssertStmt(lhs == rhs, tvm::tir::StringImm(msg), Evaluate(0));
 }
 
-PrimFunc MakePackedAPI(PrimFunc&& func, int num_unpacked_args) {
+/*!
+ * \brief Lower the PrimFunc to the packed function API.
+ * \param func The function.
+ * \param num_unpacked_args The number of the arguments which are not packed.
+ * \param trusted Whether to skip the checks of the arguments, for the trusted entry whose caller
+ *  has verified the signature.
+ */
+PrimFunc MakePackedAPI(PrimFunc&& func, int num_unpacked_args, bool trusted) {
   auto global_symbol = func->GetAttr<String>(tvm::attr::kGlobalSymbol);
   ICHECK(global_symbol) << "MakePackedAPI: Expect PrimFunc to have the global_symbol attribute";
 
@@ -137,6 +146,10 @@ PrimFunc MakePackedAPI(PrimFunc&& func, int num_unpacked_args) {
   // seq_init gives sequence of initialization
   // seq_check gives sequence of later checks after init
   std::vector<Stmt> seq_init, seq_check;
+  // The checks of the arguments, which are dropped from the trusted entry.
+  auto f_add_check = [trusted](std::vector<Stmt>* seq, Stmt check) {
+    if (!trusted) seq->emplace_back(std::move(check));
+  };
   std::unordered_map<const VarNode*, PrimExpr> vmap;
   ArgBinder binder(&vmap);
   // ---------------------------
@@ -165,7 +178,7 @@ PrimFunc MakePackedAPI(PrimFunc&& func, int num_unpacked_args) {
     std::ostringstream os;
 
     os << name_hint << ": num_args should be " << num_packed_args;
-    seq_init.emplace_back(MakeAssertEQ(v_num_packed_args, num_packed_args, os.str()));
+    f_add_check(&seq_init, MakeAssertEQ(v_num_packed_args, num_packed_args, os.str()));
   }
 
   // Need to re-declare vars, in case some arguments also appears in the buffer.
@@ -195,18 +208,20 @@ PrimFunc MakePackedAPI(PrimFunc&& func, int num_unpacked_args) {
       if (t.is_handle()) {
         std::ostringstream msg;
         msg << name_hint << ": Expect arg[" << i << "] to be pointer";
-        seq_check.emplace_back(AssertStmt(tcode == kTVMOpaqueHandle || tcode == kTVMNDArrayHandle ||
-                                              tcode == kTVMDLTensorHandle || tcode == kTVMNullptr,
-                                          tvm::tir::StringImm(msg.str()), nop));
+        f_add_check(&seq_check,
+                    AssertStmt(tcode == kTVMOpaqueHandle || tcode == kTVMNDArrayHandle ||
+                                   tcode == kTVMDLTensorHandle || tcode == kTVMNullptr,
+                               tvm::tir::StringImm(msg.str()), nop));
       } else if (t.is_int() || t.is_uint()) {
         std::ostringstream msg;
         msg << name_hint << ": Expect arg[" << i << "] to be int";
-        seq_check.emplace_back(AssertStmt(tcode == kDLInt, tvm::tir::StringImm(msg.str()), nop));
+        f_add_check(&seq_check, AssertStmt(tcode == kDLInt, tvm::tir::StringImm(msg.str()), nop));
       } else {
         ICHECK(t.is_float());
         std::ostringstream msg;
         msg << name_hint << ": Expect arg[" << i << "] to be float";
-        seq_check.emplace_back(AssertStmt(tcode == kDLFloat, tvm::tir::StringImm(msg.str()), nop));
+        f_add_check(&seq_check,
+                    AssertStmt(tcode == kDLFloat, tvm::tir::StringImm(msg.str()), nop));
       }
     } else {
       args.push_back(v_arg);
@@ -258,7 +273,8 @@ PrimFunc MakePackedAPI(PrimFunc&& func, int num_unpacked_args) {
       body = SeqStmt({set_device, body});
     }
   }
-  func_ptr->body = MergeNest({seq_init, binder.init_nest(), seq_check, binder.asserts()}, body);
+  std::vector<Stmt> binder_asserts = trusted ? std::vector<Stmt>() : binder.asserts();
+  func_ptr->body = MergeNest({seq_init, binder.init_nest(), seq_check, binder_asserts}, body);
   func_ptr->params = args;
 
   Array<Var> undefined = UndefinedVars(func_ptr->body, func_ptr->params);
@@ -285,13 +301,24 @@ Pass MakePackedAPI(int num_unpacked_args) {
   auto pass_func = [num_unpacked_args](IRModule m, PassContext ctx) {
     IRModuleNode* mptr = m.CopyOnWrite();
     std::vector<std::pair<GlobalVar, PrimFunc> > updates;
+    bool emit_trusted_entry = ctx->GetConfig<Bool>("tir.emit_trusted_entry", Bool(false)).value();
 
     for (const auto& kv : mptr->functions) {
       if (auto* n = kv.second.as<PrimFuncNode>()) {
         PrimFunc func = GetRef<PrimFunc>(n);
         if (func->GetAttr<Integer>(tvm::attr::kCallingConv, Integer(CallingConv::kDefault)) ==
             CallingConv::kDefault) {
-          auto updated_func = MakePackedAPI(std::move(func), num_unpacked_args);
+          if (emit_trusted_entry) {
+            std::string name = func->GetAttr<String>(tvm::attr::kGlobalSymbol).value();
+            name += runtime::symbol::tvm_trusted_entry_suffix;
+            PrimFunc trusted = WithAttr(func, tvm::attr::kGlobalSymbol, String(name));
+            if (trusted->HasNonzeroAttr(tir::attr::kIsEntryFunc)) {
+              trusted = WithAttr(std::move(trusted), tir::attr::kIsEntryFunc, Bool(false));
+            }
+            updates.push_back({GlobalVar(name), MakePackedAPI(std::move(trusted),
+                                                              num_unpacked_args, true)});
+          }
+          auto updated_func = MakePackedAPI(std::move(func), num_unpacked_args, false);
           updates.push_back({kv.first, updated_func});
         }
       }
@@ -306,6 +333,8 @@ Pass MakePackedAPI(int num_unpacked_args) {
   return tvm::transform::CreateModulePass(pass_func, 0, "tir.MakePackedAPI", {});
 }
 
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.emit_trusted_entry", Bool);
+
 TVM_REGISTER_GLOBAL("tir.transform.MakePackedAPI").set_body_typed(MakePackedAPI);
 }  // namespace transform
 }  // namespace tir
@@ -0,0 +1,141 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file specialize_shapes.cc
+ * \brief Make specialized variants of a dynamic shape PrimFunc for its frequent shapes.
+ *
+ * For each frequent shape, the body is copied with the symbolic shape vars replaced by their
+ * values, and the copies are dispatched by comparing the shape vars, which are bound from the
+ * arguments, with the values:
+ *
+ *   if (n == 128) { body[n := 128] } else if (n == 1024) { body[n := 1024] } else { body }
+ *
+ * so the later passes see the constant extents and strides in the specialized variants.
+ */
+#include <tvm/node/structural_equal.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "ir_utils.h"
+
+namespace tvm {
+namespace tir {
+
+struct SpecializeShapesConfigNode : public tvm::AttrsNode<SpecializeShapesConfigNode> {
+  Array<Map<String, Integer>> shapes;
+
+  TVM_DECLARE_ATTRS(SpecializeShapesConfigNode, "tir.transform.SpecializeShapesConfig") {
+    TVM_ATTR_FIELD(shapes)
+        .describe("The frequent shapes, each one maps the names of shape vars to their values")
+        .set_default(Array<Map<String, Integer>>());
+  }
+};
+
+class SpecializeShapesConfig : public Attrs {
+ public:
+  TVM_DEFINE_NOTNULLABLE_OBJECT_REF_METHODS(SpecializeShapesConfig, Attrs,
+                                            SpecializeShapesConfigNode);
+};
+
+TVM_REGISTER_NODE_TYPE(SpecializeShapesConfigNode);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.SpecializeShapes", SpecializeShapesConfig);
+
+/*! \brief Collect the symbolic vars in the shapes, strides and offsets of the buffer arguments. */
+static std::vector<Var> CollectShapeVars(const PrimFunc& f) {
+  std::vector<Var> vars;
+  std::unordered_set<const VarNode*> visited;
+  auto f_add = [&](const PrimExpr& e) {
+    if (const auto* v = e.as<VarNode>()) {
+      if (visited.insert(v).second) {
+        vars.push_back(GetRef<Var>(v));
+      }
+    }
+  };
+  for (const Var& param : f->params) {
+    auto it = f->buffer_map.find(param);
+    if (it == f->buffer_map.end()) continue;
+    const Buffer& buffer = (*it).second;
+    for (const PrimExpr& e : buffer->shape) f_add(e);
+    for (const PrimExpr& e : buffer->strides) f_add(e);
+    f_add(buffer->elem_offset);
+  }
+  return vars;
+}
+
+namespace transform {
+
+Pass SpecializeShapes() {
+  auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
+    auto cfg = ctx->GetConfig<SpecializeShapesConfig>("tir.SpecializeShapes");
+    if (!cfg.defined() || cfg.value()->shapes.empty()) {
+      return f;
+    }
+    std::vector<Var> shape_vars = CollectShapeVars(f);
+    if (shape_vars.empty()) {
+      return f;
+    }
+    std::vector<std::pair<PrimExpr, Stmt>> variants;
+    std::vector<Map<Var, PrimExpr>> visited;
+    for (const Map<String, Integer>& shape : cfg.value()->shapes) {
+      Map<Var, PrimExpr> vmap;
+      PrimExpr cond;
+      for (const Var& var : shape_vars) {
+        auto it = shape.find(var->name_hint);
+        if (it == shape.end()) continue;
+        PrimExpr value = make_const(var.dtype(), (*it).second->value);
+        vmap.Set(var, value);
+        cond = cond.defined() ? (cond && var == value) : (var == value);
+      }
+      // The shape does not concern this function, or is already specialized.
+      if (vmap.empty() || std::any_of(visited.begin(), visited.end(), [&](const auto& prev) {
+            return StructuralEqual()(prev, vmap);
+          })) {
+        continue;
+      }
+      visited.push_back(vmap);
+      variants.emplace_back(cond, Substitute(f->body, vmap));
+    }
+    if (variants.empty()) {
+      return f;
+    }
+    Stmt body = f->body;
+    for (auto it = variants.rbegin(); it != variants.rend(); ++it) {
+      body = IfThenElse(it->first, it->second, body);
+    }
+    auto* n = f.CopyOnWrite();
+    // The variants define the same vars, rename them.
+    n->body = ConvertSSA(std::move(body));
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tir.SpecializeShapes", {});
+}
+
+TVM_REGISTER_GLOBAL("tir.transform.SpecializeShapes").set_body_typed(SpecializeShapes);
+
+}  // namespace transform
+
+}  // namespace tir
+}  // namespace tvm
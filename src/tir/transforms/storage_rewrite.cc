@@ -334,6 +334,7 @@ class StoragePlanRewriter : public StmtExprMutator {
 
   Stmt Rewrite(Stmt stmt, bool detect_inplace) {
     detect_inplace_ = detect_inplace;
+    this->FindParallelGroups(stmt);
     // plan the rewrite
     LinearAccessPatternFinder finder;
     finder(stmt);
@@ -428,6 +429,9 @@ class StoragePlanRewriter : public StmtExprMutator {
     if (attach_map_.count(op)) {
       auto& svec = attach_map_[op];
       Stmt stmt = StmtExprMutator::VisitStmt_(op);
+      if (op->kind == ForKind::kParallel && CanLiftAllocations(op)) {
+        return MakeParallelLaunch(svec, {stmt});
+      }
       op = stmt.as<ForNode>();
       return For(op->loop_var, op->min, op->extent, op->kind, MakeAttach(svec, op->body),
                  op->thread_binding, op->annotations);
@@ -436,6 +440,30 @@ class StoragePlanRewriter : public StmtExprMutator {
     }
   }
 
+  Stmt VisitStmt_(const SeqStmtNode* op) final {
+    if (parallel_groups_.empty()) {
+      return StmtExprMutator::VisitStmt_(op);
+    }
+    Array<Stmt> seq;
+    for (size_t i = 0; i < op->seq.size(); ++i) {
+      auto it = parallel_groups_.find(op->seq[i].get());
+      if (it == parallel_groups_.end() || !attach_map_.count(it->first)) {
+        seq.push_back(this->VisitStmt(op->seq[i]));
+        continue;
+      }
+      // The sibling parallel loops share one launch and the per-task allocations.
+      Array<Stmt> loops;
+      for (const ForNode* loop : it->second) {
+        ICHECK(op->seq[i].get() == loop);
+        loops.push_back(StmtExprMutator::VisitStmt_(loop));
+        ++i;
+      }
+      --i;
+      seq.push_back(MakeParallelLaunch(attach_map_[it->first], loops));
+    }
+    return SeqStmt::Flatten(seq);
+  }
+
   Stmt VisitStmt_(const AllocateNode* op) final { return this->VisitStmt(op->body); }
 
  private:
@@ -481,6 +509,90 @@ class StoragePlanRewriter : public StmtExprMutator {
     std::vector<const VarNode*> kill;
   };
 
+  /*!
+   * \brief Launch the parallel loops in one parallel region, in which each task makes the
+   *  allocations once before running its share of the iterations, instead of making them in
+   *  every iteration. The loops are separated by barriers.
+   */
+  Stmt MakeParallelLaunch(const std::vector<StorageEntry*>& svec, const Array<Stmt>& loops) {
+    Array<Stmt> seq;
+    for (size_t i = 0; i < loops.size(); ++i) {
+      const auto* loop = loops[i].as<ForNode>();
+      ICHECK(loop != nullptr && loop->kind == ForKind::kParallel);
+      if (i + 1 < loops.size()) {
+        seq.push_back(AttrStmt(loop->loop_var, "pragma_parallel_barrier_when_finish",
+                               make_const(DataType::Int(32), 1), loops[i]));
+      } else {
+        seq.push_back(loops[i]);
+      }
+    }
+    const auto* first = loops[0].as<ForNode>();
+    return AttrStmt(first->loop_var, "pragma_parallel_launch_point",
+                    make_const(DataType::Int(32), 1), MakeAttach(svec, SeqStmt::Flatten(seq)));
+  }
+
+  /*!
+   * \brief Check whether the allocations in a parallel loop can be made before the loop,
+   *  i.e. their extents do not depend on the vars defined by the loop.
+   */
+  static bool CanLiftAllocations(const ForNode* loop) {
+    std::unordered_set<const VarNode*> defined_vars{loop->loop_var.get()};
+    std::vector<const AllocateNode*> allocs;
+    PostOrderVisit(loop->body, [&](const ObjectRef& node) {
+      if (const auto* op = node.as<ForNode>()) {
+        defined_vars.insert(op->loop_var.get());
+      } else if (const auto* op = node.as<LetStmtNode>()) {
+        defined_vars.insert(op->var.get());
+      } else if (const auto* op = node.as<LetNode>()) {
+        defined_vars.insert(op->var.get());
+      } else if (const auto* op = node.as<AllocateNode>()) {
+        defined_vars.insert(op->buffer_var.get());
+        allocs.push_back(op);
+      }
+    });
+    auto f_defined = [&](const VarNode* v) { return defined_vars.count(v) != 0; };
+    for (const AllocateNode* alloc : allocs) {
+      for (const PrimExpr& extent : alloc->extents) {
+        if (ExprUseVar(extent, f_defined)) return false;
+      }
+    }
+    return true;
+  }
+
+  /*!
+   * \brief Group the adjacent sibling parallel loops that make liftable allocations,
+   *  so that the allocations of the later loops can reuse the ones of the earlier loops.
+   */
+  void FindParallelGroups(const Stmt& stmt) {
+    auto f_has_alloc = [](const Stmt& s) {
+      const auto* loop = s.as<ForNode>();
+      if (loop == nullptr || loop->kind != ForKind::kParallel) return false;
+      bool found = false;
+      PostOrderVisit(loop->body, [&found](const ObjectRef& node) {
+        found = found || node->IsInstance<AllocateNode>();
+      });
+      return found && CanLiftAllocations(loop);
+    };
+    PostOrderVisit(stmt, [&](const ObjectRef& node) {
+      const auto* seq = node.as<SeqStmtNode>();
+      if (seq == nullptr) return;
+      for (size_t i = 0; i < seq->seq.size();) {
+        size_t j = i;
+        while (j < seq->seq.size() && f_has_alloc(seq->seq[j])) ++j;
+        if (j - i >= 2) {
+          std::vector<const ForNode*> group;
+          for (size_t k = i; k < j; ++k) {
+            const auto* loop = seq->seq[k].as<ForNode>();
+            group.push_back(loop);
+            parallel_group_leader_[loop] = seq->seq[i].get();
+          }
+          parallel_groups_[seq->seq[i].get()] = std::move(group);
+        }
+        i = std::max(j, i + 1);
+      }
+    });
+  }
+
   Stmt MakeAttach(const std::vector<StorageEntry*>& svec, Stmt body) {
     std::vector<Stmt> nest;
     for (StorageEntry* e : svec) {
@@ -751,8 +863,20 @@ class StoragePlanRewriter : public StmtExprMutator {
       } else if (s.stmt->IsInstance<ForNode>()) {
         const auto* op = static_cast<const ForNode*>(s.stmt);
         if (op->kind == ForKind::kParallel) {
-          if (thread_scope_ == nullptr || thread_scope_ == op) {
-            PlanNewScope(op);
+          // The loops in a parallel group attach their allocations to the first loop.
+          const Object* scope = op;
+          bool last_of_group = true;
+          auto it = parallel_group_leader_.find(op);
+          if (it != parallel_group_leader_.end()) {
+            scope = it->second;
+            last_of_group = parallel_groups_.at(scope).back() == op;
+          }
+          if (thread_scope_ == scope && seq[i].scope_pair_offset < 0 && !last_of_group) {
+            // Leave a loop which is not the last of its group, keep its free memory
+            // for the next loops of the group.
+            thread_scope_ = nullptr;
+          } else if (thread_scope_ == nullptr || thread_scope_ == scope) {
+            PlanNewScope(scope);
           }
         }
       }
@@ -867,6 +991,10 @@ class StoragePlanRewriter : public StmtExprMutator {
   }
   // thread scope.
   const Object* thread_scope_{nullptr};
+  // The groups of adjacent sibling parallel loops, indexed by the first loop of the group.
+  std::unordered_map<const Object*, std::vector<const ForNode*>> parallel_groups_;
+  // The first loop of the group of each grouped parallel loop.
+  std::unordered_map<const ForNode*, const Object*> parallel_group_leader_;
   // whether enable inplace detection.
   bool detect_inplace_{false};
   // Locations of free ops.
@@ -33,6 +33,7 @@
 
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace tvm {
@@ -92,6 +93,109 @@ class VecAllocAccess : public StmtExprMutator {
   int var_lanes_;
 };
 
+/*!
+ * \brief Check whether a vectorized statement guarded by a vector condition can be executed
+ *  with its memory accesses predicated by the condition, instead of being scalarized.
+ */
+class PredicationChecker : public StmtExprVisitor {
+ public:
+  static bool Check(const Stmt& stmt, int lanes) {
+    PredicationChecker checker(lanes);
+    checker(stmt);
+    return checker.predicable_;
+  }
+
+ private:
+  explicit PredicationChecker(int lanes) : lanes_(lanes) {}
+
+  void VisitStmt(const Stmt& stmt) final {
+    if (predicable_) {
+      StmtExprVisitor::VisitStmt(stmt);
+    }
+  }
+
+  void VisitExpr(const PrimExpr& expr) final {
+    if (predicable_) {
+      StmtExprVisitor::VisitExpr(expr);
+    }
+  }
+
+  // Accesses that are not vectorized cannot be predicated per lane.
+  void VisitExpr_(const LoadNode* op) final {
+    predicable_ = predicable_ && op->dtype.lanes() == lanes_;
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitStmt_(const StoreNode* op) final {
+    predicable_ = predicable_ && op->value.dtype().lanes() == lanes_;
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  // Side effects other than stores cannot be masked.
+  void VisitStmt_(const EvaluateNode* op) final {
+    predicable_ = predicable_ && SideEffect(op->value) <= CallEffectKind::kReadState;
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const WhileNode* op) final { predicable_ = false; }
+
+  // The inactive lanes must not trap on a division by zero.
+  void VisitExpr_(const DivNode* op) final {
+    CheckDivisor(op->b);
+    StmtExprVisitor::VisitExpr_(op);
+  }
+  void VisitExpr_(const ModNode* op) final {
+    CheckDivisor(op->b);
+    StmtExprVisitor::VisitExpr_(op);
+  }
+  void VisitExpr_(const FloorDivNode* op) final {
+    CheckDivisor(op->b);
+    StmtExprVisitor::VisitExpr_(op);
+  }
+  void VisitExpr_(const FloorModNode* op) final {
+    CheckDivisor(op->b);
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void CheckDivisor(const PrimExpr& divisor) {
+    if (!divisor.dtype().is_float()) {
+      PrimExpr value = divisor;
+      if (const auto* broadcast = divisor.as<BroadcastNode>()) {
+        value = broadcast->value;
+      }
+      const int64_t* as_int = as_const_int(value);
+      predicable_ = predicable_ && as_int != nullptr && *as_int != 0;
+    }
+  }
+
+  int lanes_;
+  bool predicable_{true};
+};
+
+/*! \brief Predicate all the loads and stores of a statement by a vector condition. */
+class PredicationInjector : public StmtExprMutator {
+ public:
+  explicit PredicationInjector(PrimExpr mask) : mask_(std::move(mask)) {}
+
+ private:
+  PrimExpr VisitExpr_(const LoadNode* op) final {
+    PrimExpr index = this->VisitExpr(op->index);
+    return Load(op->dtype, op->buffer_var, index, Combine(op->predicate));
+  }
+
+  Stmt VisitStmt_(const StoreNode* op) final {
+    PrimExpr value = this->VisitExpr(op->value);
+    PrimExpr index = this->VisitExpr(op->index);
+    return Store(op->buffer_var, value, index, Combine(op->predicate));
+  }
+
+  PrimExpr Combine(const PrimExpr& predicate) const {
+    return is_one(predicate) ? mask_ : predicate && mask_;
+  }
+
+  PrimExpr mask_;
+};
+
 // We use ExprFunctor directly instead of StmtExprMutator
 // This is because the transformation can change the dtype of the Expr
 // The existing ExprMutator transformation rules may not be well defined.
@@ -100,7 +204,8 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
   using ExprFunctor::VisitExpr;
   using StmtMutator::operator();
 
-  Vectorizer(Var var, int var_lanes) : var_(var), var_lanes_(var_lanes) {
+  Vectorizer(Var var, int var_lanes, bool allow_predication)
+      : var_(var), var_lanes_(var_lanes), allow_predication_(allow_predication) {
     ramp_ = Ramp(0, 1, var_lanes);
   }
 
@@ -374,6 +479,17 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     ICHECK(!op->condition.dtype().is_vector());
     PrimExpr condition = this->VisitExpr(op->condition);
     if (condition.dtype().is_vector()) {
+      if (allow_predication_ && !op->else_case.defined()) {
+        Stmt then_case = this->VisitStmt(op->then_case);
+        if (PredicationChecker::Check(then_case, var_lanes_)) {
+          if (const auto* call = condition.as<CallNode>()) {
+            if (call->op.same_as(builtin::likely())) {
+              condition = call->args[0];
+            }
+          }
+          return PredicationInjector(condition)(then_case);
+        }
+      }
       return Scalarize(GetRef<Stmt>(op));
     }
     Stmt then_case = this->VisitStmt(op->then_case);
@@ -459,6 +575,8 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
   Var var_;
   // the lanes.
   int var_lanes_;
+  // whether a vector condition can be lowered to predicated loads and stores.
+  bool allow_predication_;
   // ramp representing the var.
   PrimExpr ramp_;
   // flag to mark requirment of scalarization.
@@ -530,6 +648,9 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
 
 class LoopVectorizer : public StmtMutator {
  public:
+  explicit LoopVectorizer(bool allow_predication = false)
+      : allow_predication_(allow_predication) {}
+
   Stmt VisitStmt_(const ForNode* op) final {
     if (op->kind == ForKind::kVectorized) {
       ICHECK(is_zero(op->min));
@@ -537,11 +658,15 @@ class LoopVectorizer : public StmtMutator {
       if (!extent_as_int || extent_as_int->value < 1) {
         LOG(FATAL) << "Failed to vectorize loop with extent " << op->extent;
       }
-      return Vectorizer(op->loop_var, static_cast<int>(extent_as_int->value))(op->body);
+      return Vectorizer(op->loop_var, static_cast<int>(extent_as_int->value),
+                        allow_predication_)(op->body);
     } else {
       return StmtMutator::VisitStmt_(op);
     }
   }
+
+ private:
+  bool allow_predication_;
 };
 
 Stmt VectorizeLoop(Stmt stmt) { return LoopVectorizer()(std::move(stmt)); }
@@ -563,12 +688,16 @@ Stmt SkipVectorize(Stmt stmt) { return VectorizeSkipper()(std::move(stmt)); }
 
 namespace transform {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.enable_vectorize_predication", Bool);
+
 // TODO(tvm-team): Make it as a target property.
 Pass VectorizeLoop(bool enable_vectorize) {
   auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
     auto* n = f.CopyOnWrite();
     if (enable_vectorize) {
-      n->body = LoopVectorizer()(std::move(n->body));
+      bool allow_predication =
+          ctx->GetConfig<Bool>("tir.enable_vectorize_predication", Bool(false)).value();
+      n->body = LoopVectorizer(allow_predication)(std::move(n->body));
     } else {
       n->body = VectorizeSkipper()(std::move(n->body));
     }
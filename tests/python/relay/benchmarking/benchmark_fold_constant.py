@@ -0,0 +1,57 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmarking the compile time of FoldConstant with and without batched evaluation."""
+import time
+
+import numpy as np
+
+import tvm
+from tvm import relay
+
+
+def get_workload(num_layers, channels=16):
+    """A chain of convolutions whose weights go through foldable transforms."""
+    x = relay.var("x", shape=(1, channels, 14, 14))
+    y = x
+    for _ in range(num_layers):
+        w_data = np.random.uniform(size=(channels, channels, 3, 3)).astype("float32")
+        w = relay.multiply(relay.const(w_data), relay.const(0.5))
+        w = relay.layout_transform(w, "OIHW", "OIHW4o")
+        w = relay.layout_transform(w, "OIHW4o", "OIHW")
+        y = relay.nn.relu(relay.nn.conv2d(y, w, padding=(1, 1)))
+    mod = tvm.IRModule.from_expr(relay.Function([x], y))
+    return relay.transform.InferType()(mod)
+
+
+def benchmark_fold_constant(num_layers):
+    mod = get_workload(num_layers)
+    results = {}
+    for batch in [False, True]:
+        with tvm.transform.PassContext(config={"relay.FoldConstant.batch": batch}):
+            start = time.time()
+            folded = relay.transform.FoldConstant()(mod)
+            results[batch] = (time.time() - start, folded)
+    assert tvm.ir.structural_equal(results[False][1], results[True][1])
+    print(
+        "%4d foldable subgraphs: per-expression %8.2f s, batched %8.2f s"
+        % (num_layers, results[False][0], results[True][0])
+    )
+
+
+if __name__ == "__main__":
+    for n in [16, 64, 256]:
+        benchmark_fold_constant(n)
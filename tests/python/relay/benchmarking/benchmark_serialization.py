@@ -0,0 +1,68 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmarking the json and binary IR serialization on models with embedded constants."""
+import timeit
+
+import tvm
+from tvm import relay
+from tvm.relay import testing
+
+
+def benchmark_serialization(mod, name, repeat=5):
+    def measure(func):
+        return min(timeit.repeat(func, number=1, repeat=repeat)) * 1000
+
+    json_str = tvm.ir.save_json(mod)
+    blob = tvm.ir.save_binary(mod)
+    tvm.ir.assert_structural_equal(tvm.ir.load_binary(blob), mod)
+
+    print("%s:" % name)
+    print("  size     json: %10.2f MB  binary: %10.2f MB" % (len(json_str) / 1e6, len(blob) / 1e6))
+    print(
+        "  save     json: %10.2f ms  binary: %10.2f ms"
+        % (measure(lambda: tvm.ir.save_json(mod)), measure(lambda: tvm.ir.save_binary(mod)))
+    )
+    print(
+        "  load     json: %10.2f ms  binary: %10.2f ms"
+        % (measure(lambda: tvm.ir.load_json(json_str)), measure(lambda: tvm.ir.load_binary(blob)))
+    )
+
+
+def bind_params(mod, params):
+    mod["main"] = relay.build_module.bind_params_by_name(mod["main"], params)
+    return mod
+
+
+def test_resnet():
+    mod, params = testing.resnet.get_workload(num_layers=18)
+    benchmark_serialization(bind_params(mod, params), "resnet-18")
+
+
+def test_mobilenet():
+    mod, params = testing.mobilenet.get_workload()
+    benchmark_serialization(bind_params(mod, params), "mobilenet")
+
+
+def test_vgg():
+    mod, params = testing.vgg.get_workload(num_layers=16)
+    benchmark_serialization(bind_params(mod, params), "vgg-16")
+
+
+if __name__ == "__main__":
+    test_resnet()
+    test_mobilenet()
+    test_vgg()
@@ -298,6 +298,48 @@ def test_fold_dropout():
     assert tvm.ir.structural_equal(run_infer_type(before_mod["main"]), after_mod["main"])
 
 
+def test_fold_const_batch():
+    x = relay.var("x", shape=(1, 8, 6, 6))
+    y = x
+    weights = []
+    for i in range(4):
+        w_data = np.random.uniform(size=(8, 8, 3, 3)).astype("float32")
+        weights.append(w_data)
+        # shared between a constant and a non-constant consumer
+        w = relay.multiply(relay.const(w_data), relay.const(2.0))
+        w = relay.layout_transform(w, "OIHW", "HWIO")
+        w = relay.layout_transform(w, "HWIO", "OIHW")
+        y = relay.nn.conv2d(y, w, padding=(1, 1)) + relay.sum(w)
+    c = relay.const(np.array([1, 2, 3]).astype("float32"))
+    t = relay.Tuple([relay.add(c, c), c])
+    y = relay.Tuple([y, relay.TupleGetItem(t, 0)])
+    func = relay.Function([x], y)
+
+    zz = run_opt_pass(func, transform.FoldConstant())
+    with tvm.transform.PassContext(config={"relay.FoldConstant.batch": True}):
+        zz_batch = run_opt_pass(func, transform.FoldConstant())
+    assert tvm.ir.structural_equal(zz, zz_batch)
+    conv = zz_batch.body.fields[0].args[0]
+    assert isinstance(conv.args[1], relay.Constant)
+    np.testing.assert_allclose(conv.args[1].data.numpy(), weights[-1] * 2, rtol=1e-6)
+
+
+def test_fold_const_batch_if():
+    c = relay.const(np.array([1, 2, 3]).astype("float32"))
+    x = relay.var("x", shape=(3,))
+    cond = relay.less(relay.const(1.0), relay.const(2.0))
+    # only the taken branch is folded, the other one is dropped without being evaluated
+    iff = relay.If(cond, relay.add(c, c) + x, relay.multiply(c, c) + x)
+    func = relay.Function([x], iff)
+
+    zz = run_opt_pass(func, transform.FoldConstant())
+    with tvm.transform.PassContext(config={"relay.FoldConstant.batch": True}):
+        zz_batch = run_opt_pass(func, transform.FoldConstant())
+    assert tvm.ir.structural_equal(zz, zz_batch)
+    assert isinstance(zz_batch.body, relay.Call)
+    np.testing.assert_allclose(zz_batch.body.args[0].data.numpy(), [2, 4, 6])
+
+
 if __name__ == "__main__":
     test_fold_const()
     test_fold_let()
@@ -307,3 +349,5 @@ if __name__ == "__main__":
     test_fold_batch_norm()
     test_fold_ndarray_size()
     test_fold_dropout()
+    test_fold_const_batch()
+    test_fold_const_batch_if()
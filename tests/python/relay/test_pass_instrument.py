@@ -16,6 +16,8 @@
 # under the License.
 """ Instrument test cases.
 """
+import json
+
 import pytest
 import tvm
 import tvm.relay
@@ -59,6 +61,55 @@ def test_pass_timing_instrument():
     assert profiles == ""
 
 
+def test_pass_profile_object():
+    pass_timing = PassTimingInstrument(track_memory=True, track_ir_size=True)
+    with tvm.transform.PassContext(instruments=[pass_timing]):
+        mod = get_test_model()
+        seq = tvm.transform.Sequential(
+            [tvm.relay.transform.InferType(), tvm.relay.transform.ToANormalForm()]
+        )
+        mod = seq(mod)
+        mod = tvm.relay.transform.InferType()(mod)
+
+        profiles = pass_timing.get_profiles()
+        assert [p.name for p in profiles] == ["sequential", "InferType"]
+        seq_profile = profiles[0]
+        assert [p.name for p in seq_profile.children] == ["InferType", "ToANormalForm"]
+        assert seq_profile.duration_us >= sum(p.duration_us for p in seq_profile.children)
+        assert seq_profile.self_duration_us <= seq_profile.duration_us
+        anf = seq_profile.children[1]
+        assert anf.ir_size_before > 0
+        assert anf.ir_size_after > anf.ir_size_before
+
+        summary = pass_timing.aggregate()
+        assert summary["InferType"]["count"] == 2
+        assert summary["ToANormalForm"]["count"] == 1
+
+        csv_rows = pass_timing.to_csv().splitlines()
+        assert len(csv_rows) == 5
+        assert csv_rows[2].startswith("sequential/InferType,InferType,1,")
+        assert json.loads(pass_timing.to_json())[0]["children"][1]["name"] == "ToANormalForm"
+
+
+def test_pass_profile_aggregate_nested():
+    pass_timing = PassTimingInstrument()
+    with tvm.transform.PassContext(instruments=[pass_timing]):
+        inner = tvm.transform.Sequential([tvm.relay.transform.InferType()])
+        outer = tvm.transform.Sequential([inner, tvm.relay.transform.ToANormalForm()])
+        outer(get_test_model())
+
+        (outer_profile,) = pass_timing.get_profiles()
+        inner_profile = outer_profile.children[0]
+        assert outer_profile.name == inner_profile.name == "sequential"
+        # the inner sequential is already part of the outer one's duration
+        summary = pass_timing.aggregate()["sequential"]
+        assert summary["count"] == 2
+        assert summary["duration_us"] == outer_profile.duration_us
+        assert summary["self_duration_us"] == pytest.approx(
+            outer_profile.self_duration_us + inner_profile.self_duration_us
+        )
+
+
 def test_custom_instrument():
     @pass_instrument
     class MyTest:
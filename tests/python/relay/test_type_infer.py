@@ -545,6 +545,66 @@ def test_repeat_register():
         assert "Operator custom_log3 is registered before" in str(cm.execption)
 
 
+def test_incremental_infer_type():
+    def make_mod(f1_shape):
+        mod = IRModule()
+        x = relay.var("x", shape=f1_shape)
+        f1 = relay.GlobalVar("f1")
+        mod[f1] = relay.Function([x], relay.nn.relu(x))
+        y = relay.var("y", shape=(3, 4))
+        mod["other"] = relay.Function([y], relay.exp(y))
+        z = relay.var("z", shape=f1_shape)
+        mod["main"] = relay.Function([z], f1(z) + z)
+        return mod
+
+    mod = make_mod((3, 4))
+    with tvm.transform.PassContext(config={"relay.InferType.incremental": True}):
+        mod = transform.InferType()(mod)
+        # Nothing changed, all functions are reused.
+        mod2 = transform.InferType()(mod)
+        for gv in mod.get_global_vars():
+            assert mod2[gv].same_as(mod[gv])
+
+        # Only the changed function is checked again.
+        w = relay.var("w", shape=(5,))
+        mod2["other"] = relay.Function([w], relay.sqrt(w))
+        mod2 = transform.InferType()(mod2)
+        assert mod2["main"].same_as(mod["main"])
+        assert mod2["f1"].same_as(mod["f1"])
+        other = mod2["other"]
+        assert other.checked_type.ret_type == relay.TensorType((5,), "float32")
+
+        # Callers of a changed function are checked again.
+        x = relay.var("x", shape=(3, 4))
+        mod2["f1"] = relay.Function([x], relay.sum(x, axis=1, keepdims=True))
+        mod2 = transform.InferType()(mod2)
+        assert mod2["f1"].checked_type.ret_type == relay.TensorType((3, 1), "float32")
+        call_f1 = mod2["main"].body.args[0]
+        assert call_f1.checked_type == relay.TensorType((3, 1), "float32")
+        assert mod2["other"].same_as(other)
+
+
+def test_incremental_infer_type_transitive():
+    mod = IRModule()
+    f1 = relay.GlobalVar("f1")
+    f2 = relay.GlobalVar("f2")
+    x = relay.var("x", shape=(3, 4))
+    mod[f1] = relay.Function([x], relay.nn.relu(x))
+    y = relay.var("y", shape=(3, 4))
+    mod[f2] = relay.Function([y], f1(y))
+    z = relay.var("z", shape=(3, 4))
+    mod["main"] = relay.Function([z], f2(z))
+
+    with tvm.transform.PassContext(config={"relay.InferType.incremental": True}):
+        mod = transform.InferType()(mod)
+        # main only calls f1 through f2, but is checked again when f1 changes.
+        x = relay.var("x", shape=(3, 4))
+        mod[f1] = relay.Function([x], relay.sum(x, axis=1, keepdims=True))
+        mod = transform.InferType()(mod)
+        assert mod["f2"].checked_type.ret_type == relay.TensorType((3, 1), "float32")
+        assert mod["main"].checked_type.ret_type == relay.TensorType((3, 1), "float32")
+
+
 if __name__ == "__main__":
     import sys
 
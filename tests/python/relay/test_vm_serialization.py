@@ -155,6 +155,29 @@ def test_const():
     tvm.testing.assert_allclose(res.numpy(), x_data + 1)
 
 
+def test_lazy_const():
+    c1 = relay.const(np.random.rand(3, 5).astype("float32"))
+    c2 = relay.const(np.random.rand(10, 10).astype("float32"))
+    x = relay.var("x", shape=(10, 10), dtype="float32")
+    y = relay.var("y", shape=(3, 5), dtype="float32")
+    mod = tvm.IRModule()
+    mod["main"] = relay.Function([x], x + c2)
+    mod["other"] = relay.Function([y], y * c1)
+    exe = create_exec(mod)
+    code, lib = exe.save()
+    des_exec = _vm.Executable.load_exec(code, lib)
+    # The shapes of the constants are reported without loading them.
+    assert "[10, 10]" in des_exec.stats
+    assert "[3, 5]" in des_exec.stats
+    # Saving an executable whose constants were never loaded keeps them.
+    code2, lib2 = des_exec.save()
+    assert code2 == code
+    des_vm = _vm.VirtualMachine(_vm.Executable.load_exec(code2, lib2), tvm.cpu())
+    x_data = np.random.rand(10, 10).astype("float32")
+    res = des_vm.invoke("main", x_data)
+    tvm.testing.assert_allclose(res.numpy(), x_data + c2.data.numpy())
+
+
 def test_if():
     x = relay.var("x", shape=(10, 10))
     y = relay.var("y", shape=(10, 10))
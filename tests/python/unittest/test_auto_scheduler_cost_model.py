@@ -79,6 +79,29 @@ def test_xgb_model():
     model.load(tmpfile)
 
 
+def test_gbdt_model():
+    task, inputs, results = get_sample_records(50)
+
+    model = auto_scheduler.GBDTModel(num_warmup_sample=-1)
+    model.update(inputs, results)
+    preds = model.predict(task, [x.state for x in inputs])
+    assert len(preds) == len(inputs)
+
+    costs = [np.mean([x.value for x in res.costs]) for res in results]
+    throughputs = np.min(costs) / costs
+
+    # test regression quality
+    rmse = np.sqrt(np.mean([np.square(pred - label) for pred, label in zip(preds, throughputs)]))
+    assert rmse <= 0.3
+
+    # predictions are random before warmup
+    model = auto_scheduler.GBDTModel(num_warmup_sample=100)
+    model.update(inputs, results)
+    preds = model.predict(task, [x.state for x in inputs])
+    assert all(0 <= x <= 1 for x in preds)
+
+
 if __name__ == "__main__":
     test_random_model()
     test_xgb_model()
+    test_gbdt_model()
@@ -20,6 +20,8 @@
 import math
 import tempfile
 
+import numpy as np
+
 import tvm
 from tvm import te, auto_scheduler
 
@@ -200,7 +202,73 @@ def test_gpu_feature():
         assert fequal(fea_dicts[0]["is_gpu"], 1.0)
 
 
+def test_feature_cache():
+    dag = auto_scheduler.ComputeDAG(matmul_auto_scheduler_test(128, 128, 128))
+    target = tvm.target.Target("llvm")
+    task = auto_scheduler.SearchTask(compute_dag=dag, workload_key="test", target=target)
+
+    states = []
+    for unroll in [True, False]:
+        s = dag.get_init_state()
+        C = s.stage_ops[2]
+        i, j, k = s[C].iters
+        io, ii = s.split(C, i, [16])
+        jo, ji = s.split(C, j, [8])
+        s.reorder(C, [io, jo, k, ji, ii])
+        s.vectorize(C, ji)
+        s.parallel(C, io)
+        if unroll:
+            s.unroll(C, k)
+        else:
+            s.parallel(C, jo)
+        states.append(s)
+
+    try:
+        auto_scheduler.feature.set_feature_cache_capacity(0)
+        expected = auto_scheduler.feature.get_per_store_features_from_states(states, task)
+
+        auto_scheduler.feature.set_feature_cache_capacity()
+        # the second state reuses the schedule of the first four steps of the first one
+        for _ in range(2):
+            for s, fea in zip(states, expected):
+                got = auto_scheduler.feature.get_per_store_features_from_states([s], task)[0]
+                assert got.shape == fea.shape
+                assert (got == fea).all()
+    finally:
+        auto_scheduler.feature.set_feature_cache_capacity(0)
+
+
+def test_columnar_feature():
+    A = te.placeholder((64, 32), name="A")
+    B = te.compute((64, 32), lambda i, j: A[i][j] + 1, name="B")
+    C = te.compute((64, 32), lambda i, j: B[i][j] * 2, name="C")
+    dag = auto_scheduler.ComputeDAG([A, B, C])
+    target = tvm.target.Target("llvm")
+    task = auto_scheduler.SearchTask(compute_dag=dag, workload_key="test", target=target)
+
+    s0 = dag.get_init_state()
+    s1 = dag.get_init_state()
+    s1.compute_at(1, 2, s1.stages[2].iters[1])
+    states = [s0, s1]
+
+    expected = auto_scheduler.feature.get_per_store_features_from_states(states, task)
+    # Reserve a single row per state to also exercise the regrowth of the buffer
+    features, mask = auto_scheduler.feature.get_per_store_features_from_states_columnar(
+        states, task, max_n_stores=1
+    )
+    n_stores = max(len(x) for x in expected)
+    assert features.shape == (len(states), n_stores, len(expected[0][0]))
+    assert mask.shape == (len(states), n_stores)
+    for i, fea in enumerate(expected):
+        n = len(fea)
+        assert (mask[i, :n] == 1).all() and (mask[i, n:] == 0).all()
+        np.testing.assert_allclose(features[i, :n], fea, rtol=1e-6)
+        assert (features[i, n:] == 0).all()
+
+
 if __name__ == "__main__":
     test_cpu_matmul()
     test_cpu_fusion()
     test_gpu_feature()
+    test_feature_cache()
+    test_columnar_feature()
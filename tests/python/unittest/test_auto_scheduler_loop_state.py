@@ -514,9 +514,36 @@ def test_rfactor():
     assert s2[C].iters[2].range.extent == 16
 
 
+def test_fingerprint():
+    A, B, C = matmul_auto_scheduler_test(N=512, M=512, K=512)
+    dag = auto_scheduler.ComputeDAG([A, B, C])
+
+    def make_state(factor, parallel):
+        s = dag.get_init_state()
+        i, j, k = s[C].iters
+        io, ii = s.split(C, i, [factor])
+        s.reorder(C, [io, j, k, ii])
+        if parallel:
+            s.parallel(C, io)
+        return s
+
+    s0 = make_state(16, True)
+    assert s0.fingerprint() == make_state(16, True).fingerprint()
+    assert s0.fingerprint() != make_state(8, True).fingerprint()
+    assert s0.fingerprint() != make_state(16, False).fingerprint()
+
+    # the cached prefix hashes are updated as steps are appended
+    s1 = make_state(16, False)
+    before = s1.fingerprint()
+    s1.parallel(C, s1[C].iters[0])
+    assert s1.fingerprint() != before
+    assert s1.fingerprint() == s0.fingerprint()
+
+
 if __name__ == "__main__":
     test_split_fuse_reorder_annotation()
     test_compute_at_root_inline()
     test_cache_read_write()
     test_follow_split_follow_fused_split()
     test_rfactor()
+    test_fingerprint()
@@ -203,6 +203,106 @@ def test_recover_measure_input():
         assert str(correct_inp.state) == str(inp.state)
 
 
+def test_record_store():
+    task = auto_scheduler.SearchTask(
+        func=matmul_auto_scheduler_test, args=(512, 512, 512), target="llvm"
+    )
+    inputs = [auto_scheduler.measure.MeasureInput(task, task.compute_dag.init_state)] * 4
+    results = [
+        auto_scheduler.measure.MeasureResult([0.3], 0, "", 0.2, 1),
+        auto_scheduler.measure.MeasureResult([0.1], 0, "", 0.2, 1),
+        auto_scheduler.measure.MeasureResult([0.05], 2, "", 0.2, 1),
+        auto_scheduler.measure.MeasureResult([0.2], 0, "", 0.2, 1),
+    ]
+
+    tmpdir = tvm.contrib.utils.tempdir()
+    log_file = tmpdir.relpath("records.json")
+    store_file = tmpdir.relpath("records.bin")
+    auto_scheduler.save_records(log_file, inputs[:2], results[:2])
+    assert auto_scheduler.convert_records_to_store(log_file, store_file) == 2
+
+    store = auto_scheduler.RecordStore(store_file)
+    store.append(inputs[2:], results[2:])
+    assert len(store) == 4
+
+    # the record with an error is never the best one
+    best_inp, best_res = store.best(task.workload_key, task.target)
+    assert best_inp.task.workload_key == task.workload_key
+    assert best_res.costs[0].value == 0.1
+    assert store.best("unknown", task.target) == (None, None)
+    assert len(store.best_records()) == 1
+
+    # the index is reloaded and the store is readable through the generic record APIs
+    store = auto_scheduler.RecordStore(store_file)
+    assert len(store) == 4
+    costs = [res.costs[0].value for _, res in auto_scheduler.load_records(store_file)]
+    assert np.allclose(costs, [0.3, 0.1, 0.05, 0.2])
+    _, best_res = auto_scheduler.load_best_record(store_file, task.workload_key, task.target)
+    assert best_res.costs[0].value == 0.1
+
+
+
+def test_load_best_record_store_matches_log():
+    inputs, results = [], []
+    for i, target in enumerate(["llvm", "llvm -mcpu=core-avx2", "llvm -mcpu=skylake-avx512"]):
+        task = auto_scheduler.SearchTask(
+            func=matmul_auto_scheduler_test, args=(512, 512, 512), target=target
+        )
+        inputs += [auto_scheduler.measure.MeasureInput(task, task.compute_dag.init_state)] * 2
+        results += [
+            auto_scheduler.measure.MeasureResult([0.3 - 0.1 * i], 0, "", 0.2, 1),
+            auto_scheduler.measure.MeasureResult([0.01], 2, "", 0.2, 1),
+        ]
+
+    tmpdir = tvm.contrib.utils.tempdir()
+    log_file = tmpdir.relpath("records.json")
+    store_file = tmpdir.relpath("records.bin")
+    auto_scheduler.save_records(log_file, inputs, results)
+    auto_scheduler.convert_records_to_store(log_file, store_file)
+
+    # the target only has to match by kind, so the best record comes from another target string
+    workload_key = inputs[0].task.workload_key
+    for target in [None, tvm.target.Target("llvm"), tvm.target.Target("llvm -mcpu=znver2")]:
+        for key in [None, workload_key]:
+            _, log_res = auto_scheduler.load_best_record(log_file, key, target)
+            _, store_res = auto_scheduler.load_best_record(store_file, key, target)
+            assert log_res.costs[0].value == store_res.costs[0].value == 0.1
+    assert auto_scheduler.load_best_record(store_file, "unknown", None) == (None, None)
+    assert auto_scheduler.load_best_record(store_file, None, tvm.target.Target("cuda")) == (
+        None,
+        None,
+    )
+
+def test_pipelined_measure():
+    if not tvm.testing.device_enabled("llvm"):
+        return
+
+    task = auto_scheduler.SearchTask(
+        func=matmul_auto_scheduler_test, args=(64, 64, 64), target="llvm"
+    )
+
+    # Pipelining is meant for runners that do not measure on the building machine
+    measure_ctx = auto_scheduler.LocalRPCMeasureContext(timeout=60)
+    with tempfile.NamedTemporaryFile() as fp:
+        log_file = fp.name
+
+        tuning_options = auto_scheduler.TuningOptions(
+            num_measure_trials=4,
+            num_measures_per_round=2,
+            runner=measure_ctx.runner,
+            measure_callbacks=[auto_scheduler.RecordToFile(log_file)],
+            pipelined_measurement=True,
+            verbose=0,
+        )
+        assert tuning_options.pipelined_measurement
+        task.tune(tuning_options, search_policy=auto_scheduler.SketchPolicy(task, verbose=0))
+
+        inputs, results = auto_scheduler.RecordReader(log_file).read_lines()
+        assert len(inputs) == 4
+        assert all(res.error_no == 0 for res in results)
+    del measure_ctx
+
+
 def test_workload_dis_factor():
     calc = auto_scheduler.utils.calc_workload_dis_factor
     decode = auto_scheduler.utils.decode_workload_key
@@ -257,6 +357,49 @@ def test_measure_local_builder_runner():
         assert mress[0].error_no == 0
 
 
+def test_measure_local_runner_adaptive():
+    if not tvm.testing.device_enabled("llvm"):
+        return
+
+    task = auto_scheduler.SearchTask(
+        func=matmul_auto_scheduler_test, args=(128, 128, 128), target="llvm"
+    )
+    minp = auto_scheduler.MeasureInput(task, task.compute_dag.init_state)
+    local_builder = auto_scheduler.LocalBuilder()
+    local_runner = auto_scheduler.LocalRunner(
+        timeout=60, repeat=2, min_repeat_ms=10, adaptive=True, max_repeat=6
+    )
+
+    for _ in range(2):
+        bress = local_builder.build([minp, minp])
+        mress = local_runner.run([minp, minp], bress)
+        for res in mress:
+            assert res.error_no == 0
+            assert 2 <= len(res.costs) <= 6
+            assert res.confidence_interval >= 0
+
+
+def test_measure_local_builder_runner_persistent_workers():
+    if not tvm.testing.device_enabled("llvm"):
+        return
+
+    task = auto_scheduler.SearchTask(
+        func=matmul_auto_scheduler_test, args=(128, 128, 128), target="llvm"
+    )
+    minp = auto_scheduler.MeasureInput(task, task.compute_dag.init_state)
+    local_builder = auto_scheduler.LocalBuilder(n_parallel=2, persistent_workers=True)
+    local_runner = auto_scheduler.LocalRunner(timeout=60, persistent_workers=True)
+
+    # The second batch reuses the worker processes started by the first one
+    for _ in range(2):
+        bress = local_builder.build([minp, minp, minp])
+        assert all(res.error_no == 0 for res in bress)
+        mress = local_runner.run([minp, minp, minp], bress)
+        assert all(res.error_no == 0 for res in mress)
+
+    auto_scheduler.measure.shutdown_persistent_workers()
+
+
 def test_dag_measure_local_builder_runner():
     if not tvm.testing.device_enabled("llvm"):
         return
@@ -420,8 +563,13 @@ if __name__ == "__main__":
     test_record_follow_split_follow_fused_split()
     test_record_pragma_storage_align_rfactor()
     test_recover_measure_input()
+    test_record_store()
+    test_load_best_record_store_matches_log()
+    test_pipelined_measure()
     test_workload_dis_factor()
     test_measure_local_builder_runner()
+    test_measure_local_runner_adaptive()
+    test_measure_local_builder_runner_persistent_workers()
     test_dag_measure_local_builder_runner()
     test_measure_local_builder_rpc_runner()
     test_measure_target_host()
@@ -17,6 +17,7 @@
 
 """Test search policy"""
 
+import json
 import random
 import multiprocessing
 import numpy as np
@@ -209,6 +210,63 @@ def test_sketch_search_policy_custom_sketch():
     )
 
 
+def _steps_without_split_factors(inp, res):
+    # The record of a state is [stages, steps]; a split step is ["SP", stage, iter, extent,
+    # lengths, inner_to_outer], whose extent and lengths are adapted by the transfer.
+    steps = json.loads(auto_scheduler.measure_record.dump_record_to_string(inp, res))["i"][1][1]
+    return json.dumps([step[:3] + step[5:] if step[0] == "SP" else step for step in steps])
+
+
+@tvm.testing.requires_llvm
+def test_sketch_search_policy_transfer_states():
+    with tempfile.NamedTemporaryFile() as fp:
+        src_log_file = fp.name
+        src_task = auto_scheduler.SearchTask(
+            func=matmul_auto_scheduler_test, args=(64, 64, 64), target="llvm"
+        )
+        tuning_options = auto_scheduler.TuningOptions(
+            num_measure_trials=4,
+            num_measures_per_round=2,
+            measure_callbacks=[auto_scheduler.RecordToFile(src_log_file)],
+            verbose=0,
+        )
+        src_task.tune(tuning_options, auto_scheduler.SketchPolicy(src_task, verbose=0))
+        src_inputs, src_results = auto_scheduler.RecordReader(src_log_file).read_lines()
+        src_steps = set(
+            _steps_without_split_factors(inp, res) for inp, res in zip(src_inputs, src_results)
+        )
+
+        with tempfile.NamedTemporaryFile() as fp2:
+            dst_log_file = fp2.name
+            dst_task = auto_scheduler.SearchTask(
+                func=matmul_auto_scheduler_test, args=(96, 128, 48), target="llvm"
+            )
+            search_policy = auto_scheduler.SketchPolicy(
+                dst_task,
+                verbose=0,
+                init_search_callbacks=[
+                    auto_scheduler.PreloadTransferStates(src_log_file, max_states=2)
+                ],
+            )
+            tuning_options = auto_scheduler.TuningOptions(
+                num_measure_trials=2,
+                num_measures_per_round=2,
+                measure_callbacks=[auto_scheduler.RecordToFile(dst_log_file)],
+                verbose=0,
+            )
+            dst_task.tune(tuning_options, search_policy)
+
+            # The first round measures the transferred states: the steps of the source
+            # records with split factors adapted to the new extents.
+            dst_inputs, dst_results = auto_scheduler.RecordReader(dst_log_file).read_lines()
+            assert len(dst_inputs) == 2
+            for inp, res in zip(dst_inputs, dst_results):
+                assert res.error_no == 0
+                assert _steps_without_split_factors(inp, res) in src_steps
+            sch, args = dst_task.apply_best(dst_log_file)
+            tvm.build(sch, args, "llvm")
+
+
 if __name__ == "__main__":
     test_workload_registry_empty_policy()
     test_sketch_search_policy_basic()
@@ -218,3 +276,4 @@ if __name__ == "__main__":
     test_sketch_search_policy_cuda_xgbmodel_rpc_runner()
     test_sketch_search_policy_zero_rank()
     test_sketch_search_policy_custom_sketch()
+    test_sketch_search_policy_transfer_states()
@@ -14,6 +14,7 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import numpy as np
 import tvm
 import pytest
 from tvm import te
@@ -154,6 +155,48 @@ def test_pass_config():
         cfg = tvm.transform.PassContext(config={"tir.UnrollLoop": 1})
 
 
+def test_saveload_binary():
+    x = tvm.tir.const(1, "int32")
+    y = tvm.tir.const(10, "int32")
+    z = tvm.tir.Add(x, y)
+    smap = tvm.runtime.convert({"z": z, "x": x})
+    arr = tvm.ir.load_binary(tvm.ir.save_binary(tvm.runtime.convert([smap])))
+    assert len(arr) == 1
+    assert arr[0]["z"].a == arr[0]["x"]
+    tvm.ir.assert_structural_equal(arr, [smap], map_free_vars=True)
+
+    A = te.placeholder((2, 10), name="A")
+    k = te.reduce_axis((0, 10), "k")
+    B = te.compute((2,), lambda i: te.sum(A[i, k], axis=k), name="B")
+    BB = tvm.ir.load_binary(tvm.ir.save_binary(B))
+    assert BB.op.body[0].combiner is not None
+    assert BB.op.name == "B"
+
+    s1 = tvm.runtime.String("xy\x01z")
+    tvm.ir.assert_structural_equal(s1, tvm.ir.load_binary(tvm.ir.save_binary(s1)))
+
+
+def test_saveload_binary_ndarray():
+    data = np.random.uniform(size=(3, 17)).astype("float32")
+    c = tvm.relay.const(data)
+    func = tvm.relay.Function([], tvm.relay.add(c, c))
+    blob = tvm.ir.save_binary(func)
+    # raw payload instead of base64
+    assert len(blob) < len(tvm.ir.save_json(func))
+    func2 = tvm.ir.load_binary(blob)
+    tvm.ir.assert_structural_equal(func, func2)
+    np.testing.assert_equal(func2.body.args[0].data.numpy(), data)
+
+
+def test_load_binary_fail_version():
+    blob = bytearray(tvm.ir.save_binary(tvm.tir.const(1, "int32")))
+    # the binary format has no upgrader, a blob of another version is rejected
+    pos = blob.index(tvm.__version__.encode())
+    blob[pos] = ord("9") if blob[pos] != ord("9") else ord("8")
+    with pytest.raises(tvm.TVMError):
+        tvm.ir.load_binary(blob)
+
+
 def test_dict():
     x = tvm.tir.const(1)  # a class that has Python-defined methods
     # instances should see the full class dict
@@ -171,3 +214,6 @@ if __name__ == "__main__":
     test_dict()
     test_infinity_value()
     test_minmax_value()
+    test_saveload_binary()
+    test_saveload_binary_ndarray()
+    test_load_binary_fail_version()
@@ -14,6 +14,7 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import pytest
 import tvm
 import tvm.testing
 from tvm import te, runtime
@@ -139,6 +140,37 @@ def test_load_unexpected_params():
     rt_mod.load_params(runtime.save_param_dict(new_params))
 
 
+@tvm.testing.requires_llvm
+def test_graph_trusted_entry():
+    x = relay.var("x", shape=(1, 10))
+    func = relay.Function([x], relay.add(x, relay.const(1.0)))
+    with tvm.transform.PassContext(opt_level=3, config={"tir.emit_trusted_entry": True}):
+        graph_module = relay.build(func, target="llvm")
+    # Every kernel of the graph has a trusted entry, which the executor calls
+    lib = graph_module.get_lib()
+    for node in json.loads(graph_module.get_graph_json())["nodes"]:
+        if node["op"] == "tvm_op":
+            assert lib.get_function(node["attrs"]["func_name"] + "__trusted", query_imports=True)
+
+    rt_mod = graph_executor.create(graph_module.get_graph_json(), lib, tvm.cpu(0))
+    set_input_zero_copy = rt_mod.module["set_input_zero_copy"]
+    a = np.random.uniform(size=(1, 10)).astype("float32")
+    set_input_zero_copy("x", tvm.nd.array(a))
+    rt_mod.run()
+    np.testing.assert_equal(rt_mod.get_output(0).numpy(), a + 1)
+
+    # The trusted entry does not check its arguments, so the executor rejects
+    # tensors that do not match the graph
+    with pytest.raises(tvm.TVMError):
+        set_input_zero_copy("x", tvm.nd.array(a.astype("float64")))
+    offset_input = tvm.nd.array(a)
+    offset_input.handle.contents.byte_offset = 4
+    with pytest.raises(tvm.TVMError):
+        set_input_zero_copy("x", offset_input)
+    offset_input.handle.contents.byte_offset = 0
+
+
 if __name__ == "__main__":
     test_graph_simple()
     test_load_unexpected_params()
+    test_graph_trusted_entry()
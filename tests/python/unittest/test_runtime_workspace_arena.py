@@ -0,0 +1,83 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import numpy as np
+import tvm
+import tvm.testing
+from tvm import te
+
+
+def _workspace_stats(key):
+    return tvm.get_global_func("runtime.CPUWorkspaceStats")(key)
+
+
+def _build_with_workspace(n):
+    A = te.placeholder((n,), name="A")
+    B = te.compute((n,), lambda i: A[i] + 1, name="B")
+    C = te.compute((n,), lambda i: B[i] * 2, name="C")
+    s = te.create_schedule(C.op)
+    return tvm.build(s, [A, C], target="llvm")
+
+
+@tvm.testing.requires_llvm
+def test_workspace_arena_steady_state():
+    n = 4096
+    f = _build_with_workspace(n)
+    dev = tvm.cpu(0)
+    a = tvm.nd.array(np.random.uniform(size=n).astype("float32"), dev)
+    c = tvm.nd.empty((n,), "float32", dev)
+
+    # The first runs warm up the arena of this thread
+    for _ in range(2):
+        f(a, c)
+    tvm.testing.assert_allclose(c.numpy(), (a.numpy() + 1) * 2, rtol=1e-5)
+
+    arena_alloc = _workspace_stats("arena_alloc")
+    arena_grow = _workspace_stats("arena_grow")
+    pool_alloc = _workspace_stats("pool_alloc")
+    for _ in range(10):
+        f(a, c)
+    # The workspace of B comes from the arena, without any new system allocation
+    assert _workspace_stats("arena_alloc") - arena_alloc == 10
+    assert _workspace_stats("arena_grow") == arena_grow
+    assert _workspace_stats("pool_alloc") == pool_alloc
+    tvm.testing.assert_allclose(c.numpy(), (a.numpy() + 1) * 2, rtol=1e-5)
+
+
+@tvm.testing.requires_llvm
+def test_workspace_arena_oversize():
+    # A workspace larger than the arena limit (64MB) falls back to the pool. Only the
+    # intermediate B is that large: it broadcasts the small input, and C reduces it.
+    m = 1024
+    n = (64 << 20) // 4 + m
+    A = te.placeholder((m,), name="A")
+    B = te.compute((n,), lambda i: A[i % m] + 1, name="B")
+    k = te.reduce_axis((0, n // m), name="k")
+    C = te.compute((m,), lambda j: te.sum(B[j * (n // m) + k], axis=k), name="C")
+    s = te.create_schedule(C.op)
+    f = tvm.build(s, [A, C], target="llvm")
+
+    dev = tvm.cpu(0)
+    a = tvm.nd.array(np.ones(m, dtype="float32"), dev)
+    c = tvm.nd.empty((m,), "float32", dev)
+    pool_alloc = _workspace_stats("pool_alloc")
+    f(a, c)
+    assert _workspace_stats("pool_alloc") == pool_alloc + 1
+    tvm.testing.assert_allclose(c.numpy(), np.full(m, 2 * (n // m), dtype="float32"))
+
+if __name__ == "__main__":
+    test_workspace_arena_steady_state()
+    test_workspace_arena_oversize()
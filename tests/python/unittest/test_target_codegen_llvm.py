@@ -195,6 +195,33 @@ def test_llvm_vadd_pipeline():
     check_llvm(512, 2)
 
 
+@tvm.testing.requires_llvm
+def test_llvm_vectorize_predicated_tail():
+    def check_llvm(n, partition):
+        A = te.placeholder((n,), name="A")
+        B = te.compute((n,), lambda i: A[i] * 2.0 + 1.0, name="B")
+        s = te.create_schedule(B.op)
+        _, xi = s[B].split(B.op.axis[0], factor=8)
+        s[B].vectorize(xi)
+        config = {
+            "tir.enable_vectorize_predication": True,
+            "tir.LoopPartition": {"partition_const_loop": partition},
+        }
+        with tvm.transform.PassContext(config=config):
+            f = tvm.build(s, [A, B], "llvm")
+        if not partition:
+            assert "llvm.masked.store" in f.get_source("ll")
+        dev = tvm.cpu(0)
+        a = tvm.nd.array(np.random.uniform(size=n).astype(A.dtype), dev)
+        b = tvm.nd.empty((n,), B.dtype, dev)
+        f(a, b)
+        tvm.testing.assert_allclose(b.numpy(), a.numpy() * 2.0 + 1.0, rtol=1e-5)
+
+    for n in [3, 17, 31]:
+        check_llvm(n, False)
+        check_llvm(n, True)
+
+
 @tvm.testing.requires_llvm
 def test_llvm_madd_pipeline():
     def check_llvm(nn, base, stride):
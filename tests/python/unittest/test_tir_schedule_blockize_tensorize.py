@@ -0,0 +1,246 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-function-docstring,missing-module-docstring
+import pytest
+import tvm
+from tvm import tir
+from tvm.script import ty
+
+# pylint: disable=no-member,invalid-name,unused-variable
+
+
+
+@tvm.script.tir
+def elementwise(a: ty.handle, b: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128))
+    B = tir.match_buffer(b, (128, 128))
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "B") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            B[vi, vj] = A[vi, vj] * 2.0
+
+
+@tvm.script.tir
+def elementwise_blockized(a: ty.handle, b: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128))
+    B = tir.match_buffer(b, (128, 128))
+    for i in tir.serial(0, 128):
+        with tir.block([128], "B_o") as [vio]:
+            tir.bind(vio, i)
+            tir.reads([A[vio : vio + 1, 0:128]])
+            tir.writes([B[vio : vio + 1, 0:128]])
+            for j in tir.serial(0, 128):
+                with tir.block([128], "B") as [vj]:
+                    tir.bind(vj, j)
+                    B[vio, vj] = A[vio, vj] * 2.0
+
+
+@tvm.script.tir
+def elementwise_tiled(a: ty.handle, b: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128))
+    B = tir.match_buffer(b, (128, 128))
+    for i0, j0, i1, j1 in tir.grid(8, 8, 16, 16):
+        with tir.block([128, 128], "B") as [vi, vj]:
+            tir.bind(vi, i0 * 16 + i1)
+            tir.bind(vj, j0 * 16 + j1)
+            B[vi, vj] = A[vi, vj] * 2.0
+
+
+@tvm.script.tir
+def elementwise_tiled_blockized(a: ty.handle, b: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128))
+    B = tir.match_buffer(b, (128, 128))
+    for i0, j0 in tir.grid(8, 8):
+        with tir.block([8, 8], "B_o") as [vio, vjo]:
+            tir.bind(vio, i0)
+            tir.bind(vjo, j0)
+            tir.reads([A[vio * 16 : vio * 16 + 16, vjo * 16 : vjo * 16 + 16]])
+            tir.writes([B[vio * 16 : vio * 16 + 16, vjo * 16 : vjo * 16 + 16]])
+            for i1, j1 in tir.grid(16, 16):
+                with tir.block([16, 16], "B") as [vi, vj]:
+                    tir.bind(vi, i1)
+                    tir.bind(vj, j1)
+                    B[vio * 16 + vi, vjo * 16 + vj] = A[vio * 16 + vi, vjo * 16 + vj] * 2.0
+
+
+@tvm.script.tir
+def two_blocks_under_loop(a: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128))
+    B = tir.alloc_buffer((128, 128))
+    C = tir.match_buffer(c, (128, 128))
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "B") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            B[vi, vj] = A[vi, vj] * 2.0
+        with tir.block([128, 128], "C") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            C[vi, vj] = B[vi, vj] + 1.0
+
+
+@tvm.script.tir
+def matmul(a: ty.handle, b: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128))
+    B = tir.match_buffer(b, (128, 128))
+    C = tir.match_buffer(c, (128, 128))
+    for i, j, k in tir.grid(128, 128, 128):
+        with tir.block([128, 128, tir.reduce_axis(0, 128)], "update") as [vi, vj, vk]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            tir.bind(vk, k)
+            with tir.init():
+                C[vi, vj] = 0.0
+            C[vi, vj] = C[vi, vj] + A[vi, vk] * B[vj, vk]
+
+
+@tvm.script.tir
+def mma_desc(a: ty.handle, b: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (16, 16), offset_factor=1)
+    B = tir.match_buffer(b, (16, 16), offset_factor=1)
+    C = tir.match_buffer(c, (16, 16), offset_factor=1)
+    for i, j, k in tir.grid(16, 16, 16):
+        with tir.block([16, 16, tir.reduce_axis(0, 16)], "update") as [vi, vj, vk]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            tir.bind(vk, k)
+            C[vi, vj] = C[vi, vj] + A[vi, vk] * B[vj, vk]
+
+
+@tvm.script.tir
+def mma_impl(a: ty.handle, b: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (16, 16), offset_factor=1)
+    B = tir.match_buffer(b, (16, 16), offset_factor=1)
+    C = tir.match_buffer(c, (16, 16), offset_factor=1)
+    tir.evaluate(
+        tir.call_extern(
+            "mma_16x16x16",
+            C.data,
+            C.elem_offset,
+            A.data,
+            A.elem_offset,
+            B.data,
+            B.elem_offset,
+            dtype="int32",
+        )
+    )
+
+
+@tvm.script.tir
+def mma_impl_fixed_offset(a: ty.handle, b: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (16, 16))
+    B = tir.match_buffer(b, (16, 16))
+    C = tir.match_buffer(c, (16, 16))
+    tir.evaluate(
+        tir.call_extern(
+            "mma_16x16x16",
+            C.data,
+            C.elem_offset,
+            A.data,
+            A.elem_offset,
+            B.data,
+            B.elem_offset,
+            dtype="int32",
+        )
+    )
+
+
+# pylint: enable=no-member,invalid-name,unused-variable
+
+tir.TensorIntrin.register("test.mma_16x16x16", mma_desc, mma_impl)
+tir.TensorIntrin.register("test.mma_16x16x16_fixed_offset", mma_desc, mma_impl_fixed_offset)
+
+
+def _tile_matmul(sch):
+    i, j, k = sch.get_loops(sch.get_block("update"))
+    i0, i1 = sch.split(i, factors=[None, 16])
+    j0, j1 = sch.split(j, factors=[None, 16])
+    k0, k1 = sch.split(k, factors=[None, 16])
+    sch.reorder(i0, j0, k0, i1, j1, k1)
+    return i1, j1
+
+
+def test_blockize():
+    sch = tir.Schedule(elementwise, debug_mode=True)
+    _, j = sch.get_loops(sch.get_block("B"))
+    block = sch.blockize(j)
+    tvm.ir.assert_structural_equal(elementwise_blockized, sch.mod["main"])
+    assert sch.get(block).name_hint == "B_o"
+
+
+def test_blockize_tiled():
+    sch = tir.Schedule(elementwise_tiled, debug_mode=True)
+    _, _, i1, _ = sch.get_loops(sch.get_block("B"))
+    sch.blockize(i1)
+    tvm.ir.assert_structural_equal(elementwise_tiled_blockized, sch.mod["main"])
+
+
+def test_blockize_fail_multiple_blocks():
+    sch = tir.Schedule(two_blocks_under_loop, debug_mode=True)
+    _, j = sch.get_loops(sch.get_block("B"))
+    with pytest.raises(tvm.tir.ScheduleError):
+        sch.blockize(j)
+
+
+def test_tensorize_matmul():
+    sch = tir.Schedule(matmul, debug_mode=True)
+    i1, _ = _tile_matmul(sch)
+    sch.tensorize(i1, "test.mma_16x16x16")
+    func = sch.mod["main"]
+    block = sch.get(sch.get_block("update_o"))
+    assert isinstance(block.body, tvm.tir.Evaluate)
+    call = block.body.value
+    assert call.args[0].value == "mma_16x16x16"
+    C = func.buffer_map[func.params[2]]
+    A = func.buffer_map[func.params[0]]
+    assert call.args[1].same_as(C.data)
+    assert call.args[3].same_as(A.data)
+    assert block.init is not None
+
+
+def test_tensorize_fail_mismatch():
+    sch = tir.Schedule(matmul, debug_mode=True)
+    _, j1 = _tile_matmul(sch)
+    with pytest.raises(tvm.tir.ScheduleError):
+        sch.tensorize(j1, "test.mma_16x16x16")
+
+
+def test_tensorize_fail_fixed_offset():
+    sch = tir.Schedule(matmul, debug_mode=True)
+    i1, _ = _tile_matmul(sch)
+    # The buffers of the implementation are fixed at offset 0, but the tiles are not
+    with pytest.raises(ValueError):
+        sch.tensorize(i1, "test.mma_16x16x16_fixed_offset")
+
+
+def test_tensor_intrin_registry():
+    intrin = tir.TensorIntrin.get("test.mma_16x16x16")
+    assert intrin.desc.same_as(mma_desc)
+    assert intrin.impl.same_as(mma_impl)
+    with pytest.raises(tvm.TVMError):
+        tir.TensorIntrin.register("test.mma_16x16x16", mma_desc, mma_impl)
+
+
+if __name__ == "__main__":
+    test_blockize()
+    test_blockize_tiled()
+    test_blockize_fail_multiple_blocks()
+    test_tensorize_matmul()
+    test_tensorize_fail_mismatch()
+    test_tensorize_fail_fixed_offset()
+    test_tensor_intrin_registry()
@@ -0,0 +1,202 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-function-docstring,missing-module-docstring
+import pytest
+import tvm
+from tvm import tir
+from tvm.script import ty
+
+# pylint: disable=no-member,invalid-name,unused-variable
+
+
+
+@tvm.script.tir
+def elementwise(a: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128))
+    B = tir.alloc_buffer((128, 128))
+    C = tir.match_buffer(c, (128, 128))
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "B") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            B[vi, vj] = A[vi, vj] * 2.0
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "C") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            C[vi, vj] = B[vi, vj] + 1.0
+
+
+@tvm.script.tir
+def cache_read_elementwise(a: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128))
+    B = tir.alloc_buffer((128, 128))
+    B_local = tir.alloc_buffer((128, 128), scope="local")
+    C = tir.match_buffer(c, (128, 128))
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "B") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            B[vi, vj] = A[vi, vj] * 2.0
+    for ax0, ax1 in tir.grid(128, 128):
+        with tir.block([128, 128], "B_local") as [v0, v1]:
+            tir.bind(v0, ax0)
+            tir.bind(v1, ax1)
+            B_local[v0, v1] = B[v0, v1]
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "C") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            C[vi, vj] = B_local[vi, vj] + 1.0
+
+
+@tvm.script.tir
+def cache_read_input(a: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128))
+    B = tir.alloc_buffer((128, 128))
+    A_shared = tir.alloc_buffer((128, 128), scope="shared")
+    C = tir.match_buffer(c, (128, 128))
+    for ax0, ax1 in tir.grid(128, 128):
+        with tir.block([128, 128], "A_shared") as [v0, v1]:
+            tir.bind(v0, ax0)
+            tir.bind(v1, ax1)
+            A_shared[v0, v1] = A[v0, v1]
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "B") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            B[vi, vj] = A_shared[vi, vj] * 2.0
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "C") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            C[vi, vj] = B[vi, vj] + 1.0
+
+
+@tvm.script.tir
+def cache_write_elementwise(a: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128))
+    B = tir.alloc_buffer((128, 128))
+    C = tir.match_buffer(c, (128, 128))
+    C_local = tir.alloc_buffer((128, 128), scope="local")
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "B") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            B[vi, vj] = A[vi, vj] * 2.0
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "C") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            C_local[vi, vj] = B[vi, vj] + 1.0
+    for ax0, ax1 in tir.grid(128, 128):
+        with tir.block([128, 128], "C_local") as [v0, v1]:
+            tir.bind(v0, ax0)
+            tir.bind(v1, ax1)
+            C[v0, v1] = C_local[v0, v1]
+
+
+@tvm.script.tir
+def cache_read_then_compute_at(a: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128))
+    B = tir.alloc_buffer((128, 128))
+    B_local = tir.alloc_buffer((128, 128), scope="local")
+    C = tir.match_buffer(c, (128, 128))
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "B") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            B[vi, vj] = A[vi, vj] * 2.0
+    for i in tir.serial(0, 128):
+        for ax0 in tir.serial(0, 128):
+            with tir.block([128, 128], "B_local") as [v0, v1]:
+                tir.bind(v0, i)
+                tir.bind(v1, ax0)
+                B_local[v0, v1] = B[v0, v1]
+        for j in tir.serial(0, 128):
+            with tir.block([128, 128], "C") as [vi, vj]:
+                tir.bind(vi, i)
+                tir.bind(vj, j)
+                C[vi, vj] = B_local[vi, vj] + 1.0
+
+
+@tvm.script.tir
+def multiple_writers(a: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128))
+    B = tir.alloc_buffer((128, 128))
+    C = tir.match_buffer(c, (128, 128))
+    with tir.block([128, 128], "B0") as [vi, vj]:
+        B[vi, vj] = A[vi, vj]
+    with tir.block([128, 128], "B1") as [vi, vj]:
+        B[vi, vj] = B[vi, vj] * 2.0
+    with tir.block([128, 128], "C") as [vi, vj]:
+        C[vi, vj] = B[vi, vj] + 1.0
+
+
+# pylint: enable=no-member,invalid-name,unused-variable
+
+
+def test_cache_read():
+    sch = tir.Schedule(elementwise, debug_mode=True)
+    block_c = sch.get_block("C")
+    cached = sch.cache_read(block_c, 0, "local")
+    tvm.ir.assert_structural_equal(cache_read_elementwise, sch.mod["main"])
+    assert sch.get(cached).name_hint == "B_local"
+    assert sch.get(block_c).reads[0].buffer.name == "B_local"
+
+
+def test_cache_read_input():
+    sch = tir.Schedule(elementwise, debug_mode=True)
+    sch.cache_read(sch.get_block("B"), 0, "shared")
+    tvm.ir.assert_structural_equal(cache_read_input, sch.mod["main"])
+
+
+def test_cache_write():
+    sch = tir.Schedule(elementwise, debug_mode=True)
+    cached = sch.cache_write(sch.get_block("C"), 0, "local")
+    tvm.ir.assert_structural_equal(cache_write_elementwise, sch.mod["main"])
+    assert sch.get(cached).name_hint == "C_local"
+
+
+def test_cache_read_then_compute_at():
+    sch = tir.Schedule(elementwise, debug_mode=True)
+    block_c = sch.get_block("C")
+    cached = sch.cache_read(block_c, 0, "local")
+    loop, _ = sch.get_loops(block_c)
+    sch.compute_at(cached, loop)
+    tvm.ir.assert_structural_equal(cache_read_then_compute_at, sch.mod["main"])
+
+
+def test_cache_read_fail_multiple_writers():
+    sch = tir.Schedule(multiple_writers, debug_mode=True)
+    with pytest.raises(tvm.tir.ScheduleError):
+        sch.cache_read(sch.get_block("C"), 0, "local")
+
+
+def test_cache_write_fail_multiple_writers():
+    sch = tir.Schedule(multiple_writers, debug_mode=True)
+    with pytest.raises(tvm.tir.ScheduleError):
+        sch.cache_write(sch.get_block("B0"), 0, "local")
+
+
+if __name__ == "__main__":
+    test_cache_read()
+    test_cache_read_input()
+    test_cache_write()
+    test_cache_read_then_compute_at()
+    test_cache_read_fail_multiple_writers()
+    test_cache_write_fail_multiple_writers()
@@ -0,0 +1,335 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-function-docstring,missing-module-docstring
+import pytest
+import tvm
+from tvm import tir
+from tvm.script import ty
+
+# pylint: disable=no-member,invalid-name,unused-variable
+
+
+
+@tvm.script.tir
+def two_elementwise(a: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128), "float32")
+    B = tir.alloc_buffer((128, 128), "float32")
+    C = tir.match_buffer(c, (128, 128), "float32")
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "B") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            B[vi, vj] = A[vi, vj] * 2.0
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "C") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            C[vi, vj] = B[vi, vj] + 1.0
+
+
+@tvm.script.tir
+def two_elementwise_after_compute_at(a: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128), "float32")
+    B = tir.alloc_buffer((128, 128), "float32")
+    C = tir.match_buffer(c, (128, 128), "float32")
+    for i in tir.serial(0, 128):
+        for ax0 in tir.serial(0, 128):
+            with tir.block([128, 128], "B") as [vi, vj]:
+                tir.bind(vi, i)
+                tir.bind(vj, ax0)
+                B[vi, vj] = A[vi, vj] * 2.0
+        for j in tir.serial(0, 128):
+            with tir.block([128, 128], "C") as [vi, vj]:
+                tir.bind(vi, i)
+                tir.bind(vj, j)
+                C[vi, vj] = B[vi, vj] + 1.0
+
+
+@tvm.script.tir
+def two_elementwise_after_reverse_compute_at(a: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128), "float32")
+    B = tir.alloc_buffer((128, 128), "float32")
+    C = tir.match_buffer(c, (128, 128), "float32")
+    for i in tir.serial(0, 128):
+        for j in tir.serial(0, 128):
+            with tir.block([128, 128], "B") as [vi, vj]:
+                tir.bind(vi, i)
+                tir.bind(vj, j)
+                B[vi, vj] = A[vi, vj] * 2.0
+        for ax0 in tir.serial(0, 128):
+            with tir.block([128, 128], "C") as [vi, vj]:
+                tir.bind(vi, i)
+                tir.bind(vj, ax0)
+                C[vi, vj] = B[vi, vj] + 1.0
+
+
+@tvm.script.tir
+def two_elementwise_fused(a: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128), "float32")
+    B = tir.alloc_buffer((128, 128), "float32")
+    C = tir.match_buffer(c, (128, 128), "float32")
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "B") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            B[vi, vj] = A[vi, vj] * 2.0
+        with tir.block([128, 128], "C") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            C[vi, vj] = B[vi, vj] + 1.0
+
+
+@tvm.script.tir
+def two_elementwise_fused_unit_loops(a: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128), "float32")
+    B = tir.alloc_buffer((128, 128), "float32")
+    C = tir.match_buffer(c, (128, 128), "float32")
+    for i, j in tir.grid(128, 128):
+        for ax0, ax1 in tir.grid(1, 1):
+            with tir.block([128, 128], "B") as [vi, vj]:
+                tir.bind(vi, i + ax0)
+                tir.bind(vj, j + ax1)
+                B[vi, vj] = A[vi, vj] * 2.0
+        with tir.block([128, 128], "C") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            C[vi, vj] = B[vi, vj] + 1.0
+
+
+@tvm.script.tir
+def tiled_consumer(a: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128), "float32")
+    B = tir.alloc_buffer((128, 128), "float32")
+    C = tir.match_buffer(c, (128, 128), "float32")
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "B") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            B[vi, vj] = A[vi, vj] * 2.0
+    for i0, j0, i1, j1 in tir.grid(8, 8, 16, 16):
+        with tir.block([128, 128], "C") as [vi, vj]:
+            tir.bind(vi, i0 * 16 + i1)
+            tir.bind(vj, j0 * 16 + j1)
+            C[vi, vj] = B[vi, vj] + 1.0
+
+
+@tvm.script.tir
+def tiled_consumer_after_compute_at(a: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128), "float32")
+    B = tir.alloc_buffer((128, 128), "float32")
+    C = tir.match_buffer(c, (128, 128), "float32")
+    for i0, j0 in tir.grid(8, 8):
+        for ax0, ax1 in tir.grid(16, 16):
+            with tir.block([128, 128], "B") as [vi, vj]:
+                tir.bind(vi, i0 * 16 + ax0)
+                tir.bind(vj, j0 * 16 + ax1)
+                B[vi, vj] = A[vi, vj] * 2.0
+        for i1, j1 in tir.grid(16, 16):
+            with tir.block([128, 128], "C") as [vi, vj]:
+                tir.bind(vi, i0 * 16 + i1)
+                tir.bind(vj, j0 * 16 + j1)
+                C[vi, vj] = B[vi, vj] + 1.0
+
+
+@tvm.script.tir
+def predicated_consumer(a: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128), "float32")
+    B = tir.alloc_buffer((128, 128), "float32")
+    C = tir.match_buffer(c, (128, 128), "float32")
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "B") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            B[vi, vj] = A[vi, vj] * 2.0
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "C") as [vi, vj]:
+            tir.where(j < 100)
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            C[vi, vj] = B[vi, vj] + 1.0
+
+
+@tvm.script.tir
+def predicated_consumer_after_reverse_compute_at(a: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128), "float32")
+    B = tir.alloc_buffer((128, 128), "float32")
+    C = tir.match_buffer(c, (128, 128), "float32")
+    for i in tir.serial(0, 128):
+        for j in tir.serial(0, 128):
+            with tir.block([128, 128], "B") as [vi, vj]:
+                tir.bind(vi, i)
+                tir.bind(vj, j)
+                B[vi, vj] = A[vi, vj] * 2.0
+        for ax0 in tir.serial(0, 128):
+            with tir.block([128, 128], "C") as [vi, vj]:
+                tir.where(ax0 < 100)
+                tir.bind(vi, i)
+                tir.bind(vj, ax0)
+                C[vi, vj] = B[vi, vj] + 1.0
+
+
+# pylint: enable=no-member,invalid-name,unused-variable
+
+
+@tvm.script.tir
+def constant_column_consumer(a: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128), "float32")
+    B = tir.alloc_buffer((128, 128), "float32")
+    C = tir.match_buffer(c, (128, 128), "float32")
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "B") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            B[vi, vj] = A[vi, vj] * 2.0
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "C") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            C[vi, vj] = B[vi, 0] + 1.0
+
+
+@tvm.script.tir
+def constant_column_consumer_after_reverse_compute_at(a: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128), "float32")
+    B = tir.alloc_buffer((128, 128), "float32")
+    C = tir.match_buffer(c, (128, 128), "float32")
+    for i in tir.serial(0, 128):
+        for j in tir.serial(0, 128):
+            with tir.block([128, 128], "B") as [vi, vj]:
+                tir.bind(vi, i)
+                tir.bind(vj, j)
+                B[vi, vj] = A[vi, vj] * 2.0
+        for ax0 in tir.serial(0, 128):
+            with tir.block([128, 128], "C") as [vi, vj]:
+                tir.bind(vi, i)
+                tir.bind(vj, ax0)
+                C[vi, vj] = B[vi, 0] + 1.0
+
+
+@tvm.script.tir
+def constant_row_consumer(a: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128), "float32")
+    B = tir.alloc_buffer((128, 128), "float32")
+    C = tir.match_buffer(c, (128, 128), "float32")
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "B") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            B[vi, vj] = A[vi, vj] * 2.0
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "C") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            C[vi, vj] = B[127, vj] + 1.0
+
+
+def test_compute_at():
+    sch = tir.Schedule(two_elementwise, debug_mode=True)
+    block = sch.get_block("B")
+    loop, _ = sch.get_loops(sch.get_block("C"))
+    sch.compute_at(block, loop, preserve_unit_loops=False)
+    tvm.ir.assert_structural_equal(two_elementwise_after_compute_at, sch.mod["main"])
+
+
+def test_compute_at_innermost():
+    sch = tir.Schedule(two_elementwise, debug_mode=True)
+    _, loop = sch.get_loops(sch.get_block("C"))
+    sch.compute_at(sch.get_block("B"), loop, preserve_unit_loops=False)
+    tvm.ir.assert_structural_equal(two_elementwise_fused, sch.mod["main"])
+
+
+def test_compute_at_preserve_unit_loops():
+    sch = tir.Schedule(two_elementwise, debug_mode=True)
+    _, loop = sch.get_loops(sch.get_block("C"))
+    sch.compute_at(sch.get_block("B"), loop, preserve_unit_loops=True)
+    tvm.ir.assert_structural_equal(two_elementwise_fused_unit_loops, sch.mod["main"])
+
+
+def test_compute_at_tiled_consumer():
+    sch = tir.Schedule(tiled_consumer, debug_mode=True)
+    _, loop, _, _ = sch.get_loops(sch.get_block("C"))
+    sch.compute_at(sch.get_block("B"), loop, preserve_unit_loops=False)
+    tvm.ir.assert_structural_equal(tiled_consumer_after_compute_at, sch.mod["main"])
+
+
+def test_reverse_compute_at():
+    sch = tir.Schedule(two_elementwise, debug_mode=True)
+    block = sch.get_block("C")
+    loop, _ = sch.get_loops(sch.get_block("B"))
+    sch.reverse_compute_at(block, loop, preserve_unit_loops=False)
+    tvm.ir.assert_structural_equal(two_elementwise_after_reverse_compute_at, sch.mod["main"])
+
+
+def test_reverse_compute_at_predicate():
+    sch = tir.Schedule(predicated_consumer, debug_mode=True)
+    loop, _ = sch.get_loops(sch.get_block("B"))
+    sch.reverse_compute_at(sch.get_block("C"), loop, preserve_unit_loops=False)
+    tvm.ir.assert_structural_equal(predicated_consumer_after_reverse_compute_at, sch.mod["main"])
+
+
+def test_reverse_compute_at_constant_index():
+    # Every iteration of the loop produces the whole column 0 the consumer reads
+    sch = tir.Schedule(constant_column_consumer, debug_mode=True)
+    loop, _ = sch.get_loops(sch.get_block("B"))
+    sch.reverse_compute_at(sch.get_block("C"), loop, preserve_unit_loops=False)
+    tvm.ir.assert_structural_equal(
+        constant_column_consumer_after_reverse_compute_at, sch.mod["main"]
+    )
+
+
+def test_reverse_compute_at_fail_constant_index_not_produced():
+    # Row 127 is only produced by the last iteration of the loop
+    sch = tir.Schedule(constant_row_consumer, debug_mode=True)
+    loop, _ = sch.get_loops(sch.get_block("B"))
+    with pytest.raises(tvm.tir.ScheduleError):
+        sch.reverse_compute_at(sch.get_block("C"), loop)
+
+
+def test_compute_at_fail_loop_is_ancestor():
+    sch = tir.Schedule(two_elementwise, debug_mode=True)
+    block = sch.get_block("B")
+    loop, _ = sch.get_loops(block)
+    with pytest.raises(tvm.tir.ScheduleError):
+        sch.compute_at(block, loop)
+
+
+def test_compute_at_fail_consumer_not_under_loop():
+    sch = tir.Schedule(two_elementwise, debug_mode=True)
+    loop, _ = sch.get_loops(sch.get_block("B"))
+    with pytest.raises(tvm.tir.ScheduleError):
+        sch.compute_at(sch.get_block("C"), loop)
+
+
+def test_reverse_compute_at_fail_producer_not_under_loop():
+    sch = tir.Schedule(two_elementwise, debug_mode=True)
+    loop, _ = sch.get_loops(sch.get_block("C"))
+    with pytest.raises(tvm.tir.ScheduleError):
+        sch.reverse_compute_at(sch.get_block("B"), loop)
+
+
+if __name__ == "__main__":
+    test_compute_at()
+    test_compute_at_innermost()
+    test_compute_at_preserve_unit_loops()
+    test_compute_at_tiled_consumer()
+    test_reverse_compute_at()
+    test_reverse_compute_at_predicate()
+    test_reverse_compute_at_constant_index()
+    test_reverse_compute_at_fail_constant_index_not_produced()
+    test_compute_at_fail_loop_is_ancestor()
+    test_compute_at_fail_consumer_not_under_loop()
+    test_reverse_compute_at_fail_producer_not_under_loop()
@@ -0,0 +1,211 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-function-docstring,missing-module-docstring
+import pytest
+import tvm
+from tvm import tir
+from tvm.script import ty
+
+# pylint: disable=no-member,invalid-name,unused-variable
+
+
+
+@tvm.script.tir
+def elementwise(a: ty.handle, b: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128, 128, 128))
+    B = tir.match_buffer(b, (128, 128, 128, 128))
+    with tir.block([128, 128, 128, 128], "B") as [vi, vj, vk, vl]:
+        B[vi, vj, vk, vl] = A[vi, vj, vk, vl] * 2.0
+
+
+@tvm.script.tir
+def elementwise_not_affine(a: ty.handle, b: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128, 128, 128))
+    B = tir.match_buffer(b, (128, 128, 128, 128))
+    for i, j, k, l in tir.grid(128, 128, 128, 11):
+        with tir.block([128, 128, 128, 128], "B") as [vi, vj, vk, vl]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            tir.bind(vk, k)
+            tir.bind(vl, l * l)
+            B[vi, vj, vk, vl] = A[vi, vj, vk, vl] * 2.0
+
+
+@tvm.script.tir
+def elementwise_dependent_loop(a: ty.handle, b: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128, 128, 128))
+    B = tir.match_buffer(b, (128, 128, 128, 128))
+    for i in tir.serial(0, 128):
+        for j, k, l in tir.grid(128, i, 128):
+            with tir.block([128, 128, i, 128], "B") as [vi, vj, vk, vl]:
+                B[vi, vj, vk, vl] = A[vi, vj, vk, vl] * 2.0
+
+
+@tvm.script.tir
+def elementwise_non_single_branch(a: ty.handle, b: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128, 128))
+    C = tir.alloc_buffer((128, 128, 128))
+    B = tir.match_buffer(b, (128, 128, 128))
+    for i, j in tir.grid(128, 128):
+        for k in tir.serial(0, 128):
+            with tir.block([128, 128, 128], "C") as [vi, vj, vk]:
+                tir.bind(vi, i)
+                tir.bind(vj, j)
+                tir.bind(vk, k)
+                C[vi, vj, vk] = A[vi, vj, vk] * 2.0
+        for k in tir.serial(0, 128):
+            with tir.block([128, 128, 128], "B") as [vi, vj, vk]:
+                tir.bind(vi, i)
+                tir.bind(vj, j)
+                tir.bind(vk, k)
+                B[vi, vj, vk] = C[vi, vj, vk] * 2.0
+
+
+@tvm.script.tir
+def elementwise_with_loops_not_same_scope(a: ty.handle, b: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128, 128))
+    B = tir.match_buffer(b, (128, 128, 128))
+    for i, j in tir.grid(128, 128):
+        with tir.block([128, 128], "A") as [vi, vj]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            for k in tir.serial(0, 128):
+                with tir.block([128], "B") as [vk]:
+                    tir.bind(vk, k)
+                    tir.reads([A[vi, vj, vk]])
+                    tir.writes([B[vi, vj, vk]])
+                    B[vi, vj, vk] = A[vi, vj, vk] * 2.0
+
+
+@tvm.script.tir
+def elementwise_with_wrong_block_var_type(a: ty.handle, b: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128, 128))
+    B = tir.match_buffer(b, (128, 128, 128))
+    for i, j, k in tir.grid(128, 128, 128):
+        with tir.block([128, 128, tir.scan_axis(0, 128)], "B") as [vi, vj, vk]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            tir.bind(vk, k)
+            tir.reads([A[vi, vj, vk]])
+            tir.writes([B[vi, vj, vk]])
+            B[vi, vj, vk] = A[vi, vj, vk] * 2.0
+
+
+@tvm.script.tir
+def elementwise_reordered(a: ty.handle, b: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128, 128, 128))
+    B = tir.match_buffer(b, (128, 128, 128, 128))
+    for l, j, k, i in tir.grid(128, 128, 128, 128):
+        with tir.block([128, 128, 128, 128], "B") as [vi, vj, vk, vl]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            tir.bind(vk, k)
+            tir.bind(vl, l)
+            B[vi, vj, vk, vl] = A[vi, vj, vk, vl] * 2.0
+
+
+@tvm.script.tir
+def elementwise_reordered2(a: ty.handle, b: ty.handle) -> None:
+    A = tir.match_buffer(a, (128, 128, 128, 128))
+    B = tir.match_buffer(b, (128, 128, 128, 128))
+    for k, j, i, l in tir.grid(128, 128, 128, 128):
+        with tir.block([128, 128, 128, 128], "B") as [vi, vj, vk, vl]:
+            tir.bind(vi, i)
+            tir.bind(vj, j)
+            tir.bind(vk, k)
+            tir.bind(vl, l)
+            B[vi, vj, vk, vl] = A[vi, vj, vk, vl] * 2.0
+
+
+# pylint: enable=no-member,invalid-name,unused-variable
+
+
+def test_reorder():
+    sch = tir.Schedule(elementwise, debug_mode=True)
+    block_b = sch.get_block("B")
+    i, j, k, l = sch.get_loops(block_b)
+    sch.reorder(l, i)
+    tvm.ir.assert_structural_equal(elementwise_reordered, sch.mod["main"])
+
+
+def test_reorder2():
+    sch = tir.Schedule(elementwise, debug_mode=True)
+    block_b = sch.get_block("B")
+    i, j, k, l = sch.get_loops(block_b)
+    sch.reorder(k, i, l)
+    tvm.ir.assert_structural_equal(elementwise_reordered2, sch.mod["main"])
+
+
+def test_reorder_fail_with_multi_appearance_loops():
+    sch = tir.Schedule(elementwise, debug_mode=True)
+    block_b = sch.get_block("B")
+    i, j, k, l = sch.get_loops(block_b)
+    with pytest.raises(tvm.tir.ScheduleError):
+        sch.reorder(k, i, i)
+
+
+def test_reorder_fail_with_non_single_branch_loop():
+    sch = tir.Schedule(elementwise_non_single_branch, debug_mode=True)
+    block_b = sch.get_block("B")
+    i, j, k = sch.get_loops(block_b)
+    with pytest.raises(tvm.tir.ScheduleError):
+        sch.reorder(k, i)
+
+
+def test_reorder_fail_with_loops_not_under_same_scope():
+    sch = tir.Schedule(elementwise_with_loops_not_same_scope, debug_mode=True)
+    block_b = sch.get_block("B")
+    block_a = sch.get_block("A")
+    i, j = sch.get_loops(block_a)
+    k = sch.get_loops(block_b)[0]
+    with pytest.raises(tvm.tir.ScheduleError):
+        sch.reorder(k, i)
+
+
+def test_reorder_fail_with_wrong_block_var_type():
+    sch = tir.Schedule(elementwise_with_wrong_block_var_type, debug_mode=True)
+    block_b = sch.get_block("B")
+    i, j, k = sch.get_loops(block_b)
+    with pytest.raises(tvm.tir.ScheduleError):
+        sch.reorder(k, i)
+
+
+def test_reorder_fail_with_dependent_loops():
+    sch = tir.Schedule(elementwise_dependent_loop, debug_mode=True)
+    block_b = sch.get_block("B")
+    i, j, k, l = sch.get_loops(block_b)
+    with pytest.raises(tvm.tir.ScheduleError):
+        sch.reorder(l, i)
+
+
+def test_reorder_fail_not_affine_bindings():
+    sch = tir.Schedule(elementwise_not_affine, debug_mode=True)
+    block_b = sch.get_block("B")
+    i, j, k, l = sch.get_loops(block_b)
+    with pytest.raises(tvm.tir.ScheduleError):
+        sch.reorder(l, i)
+
+
+if __name__ == "__main__":
+    test_reorder()
+    test_reorder2()
+    test_reorder_fail_with_multi_appearance_loops()
+    test_reorder_fail_with_non_single_branch_loop()
+    test_reorder_fail_with_loops_not_under_same_scope()
+    test_reorder_fail_with_wrong_block_var_type()
+    test_reorder_fail_with_dependent_loops()
+    test_reorder_fail_not_affine_bindings()
@@ -0,0 +1,142 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import tvm
+from tvm import tir
+from tvm.script import ty
+
+# pylint: disable=no-member,invalid-name,unused-variable
+
+
+@tvm.script.tir
+def transpose(a: ty.handle, b: ty.handle) -> None:
+    A = tir.match_buffer(a, (1024, 1024))
+    B = tir.match_buffer(b, (1024, 1024))
+    for i, j in tir.grid(1024, 1024):
+        B[i, j] = A[j, i]
+
+
+@tvm.script.tir
+def matmul(a: ty.handle, b: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (512, 512))
+    B = tir.match_buffer(b, (512, 512))
+    C = tir.match_buffer(c, (512, 512))
+    for i, j, k in tir.grid(512, 512, 512):
+        C[i, j] = C[i, j] + A[i, k] * B[k, j]
+
+
+@tvm.script.tir
+def non_commutative_update(a: ty.handle, c: ty.handle) -> None:
+    A = tir.match_buffer(a, (512, 512))
+    C = tir.match_buffer(c, (512,))
+    for i, k in tir.grid(512, 512):
+        C[i] = C[i] * 2.0 + A[i, k]
+
+
+@tvm.script.tir
+def prime_transpose(a: ty.handle, b: ty.handle) -> None:
+    A = tir.match_buffer(a, (1021, 1021))
+    B = tir.match_buffer(b, (1021, 1021))
+    for i, j in tir.grid(1021, 1021):
+        B[i, j] = A[j, i]
+
+
+@tvm.script.tir
+def small_transpose(a: ty.handle, b: ty.handle) -> None:
+    A = tir.match_buffer(a, (16, 16))
+    B = tir.match_buffer(b, (16, 16))
+    for i, j in tir.grid(16, 16):
+        B[i, j] = A[j, i]
+
+
+# pylint: enable=no-member,invalid-name,unused-variable
+
+
+def _tile(func, **kwargs):
+    config = {"enable": True}
+    config.update(kwargs)
+    mod = tvm.IRModule({"main": func})
+    with tvm.transform.PassContext(config={"tir.AutoCacheTiling": config}):
+        return tvm.tir.transform.AutoCacheTiling()(mod)["main"]
+
+
+def _loops(func):
+    loops = []
+    stmt = func.body
+    while isinstance(stmt, tir.For):
+        loops.append((stmt.loop_var.name, stmt.extent.value))
+        stmt = stmt.body
+    return loops
+
+
+def test_disabled_by_default():
+    mod = tvm.IRModule({"main": transpose})
+    tvm.ir.assert_structural_equal(tvm.tir.transform.AutoCacheTiling()(mod)["main"], transpose)
+
+
+def test_tile_transpose():
+    func = _tile(transpose)
+    assert _loops(func) == [("i.outer", 32), ("j.outer", 32), ("i.inner", 32), ("j.inner", 32)]
+
+
+def test_tile_matmul():
+    func = _tile(matmul)
+    # The loop with contiguous accesses to B and C is moved innermost
+    assert _loops(func) == [
+        ("i.outer", 16),
+        ("j.outer", 16),
+        ("k.outer", 16),
+        ("i.inner", 32),
+        ("k.inner", 32),
+        ("j.inner", 32),
+    ]
+
+
+def test_tile_prime_extent():
+    func = _tile(prime_transpose)
+    # 1021 has no divisor but 1, so the loops are tiled by 32 and the last tiles are guarded
+    assert _loops(func) == [("i.outer", 32), ("j.outer", 32), ("i.inner", 32), ("j.inner", 32)]
+    stmt = func.body
+    while isinstance(stmt, tir.For):
+        stmt = stmt.body
+    assert isinstance(stmt, tir.IfThenElse)
+    assert isinstance(stmt.then_case, tir.BufferStore)
+
+
+def test_cache_size_from_target():
+    with tvm.target.Target("llvm -l1-cache-size=131072"):
+        func = _tile(transpose)
+    assert _loops(func) == [("i.outer", 16), ("j.outer", 16), ("i.inner", 64), ("j.inner", 64)]
+    func = _tile(transpose, cache_size=131072)
+    assert _loops(func) == [("i.outer", 16), ("j.outer", 16), ("i.inner", 64), ("j.inner", 64)]
+
+
+def test_skip_non_commutative_update():
+    tvm.ir.assert_structural_equal(_tile(non_commutative_update), non_commutative_update)
+
+
+def test_skip_nest_fitting_in_cache():
+    tvm.ir.assert_structural_equal(_tile(small_transpose), small_transpose)
+
+
+if __name__ == "__main__":
+    test_disabled_by_default()
+    test_tile_transpose()
+    test_tile_matmul()
+    test_tile_prime_extent()
+    test_cache_size_from_target()
+    test_skip_non_commutative_update()
+    test_skip_nest_fitting_in_cache()
@@ -0,0 +1,119 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import tvm
+from tvm import te
+
+
+def _count_prefetch(stmt):
+    count = [0]
+
+    def _visit(op):
+        if isinstance(op, tvm.tir.Call) and op.op.same_as(tvm.ir.Op.get("tir.prefetch")):
+            count[0] += 1
+
+    tvm.tir.stmt_functor.post_order_visit(stmt, _visit)
+    return count[0]
+
+
+def _auto_prefetch(mod, **kwargs):
+    config = {"enable": True}
+    config.update(kwargs)
+    with tvm.transform.PassContext(config={"tir.AutoPrefetch": config}):
+        return tvm.tir.transform.AutoPrefetch()(mod)
+
+
+def _make_mod(body_fn, n=128):
+    ib = tvm.tir.ir_builder.create()
+    A = ib.pointer("float32", name="A")
+    C = ib.pointer("float32", name="C")
+    idx = ib.pointer("int32", name="idx")
+    body_fn(ib, A, C, idx, n)
+    func = tvm.tir.PrimFunc([A.asobject(), C.asobject(), idx.asobject()], ib.get())
+    return tvm.IRModule({"main": func})
+
+
+def test_strided_access():
+    def body(ib, A, C, idx, n):
+        with ib.for_range(0, n, name="i") as i:
+            with ib.for_range(0, n, name="j") as j:
+                C[i * n + j] = A[j * n + i]
+
+    mod = _make_mod(body)
+    # Disabled by default
+    assert _count_prefetch(tvm.tir.transform.AutoPrefetch()(mod)["main"].body) == 0
+
+    stmt = _auto_prefetch(mod, distance=4)["main"].body
+    assert _count_prefetch(stmt) == 1
+    inner = stmt.body
+    assert isinstance(inner, tvm.tir.For)
+    assert isinstance(inner.body, tvm.tir.SeqStmt)
+    prefetch = inner.body[0].value
+    assert prefetch.op.same_as(tvm.ir.Op.get("tir.prefetch"))
+    load = prefetch.args[0].args[0]
+    assert load.buffer_var.same_as(A.asobject())
+    j = inner.loop_var
+    expected = tvm.te.min(j + 4, 127) * 128 + stmt.loop_var
+    assert tvm.arith.Analyzer().can_prove_equal(load.index, expected)
+
+
+def test_contiguous_access_is_skipped():
+    def body(ib, A, C, idx, n):
+        with ib.for_range(0, n, name="i") as i:
+            with ib.for_range(0, n, name="j") as j:
+                C[i * n + j] = A[i * n + j] * 2.0
+
+    mod = _make_mod(body)
+    assert _count_prefetch(_auto_prefetch(mod)["main"].body) == 0
+    # A small enough threshold makes every access a candidate
+    assert _count_prefetch(_auto_prefetch(mod, min_stride_bytes=4)["main"].body) == 1
+
+
+def test_indirect_access():
+    def body(ib, A, C, idx, n):
+        with ib.for_range(0, n, name="i") as i:
+            C[i] = A[idx[i] * 64]
+
+    stmt = _auto_prefetch(_make_mod(body))["main"].body
+    assert _count_prefetch(stmt) == 1
+    load = stmt.body[0].value.args[0].args[0]
+    assert load.buffer_var.name == "A"
+
+
+def test_guarded_indirect_access_is_skipped():
+    def body(ib, A, C, idx, n):
+        with ib.for_range(0, n, name="i") as i:
+            with ib.if_scope(idx[i] >= 0):
+                C[i] = A[idx[i] * 64]
+
+    stmt = _auto_prefetch(_make_mod(body))["main"].body
+    assert _count_prefetch(stmt) == 0
+
+
+def test_short_loop_is_skipped():
+    def body(ib, A, C, idx, n):
+        with ib.for_range(0, 4, name="i") as i:
+            C[i] = A[i * 128]
+
+    assert _count_prefetch(_auto_prefetch(_make_mod(body), distance=8)["main"].body) == 0
+
+
+if __name__ == "__main__":
+    test_strided_access()
+    test_contiguous_access_is_skipped()
+    test_indirect_access()
+    test_guarded_indirect_access_is_skipped()
+    test_short_loop_is_skipped()
@@ -15,6 +15,7 @@
 # specific language governing permissions and limitations
 # under the License.
 import tvm
+import tvm.testing
 from tvm import te
 import numpy
 
@@ -46,5 +47,70 @@ def test_makeapi():
     assert len(f.params) == 8
 
 
+def _count_asserts(stmt):
+    count = [0]
+
+    def _visit(op):
+        if isinstance(op, tvm.tir.AssertStmt):
+            count[0] += 1
+
+    tvm.tir.stmt_functor.post_order_visit(stmt, _visit)
+    return count[0]
+
+
+def test_trusted_entry():
+    n = te.size_var("n")
+    A = te.placeholder((n,), name="A")
+    B = te.placeholder((n,), name="B")
+    C = te.compute(A.shape, lambda *i: A(*i) + B(*i), name="C")
+    s = te.create_schedule(C.op)
+    mod = tvm.lower(s, [A, B, C])
+    mod = tvm.tir.transform.Apply(
+        lambda f: f.with_attr(
+            {
+                "target": tvm.target.Target("llvm"),
+                "global_symbol": "main",
+                "tir.is_entry_func": True,
+            }
+        )
+    )(mod)
+
+    # Disabled by default
+    assert len(tvm.tir.transform.MakePackedAPI()(mod).functions) == 1
+
+    with tvm.transform.PassContext(config={"tir.emit_trusted_entry": True}):
+        mod = tvm.tir.transform.MakePackedAPI()(mod)
+    f = mod["main"]
+    f_trusted = mod["main__trusted"]
+    assert f_trusted.attrs["global_symbol"] == "main__trusted"
+    assert not f_trusted.attrs["tir.is_entry_func"]
+    assert len(f_trusted.params) == len(f.params)
+    assert _count_asserts(f.body) > 0
+    assert _count_asserts(f_trusted.body) == 0
+
+
+@tvm.testing.requires_llvm
+def test_trusted_entry_build():
+    n = te.size_var("n")
+    A = te.placeholder((n,), name="A")
+    B = te.placeholder((n,), name="B")
+    C = te.compute(A.shape, lambda *i: A(*i) + B(*i), name="C")
+    s = te.create_schedule(C.op)
+    with tvm.transform.PassContext(config={"tir.emit_trusted_entry": True}):
+        m = tvm.build(s, [A, B, C], "llvm", name="vadd")
+    dev = tvm.cpu(0)
+    a = tvm.nd.array(numpy.random.uniform(size=16).astype(A.dtype), dev)
+    b = tvm.nd.array(numpy.random.uniform(size=16).astype(B.dtype), dev)
+    c = tvm.nd.empty((16,), C.dtype, dev)
+    m.get_function("vadd__trusted")(a, b, c)
+    tvm.testing.assert_allclose(c.numpy(), a.numpy() + b.numpy())
+    # The checked entry is kept as the entry of the module
+    c = tvm.nd.empty((16,), C.dtype, dev)
+    m(a, b, c)
+    tvm.testing.assert_allclose(c.numpy(), a.numpy() + b.numpy())
+
+
 if __name__ == "__main__":
     test_makeapi()
+    test_trusted_entry()
+    test_trusted_entry_build()
@@ -0,0 +1,94 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import numpy as np
+import tvm
+import tvm.testing
+from tvm import te
+
+
+def _make_mod():
+    n = te.var("n")
+    A = te.placeholder((n, 16), name="A")
+    B = te.compute((n, 16), lambda i, j: A[i, j] * 2, name="B")
+    s = te.create_schedule(B.op)
+    return tvm.lower(s, [A, B]), (A, B, s)
+
+
+def _specialize(mod, shapes):
+    with tvm.transform.PassContext(config={"tir.SpecializeShapes": {"shapes": shapes}}):
+        return tvm.tir.transform.SpecializeShapes()(mod)
+
+
+def _collect(stmt, node_type):
+    nodes = []
+
+    def _visit(op):
+        if isinstance(op, node_type):
+            nodes.append(op)
+
+    tvm.tir.stmt_functor.post_order_visit(stmt, _visit)
+    return nodes
+
+
+def test_specialize_shapes():
+    mod, _ = _make_mod()
+    # Nothing to do without shapes
+    assert tvm.tir.transform.SpecializeShapes()(mod)["main"].same_as(mod["main"])
+
+    body = _specialize(mod, [{"n": 128}, {"n": 1024}])["main"].body
+    assert isinstance(body, tvm.tir.IfThenElse)
+    assert isinstance(body.condition, tvm.tir.EQ)
+    assert body.condition.b.value == 128
+    assert isinstance(body.else_case, tvm.tir.IfThenElse)
+    assert body.else_case.condition.b.value == 1024
+    # The specialized variant has constant loop extents
+    outer = _collect(body.then_case, tvm.tir.For)[-1]
+    assert outer.extent.value == 128
+    # The generic variant is kept
+    generic = _collect(body.else_case.else_case, tvm.tir.For)[-1]
+    assert isinstance(generic.extent, tvm.tir.Var)
+    # The variants do not share the loop vars
+    loop_vars = [loop.loop_var for loop in _collect(body, tvm.tir.For)]
+    assert len(set(v.__hash__() for v in loop_vars)) == len(loop_vars)
+
+
+def test_specialize_shapes_skip():
+    mod, _ = _make_mod()
+    # The shapes which do not name a shape var of the function are ignored
+    assert _specialize(mod, [{"m": 4}])["main"].same_as(mod["main"])
+    # The duplicated shapes are specialized once
+    body = _specialize(mod, [{"n": 8}, {"n": 8, "m": 4}])["main"].body
+    assert len(_collect(body, tvm.tir.IfThenElse)) == 1
+
+
+@tvm.testing.requires_llvm
+def test_specialize_shapes_build():
+    _, (A, B, s) = _make_mod()
+    with tvm.transform.PassContext(config={"tir.SpecializeShapes": {"shapes": [{"n": 128}]}}):
+        f = tvm.build(s, [A, B], target="llvm")
+    dev = tvm.cpu(0)
+    for n in [128, 100]:
+        a = tvm.nd.array(np.random.uniform(size=(n, 16)).astype("float32"), dev)
+        b = tvm.nd.empty((n, 16), "float32", dev)
+        f(a, b)
+        tvm.testing.assert_allclose(b.numpy(), a.numpy() * 2, rtol=1e-5)
+
+
+if __name__ == "__main__":
+    test_specialize_shapes()
+    test_specialize_shapes_skip()
+    test_specialize_shapes_build()
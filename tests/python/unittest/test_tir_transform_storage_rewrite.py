@@ -319,7 +319,9 @@ def test_parallel_alloc():
     mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([n], body))
     body = tvm.tir.transform.StorageRewrite()(mod)["main"].body
 
+    assert body.attr_key == "pragma_parallel_launch_point"
     assert isinstance(body.body.body, tvm.tir.Allocate)
+    assert isinstance(body.body.body.body, tvm.tir.For)
 
     ib = tvm.tir.ir_builder.create()
     n = te.var("n")
@@ -339,6 +341,63 @@ def test_parallel_alloc():
     assert isinstance(body.body.body.body.body, tvm.tir.Allocate)
 
 
+def test_parallel_alloc_loop_dependent():
+    ib = tvm.tir.ir_builder.create()
+    n = te.var("n")
+    with ib.for_range(0, n, name="i", kind="parallel") as i:
+        A = ib.allocate("float32", i + 1, name="A", scope="global")
+        with ib.for_range(0, i + 1, name="j") as j:
+            A[j] = A[j] + 2
+
+    body = ib.get()
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([n], body))
+    body = tvm.tir.transform.StorageRewrite()(mod)["main"].body
+
+    # The extent depends on the loop var, keep the allocation in the loop
+    assert isinstance(body, tvm.tir.For)
+    assert isinstance(body.body.body, tvm.tir.Allocate)
+
+
+def test_parallel_alloc_merge_siblings():
+    ib = tvm.tir.ir_builder.create()
+    n = te.var("n")
+    with ib.for_range(0, n, name="i", kind="parallel") as i:
+        A = ib.allocate("float32", 200, name="A", scope="global")
+        with ib.for_range(0, 200, name="j") as j:
+            A[j] = A[j] + 2
+    with ib.for_range(0, n, name="k", kind="parallel") as k:
+        B = ib.allocate("float32", 200, name="B", scope="global")
+        with ib.for_range(0, 200, name="j") as j:
+            B[j] = B[j] + 3
+
+    body = ib.get()
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([n], body))
+    body = tvm.tir.transform.StorageRewrite()(mod)["main"].body
+
+    # // attr [i] pragma_parallel_launch_point = 1
+    # // attr [A] storage_scope = "global"
+    # allocate A[float32 * 200]
+    # // attr [i] pragma_parallel_barrier_when_finish = 1
+    # parallel (i, 0, n) { ... A ... }
+    # parallel (k, 0, n) { ... A ... }
+    assert body.attr_key == "pragma_parallel_launch_point"
+    assert isinstance(body.body.body, tvm.tir.Allocate)
+    seq = body.body.body.body
+    assert isinstance(seq, tvm.tir.SeqStmt) and len(seq) == 2
+    assert seq[0].attr_key == "pragma_parallel_barrier_when_finish"
+    assert seq[0].body.kind == tvm.tir.ForKind.PARALLEL
+    assert seq[1].kind == tvm.tir.ForKind.PARALLEL
+
+    num_alloc = [0]
+
+    def verify(n):
+        if isinstance(n, tvm.tir.Allocate):
+            num_alloc[0] += 1
+
+    tvm.tir.stmt_functor.post_order_visit(body, verify)
+    assert num_alloc[0] == 1
+
+
 def test_while_alloc():
     def get_mod(kind="serial"):
         ib = tvm.tir.ir_builder.create()
@@ -367,11 +426,12 @@ def test_while_alloc():
     #   }
     # }
     body = tvm.tir.transform.StorageRewrite()(mod)["main"].body
+    # // attr [i] pragma_parallel_launch_point = 1
+    # // attr [j] storage_scope = "global"
+    # allocate j[int32 * 1]
+    # // attr [A] storage_scope = "global"
+    # allocate A[float32 * n]
     # parallel (i, 0, n) {
-    #   // attr [j] storage_scope = "global"
-    #   allocate j[int32 * 1]
-    #   // attr [A] storage_scope = "global"
-    #   allocate A[float32 * n]
     #   j[0] = 0
     #   while((j[0] < 10)){
     #     A[j[0]] = (A[j[0]] + 2f)
@@ -687,6 +747,8 @@ if __name__ == "__main__":
     test_alloc_different_dtypes()
     test_inplace_rule()
     test_parallel_alloc()
+    test_parallel_alloc_loop_dependent()
+    test_parallel_alloc_merge_siblings()
     test_while_alloc()
     test_storage_combine()
     test_storage_combine_with_vectorization()
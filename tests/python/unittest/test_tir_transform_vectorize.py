@@ -158,6 +158,47 @@ def test_vectorize_if_then_else():
     assert isinstance(stmt.body.value.args[2], tvm.tir.Broadcast)
 
 
+def test_vectorize_with_if_predication():
+    n = te.var("n")
+    ib = tvm.tir.ir_builder.create()
+    A = ib.pointer("float32", name="A")
+    B = ib.pointer("float32", name="B")
+    with ib.for_range(0, 8, kind="vectorize") as i:
+        with ib.if_scope(tvm.tir.likely(i < n)):
+            B[i] = A[i] + 1.0
+    stmt = ib.get()
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([A, B, n], stmt))
+
+    # scalarized by default
+    stmt = tvm.tir.transform.VectorizeLoop()(mod)["main"].body
+    assert isinstance(stmt, tvm.tir.For)
+
+    with tvm.transform.PassContext(config={"tir.enable_vectorize_predication": True}):
+        stmt = tvm.tir.transform.VectorizeLoop()(mod)["main"].body
+    assert isinstance(stmt, tvm.tir.Store)
+    assert isinstance(stmt.index, tvm.tir.Ramp)
+    assert isinstance(stmt.predicate, tvm.tir.LT)
+    load = stmt.value.a
+    assert isinstance(load, tvm.tir.Load)
+    tvm.ir.assert_structural_equal(load.predicate, stmt.predicate)
+
+
+def test_vectorize_with_if_predication_fallback():
+    n = te.var("n")
+    ib = tvm.tir.ir_builder.create()
+    A = ib.pointer("int32", name="A")
+    B = ib.pointer("int32", name="B")
+    with ib.for_range(0, 8, kind="vectorize") as i:
+        with ib.if_scope(i < n):
+            # the inactive lanes may divide by zero
+            B[i] = tvm.tir.floordiv(A[i], B[i])
+    stmt = ib.get()
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([A, B, n], stmt))
+    with tvm.transform.PassContext(config={"tir.enable_vectorize_predication": True}):
+        stmt = tvm.tir.transform.VectorizeLoop()(mod)["main"].body
+    assert isinstance(stmt, tvm.tir.For)
+
+
 def test_vectorize_while_fail():
     """A while loop inside a vectorized loop should fail."""
 
@@ -213,4 +254,6 @@ if __name__ == "__main__":
     test_vectorize_with_le_cond()
     test_vectorize_with_ge_cond()
     test_vectorize_let()
+    test_vectorize_with_if_predication()
+    test_vectorize_with_if_predication_fallback()
     test_vectorize_while_fail()